@@ -9,9 +9,10 @@
 #include "Kismet/GameplayStatics.h"
 #include "DlgDialogueParticipant.h"
 #include "DlgHelper.h"
+#include "DlgParticipantValueCache.h"
 #include "Logging/DlgLogger.h"
 
-bool FDlgCondition::EvaluateArray(const UDlgContext& Context, const TArray<FDlgCondition>& ConditionsArray, FName DefaultParticipantName)
+bool FDlgCondition::EvaluateArray(const UDlgContext& Context, TArrayView<const FDlgCondition> ConditionsArray, FName DefaultParticipantName)
 {
 	bool bHasAnyWeak = false;
 	bool bHasSuccessfulWeak = false;
@@ -36,6 +37,12 @@ bool FDlgCondition::EvaluateArray(const UDlgContext& Context, const TArray<FDlgC
 }
 
 bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Participant) const
+{
+	const UObject* OtherParticipant = IsSecondParticipantInvolved() ? Context.GetParticipant(OtherParticipantName) : nullptr;
+	return IsConditionMet(Context, Participant, OtherParticipant);
+}
+
+bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Participant, const UObject* OtherParticipant) const
 {
 	bool bHasParticipant = true;
 	if (IsParticipantInvolved())
@@ -48,10 +55,13 @@ bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Pa
 	{
 		if (CustomCondition == nullptr)
 		{
-			FDlgLogger::Get().Errorf(
-				TEXT("Custom Condition is empty (not valid). IsConditionMet returning false.\nContext:\n\t%s, Participant = %s"),
-				*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
-			);
+			FDlgLogger::Get().ErrorLazy([&]()
+			{
+				return FString::Printf(
+					TEXT("Custom Condition is empty (not valid). IsConditionMet returning false.\nContext:\n\t%s, Participant = %s"),
+					*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
+				);
+			});
 			return false;
 		}
 
@@ -69,29 +79,29 @@ bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Pa
 			return IDlgDialogueParticipant::Execute_CheckCondition(Participant, &Context, CallbackName) == bBoolValue;
 
 		case EDlgConditionType::BoolCall:
-			return CheckBool(Context, IDlgDialogueParticipant::Execute_GetBoolValue(Participant, CallbackName));
+			return CheckBool(Context, FDlgParticipantValueCache::GetBoolValue(Context.GetParticipantValueCache(), Participant, CallbackName), OtherParticipant);
 
 		case EDlgConditionType::FloatCall:
-			return CheckFloat(Context, static_cast<double>(IDlgDialogueParticipant::Execute_GetFloatValue(Participant, CallbackName)));
+			return CheckFloat(Context, static_cast<double>(FDlgParticipantValueCache::GetFloatValue(Context.GetParticipantValueCache(), Participant, CallbackName)), OtherParticipant);
 
 		case EDlgConditionType::IntCall:
-			return CheckInt(Context, IDlgDialogueParticipant::Execute_GetIntValue(Participant, CallbackName));
+			return CheckInt(Context, FDlgParticipantValueCache::GetIntValue(Context.GetParticipantValueCache(), Participant, CallbackName), OtherParticipant);
 
 		case EDlgConditionType::NameCall:
-			return CheckName(Context, IDlgDialogueParticipant::Execute_GetNameValue(Participant, CallbackName));
+			return CheckName(Context, FDlgParticipantValueCache::GetNameValue(Context.GetParticipantValueCache(), Participant, CallbackName), OtherParticipant);
 
 
 		case EDlgConditionType::ClassBoolVariable:
-			return CheckBool(Context, FNYReflectionHelper::GetVariable<FBoolProperty, bool>(Participant, CallbackName));
+			return CheckBool(Context, FDlgParticipantValueCache::GetClassBoolVariable(Context.GetParticipantValueCache(), Participant, CallbackName), OtherParticipant);
 
 		case EDlgConditionType::ClassFloatVariable:
-			return CheckFloat(Context, FNYReflectionHelper::GetVariable<FDoubleProperty, double>(Participant, CallbackName));
+			return CheckFloat(Context, FDlgParticipantValueCache::GetClassFloatVariable(Context.GetParticipantValueCache(), Participant, CallbackName), OtherParticipant);
 
 		case EDlgConditionType::ClassIntVariable:
-			return CheckInt(Context, FNYReflectionHelper::GetVariable<FIntProperty, int32>(Participant, CallbackName));
+			return CheckInt(Context, FDlgParticipantValueCache::GetClassIntVariable(Context.GetParticipantValueCache(), Participant, CallbackName), OtherParticipant);
 
 		case EDlgConditionType::ClassNameVariable:
-			return CheckName(Context, FNYReflectionHelper::GetVariable<FNameProperty, FName>(Participant, CallbackName));
+			return CheckName(Context, FDlgParticipantValueCache::GetClassNameVariable(Context.GetParticipantValueCache(), Participant, CallbackName), OtherParticipant);
 
 
 		case EDlgConditionType::WasNodeVisited:
@@ -101,7 +111,7 @@ bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Pa
 			{
 				// Use the GUID if it is valid as it is more reliable
 				const UDlgNode* Node = GUID.IsValid() ? Context.GetNodeFromGUID(GUID) : Context.GetNodeFromIndex(IntValue);
-				return Node != nullptr ? Node->HasAnySatisfiedChild(Context, {}) == bBoolValue : false;
+				return Node != nullptr ? Node->HasAnySatisfiedChild(Context) == bBoolValue : false;
 			}
 
 		default:
@@ -110,12 +120,11 @@ bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Pa
 	}
 }
 
-bool FDlgCondition::CheckFloat(const UDlgContext& Context, double Value) const
+bool FDlgCondition::CheckFloat(const UDlgContext& Context, double Value, const UObject* OtherParticipant) const
 {
 	double ValueToCheckAgainst = FloatValue;
 	if (CompareType == EDlgCompare::ToVariable || CompareType == EDlgCompare::ToClassVariable)
 	{
-		const UObject* OtherParticipant = Context.GetParticipant(OtherParticipantName);
 		if (!ValidateIsParticipantValid(Context, TEXT("CheckFloat"), OtherParticipant))
 		{
 			return false;
@@ -123,11 +132,11 @@ bool FDlgCondition::CheckFloat(const UDlgContext& Context, double Value) const
 
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			ValueToCheckAgainst = static_cast<double>(IDlgDialogueParticipant::Execute_GetFloatValue(OtherParticipant, OtherVariableName));
+			ValueToCheckAgainst = static_cast<double>(FDlgParticipantValueCache::GetFloatValue(Context.GetParticipantValueCache(), OtherParticipant, OtherVariableName));
 		}
 		else
 		{
-			ValueToCheckAgainst = FNYReflectionHelper::GetVariable<FDoubleProperty, double>(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = FDlgParticipantValueCache::GetClassFloatVariable(Context.GetParticipantValueCache(), OtherParticipant, OtherVariableName);
 		}
 	}
 
@@ -152,20 +161,22 @@ bool FDlgCondition::CheckFloat(const UDlgContext& Context, double Value) const
 			return !FMath::IsNearlyEqual(Value, ValueToCheckAgainst);
 
 		default:
-			FDlgLogger::Get().Errorf(
-				TEXT("Invalid Operation in float based condition.\nContext:\n\t%s"),
-				*Context.GetContextString()
-			);
+			FDlgLogger::Get().ErrorLazy([&]()
+			{
+				return FString::Printf(
+					TEXT("Invalid Operation in float based condition.\nContext:\n\t%s"),
+					*Context.GetContextString()
+				);
+			});
 			return false;
 	}
 }
 
-bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value) const
+bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value, const UObject* OtherParticipant) const
 {
 	int32 ValueToCheckAgainst = IntValue;
 	if (CompareType == EDlgCompare::ToVariable || CompareType == EDlgCompare::ToClassVariable)
 	{
-		const UObject* OtherParticipant = Context.GetParticipant(OtherParticipantName);
 		if (!ValidateIsParticipantValid(Context, TEXT("CheckInt"), OtherParticipant))
 		{
 			return false;
@@ -173,11 +184,11 @@ bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value) const
 
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			ValueToCheckAgainst = IDlgDialogueParticipant::Execute_GetIntValue(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = FDlgParticipantValueCache::GetIntValue(Context.GetParticipantValueCache(), OtherParticipant, OtherVariableName);
 		}
 		else
 		{
-			ValueToCheckAgainst = FNYReflectionHelper::GetVariable<FIntProperty, int32>(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = FDlgParticipantValueCache::GetClassIntVariable(Context.GetParticipantValueCache(), OtherParticipant, OtherVariableName);
 		}
 	}
 
@@ -202,20 +213,22 @@ bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value) const
 			return Value != ValueToCheckAgainst;
 
 		default:
-			FDlgLogger::Get().Errorf(
-				TEXT("Invalid Operation in int based condition.\nContext:\n\t%s"),
-				*Context.GetContextString()
-			);
+			FDlgLogger::Get().ErrorLazy([&]()
+			{
+				return FString::Printf(
+					TEXT("Invalid Operation in int based condition.\nContext:\n\t%s"),
+					*Context.GetContextString()
+				);
+			});
 			return false;
 	}
 }
 
-bool FDlgCondition::CheckBool(const UDlgContext& Context, bool bValue) const
+bool FDlgCondition::CheckBool(const UDlgContext& Context, bool bValue, const UObject* OtherParticipant) const
 {
 	bool bResult = bValue;
 	if (CompareType == EDlgCompare::ToVariable || CompareType == EDlgCompare::ToClassVariable)
 	{
-		const UObject* OtherParticipant = Context.GetParticipant(OtherParticipantName);
 		if (!ValidateIsParticipantValid(Context, TEXT("CheckBool"), OtherParticipant))
 		{
 			return false;
@@ -224,11 +237,11 @@ bool FDlgCondition::CheckBool(const UDlgContext& Context, bool bValue) const
 		bool bValueToCheckAgainst;
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			bValueToCheckAgainst = IDlgDialogueParticipant::Execute_GetBoolValue(OtherParticipant, OtherVariableName);
+			bValueToCheckAgainst = FDlgParticipantValueCache::GetBoolValue(Context.GetParticipantValueCache(), OtherParticipant, OtherVariableName);
 		}
 		else
 		{
-			bValueToCheckAgainst = FNYReflectionHelper::GetVariable<FBoolProperty, bool>(OtherParticipant, OtherVariableName);
+			bValueToCheckAgainst = FDlgParticipantValueCache::GetClassBoolVariable(Context.GetParticipantValueCache(), OtherParticipant, OtherVariableName);
 		}
 
 		// Check if value matches other variable
@@ -238,12 +251,11 @@ bool FDlgCondition::CheckBool(const UDlgContext& Context, bool bValue) const
 	return bResult == bBoolValue;
 }
 
-bool FDlgCondition::CheckName(const UDlgContext& Context, FName Value) const
+bool FDlgCondition::CheckName(const UDlgContext& Context, FName Value, const UObject* OtherParticipant) const
 {
 	FName ValueToCheckAgainst = NameValue;
 	if (CompareType == EDlgCompare::ToVariable || CompareType == EDlgCompare::ToClassVariable)
 	{
-		const UObject* OtherParticipant = Context.GetParticipant(OtherParticipantName);
 		if (!ValidateIsParticipantValid(Context, TEXT("CheckName"), OtherParticipant))
 		{
 			return false;
@@ -251,11 +263,11 @@ bool FDlgCondition::CheckName(const UDlgContext& Context, FName Value) const
 
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			ValueToCheckAgainst = IDlgDialogueParticipant::Execute_GetNameValue(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = FDlgParticipantValueCache::GetNameValue(Context.GetParticipantValueCache(), OtherParticipant, OtherVariableName);
 		}
 		else
 		{
-			ValueToCheckAgainst = FNYReflectionHelper::GetVariable<FNameProperty, FName>(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = FDlgParticipantValueCache::GetClassNameVariable(Context.GetParticipantValueCache(), OtherParticipant, OtherVariableName);
 		}
 	}
 
@@ -263,17 +275,20 @@ bool FDlgCondition::CheckName(const UDlgContext& Context, FName Value) const
 	return bResult == bBoolValue;
 }
 
-bool FDlgCondition::ValidateIsParticipantValid(const UDlgContext& Context, const FString& ContextString, const UObject* Participant) const
+bool FDlgCondition::ValidateIsParticipantValid(const UDlgContext& Context, const TCHAR* ContextString, const UObject* Participant) const
 {
 	if (IsValid(Participant))
 	{
 		return true;
 	}
 
-	FDlgLogger::Get().Errorf(
-		TEXT("%s FAILED because the PARTICIPANT is INVALID.\nContext:\n\t%s, ConditionType = %s"),
-		*ContextString, *Context.GetContextString(), *ConditionTypeToString(ConditionType)
-	);
+	FDlgLogger::Get().ErrorLazy([&]()
+	{
+		return FString::Printf(
+			TEXT("%s FAILED because the PARTICIPANT is INVALID.\nContext:\n\t%s, ConditionType = %s"),
+			ContextString, *Context.GetContextString(), *ConditionTypeToString(ConditionType)
+		);
+	});
 	return false;
 }
 
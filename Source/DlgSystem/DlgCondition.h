@@ -132,9 +132,12 @@ public:
 	// Own methods
 	//
 
-	static bool EvaluateArray(const UDlgContext& Context, const TArray<FDlgCondition>& ConditionsArray, FName DefaultParticipantName = NAME_None);
+	static bool EvaluateArray(const UDlgContext& Context, TArrayView<const FDlgCondition> ConditionsArray, FName DefaultParticipantName = NAME_None);
 	bool IsConditionMet(const UDlgContext& Context, const UObject* Participant) const;
 
+	// Same as above but the participant the value is compared against is already resolved (only used if IsSecondParticipantInvolved)
+	bool IsConditionMet(const UDlgContext& Context, const UObject* Participant, const UObject* OtherParticipant) const;
+
 	// returns true if ParticipantName has to belong to match with a valid Participant in order for the condition type to work */
 	bool IsParticipantInvolved() const;
 	bool IsSecondParticipantInvolved() const;
@@ -209,13 +212,14 @@ protected:
 	// Helper functions doing the check on the primary value based on EDlgCompare
 	//
 
-	bool CheckFloat(const UDlgContext& Context, double Value) const;
-	bool CheckInt(const UDlgContext& Context, int32 Value) const;
-	bool CheckBool(const UDlgContext& Context, bool bValue) const;
-	bool CheckName(const UDlgContext& Context, FName Value) const;
+	bool CheckFloat(const UDlgContext& Context, double Value, const UObject* OtherParticipant) const;
+	bool CheckInt(const UDlgContext& Context, int32 Value, const UObject* OtherParticipant) const;
+	bool CheckBool(const UDlgContext& Context, bool bValue, const UObject* OtherParticipant) const;
+	bool CheckName(const UDlgContext& Context, FName Value, const UObject* OtherParticipant) const;
 
 	// Checks Participant, prints warning if it is nullptr
-	bool ValidateIsParticipantValid(const UDlgContext& Context, const FString& ContextString, const UObject* Participant) const;
+	// NOTE: ContextString is a raw string so that nothing is allocated on the success path
+	bool ValidateIsParticipantValid(const UDlgContext& Context, const TCHAR* ContextString, const UObject* Participant) const;
 
 public:
 	// Defines the way the condition is interpreted inside the condition array
@@ -4,6 +4,8 @@
 #include "Net/UnrealNetwork.h"
 #include "Engine/Texture2D.h"
 #include "Engine/Blueprint.h"
+#include "Sound/SoundWave.h"
+#include "Misc/ScopeExit.h"
 
 #include "DlgConstants.h"
 #include "Nodes/DlgNode.h"
@@ -11,6 +13,9 @@
 #include "Nodes/DlgNode_SpeechSequence.h"
 #include "DlgDialogueParticipant.h"
 #include "DlgMemory.h"
+#include "DlgVisitedNodes.h"
+#include "DlgContextPool.h"
+#include "DlgParticipantValueCache.h"
 #include "Logging/DlgLogger.h"
 
 
@@ -46,6 +51,7 @@ void UDlgContext::OnRep_SerializedParticipants()
 			Participants.Add(IDlgDialogueParticipant::Execute_GetParticipantName(Participant), Participant);
 		}
 	}
+	OnParticipantsChanged();
 }
 
 bool UDlgContext::ChooseOption(int32 OptionIndex)
@@ -109,7 +115,9 @@ bool UDlgContext::ReevaluateOptions()
 		return false;
 	}
 
-	return Node->ReevaluateChildren(*this, {});
+	const FDlgNodeEvaluationCache::FScope EvaluationScope(NodeEvaluationCache);
+	FDlgVisitedNodes AlreadyEvaluated(Dialogue);
+	return Node->ReevaluateChildren(*this, AlreadyEvaluated);
 }
 
 const FText& UDlgContext::GetOptionText(int32 OptionIndex) const
@@ -218,7 +226,7 @@ const FText& UDlgContext::GetActiveNodeText() const
 		return FText::GetEmpty();
 	}
 
-	return Node->GetNodeText();
+	return Node->GetNodeTextInContext(*this);
 }
 
 FName UDlgContext::GetActiveNodeSpeakerState() const
@@ -230,7 +238,7 @@ FName UDlgContext::GetActiveNodeSpeakerState() const
 		return NAME_None;
 	}
 
-	return Node->GetSpeakerState();
+	return Node->GetSpeakerStateInContext(*this);
 }
 
 USoundWave* UDlgContext::GetActiveNodeVoiceSoundWave() const
@@ -242,7 +250,7 @@ USoundWave* UDlgContext::GetActiveNodeVoiceSoundWave() const
 		return nullptr;
 	}
 
-	return Node->GetNodeVoiceSoundWave();
+	return Cast<USoundWave>(Node->GetNodeVoiceSoundBaseInContext(*this));
 }
 
 USoundBase* UDlgContext::GetActiveNodeVoiceSoundBase() const
@@ -254,7 +262,7 @@ USoundBase* UDlgContext::GetActiveNodeVoiceSoundBase() const
 		return nullptr;
 	}
 
-	return Node->GetNodeVoiceSoundBase();
+	return Node->GetNodeVoiceSoundBaseInContext(*this);
 }
 
 UDialogueWave* UDlgContext::GetActiveNodeVoiceDialogueWave() const
@@ -266,7 +274,7 @@ UDialogueWave* UDlgContext::GetActiveNodeVoiceDialogueWave() const
 		return nullptr;
 	}
 
-	return Node->GetNodeVoiceDialogueWave();
+	return Node->GetNodeVoiceDialogueWaveInContext(*this);
 }
 
 UObject* UDlgContext::GetActiveNodeGenericData() const
@@ -278,7 +286,7 @@ UObject* UDlgContext::GetActiveNodeGenericData() const
 		return nullptr;
 	}
 
-	return Node->GetNodeGenericData();
+	return Node->GetNodeGenericDataInContext(*this);
 }
 
 UDlgNodeData* UDlgContext::GetActiveNodeData() const
@@ -290,7 +298,7 @@ UDlgNodeData* UDlgContext::GetActiveNodeData() const
 		return nullptr;
 	}
 
-	return Node->GetNodeData();
+	return Node->GetNodeDataInContext(*this);
 }
 
 UTexture2D* UDlgContext::GetActiveNodeParticipantIcon() const
@@ -302,7 +310,7 @@ UTexture2D* UDlgContext::GetActiveNodeParticipantIcon() const
 		return nullptr;
 	}
 
-	const FName SpeakerName = Node->GetNodeParticipantName();
+	const FName SpeakerName = Node->GetNodeParticipantNameInContext(*this);
 	auto* ObjectPtr = Participants.Find(SpeakerName);
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
@@ -313,7 +321,7 @@ UTexture2D* UDlgContext::GetActiveNodeParticipantIcon() const
 		return nullptr;
 	}
 
-	return IDlgDialogueParticipant::Execute_GetParticipantIcon(*ObjectPtr, SpeakerName, Node->GetSpeakerState());
+	return IDlgDialogueParticipant::Execute_GetParticipantIcon(*ObjectPtr, SpeakerName, Node->GetSpeakerStateInContext(*this));
 }
 
 UObject* UDlgContext::GetActiveNodeParticipant() const
@@ -325,8 +333,8 @@ UObject* UDlgContext::GetActiveNodeParticipant() const
 		return nullptr;
 	}
 
-	const FName SpeakerName = Node->GetNodeParticipantName();
-	auto* ObjectPtr = Participants.Find(Node->GetNodeParticipantName());
+	const FName SpeakerName = Node->GetNodeParticipantNameInContext(*this);
+	auto* ObjectPtr = Participants.Find(Node->GetNodeParticipantNameInContext(*this));
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
 		LogErrorWithContext(FString::Printf(
@@ -348,7 +356,7 @@ FName UDlgContext::GetActiveNodeParticipantName() const
 		return NAME_None;
 	}
 
-	return Node->GetNodeParticipantName();
+	return Node->GetNodeParticipantNameInContext(*this);
 }
 
 FText UDlgContext::GetActiveNodeParticipantDisplayName() const
@@ -360,7 +368,7 @@ FText UDlgContext::GetActiveNodeParticipantDisplayName() const
 		return FText::GetEmpty();
 	}
 
-	const FName SpeakerName = Node->GetNodeParticipantName();
+	const FName SpeakerName = Node->GetNodeParticipantNameInContext(*this);
 	auto* ObjectPtr = Participants.Find(SpeakerName);
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
@@ -396,6 +404,34 @@ const UObject* UDlgContext::GetParticipant(FName ParticipantName) const
 	return nullptr;
 }
 
+const UObject* UDlgContext::GetRuntimeGraphParticipant(const FDlgRuntimeGraph& RuntimeGraph, int32 Slot) const
+{
+	if (Slot == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	if (RuntimeGraphParticipantsVersion != RuntimeGraph.GetVersion())
+	{
+		const TArray<FName>& ParticipantNames = RuntimeGraph.GetParticipantNames();
+		RuntimeGraphParticipants.Reset();
+		for (const FName ParticipantName : ParticipantNames)
+		{
+			RuntimeGraphParticipants.Add(Participants.Find(ParticipantName));
+		}
+		RuntimeGraphParticipantsVersion = RuntimeGraph.GetVersion();
+	}
+
+	// Same as GetParticipant
+	UObject* const* ParticipantPtr = RuntimeGraphParticipants[Slot];
+	if (ParticipantPtr != nullptr && IsValid(*ParticipantPtr))
+	{
+		return *ParticipantPtr;
+	}
+
+	return nullptr;
+}
+
 UObject* UDlgContext::GetParticipantFromName(const FDlgParticipantName& Participant)
 {
 	if (UObject** ParticipantObjectPtr = Participants.Find(Participant.ParticipantName))
@@ -498,7 +534,13 @@ bool UDlgContext::IsOptionConnectedToEndNode(int32 Index, bool bIndexSkipsUnsati
 	return false;
 }
 
-bool UDlgContext::EnterNode(int32 NodeIndex, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgContext::EnterNode(int32 NodeIndex)
+{
+	FDlgVisitedNodes NodesEnteredWithThisStep(Dialogue);
+	return EnterNode(NodeIndex, NodesEnteredWithThisStep);
+}
+
+bool UDlgContext::EnterNode(int32 NodeIndex, FDlgVisitedNodes& NodesEnteredWithThisStep)
 {
 	check(Dialogue);
 	UDlgNode* Node = GetMutableNodeFromIndex(NodeIndex);
@@ -508,6 +550,7 @@ bool UDlgContext::EnterNode(int32 NodeIndex, TSet<const UDlgNode*> NodesEnteredW
 		return false;
 	}
 
+	const FDlgNodeEvaluationCache::FScope EvaluationScope(NodeEvaluationCache);
 	ActiveNodeIndex = NodeIndex;
 	SetNodeVisited(NodeIndex, Node->GetGUID());
 
@@ -537,6 +580,9 @@ UDlgContext* UDlgContext::CreateCopy() const
 	Context->AvailableChildren = AvailableChildren;
 	Context->AllChildren = AllChildren;
 	Context->History = History;
+	Context->HistoryOwner = HistoryOwner;
+	Context->HistoryStore = HistoryStore;
+	Context->NodesState = NodesState;
 	Context->bDialogueEnded = bDialogueEnded;
 
 	return Context;
@@ -544,8 +590,9 @@ UDlgContext* UDlgContext::CreateCopy() const
 
 void UDlgContext::SetNodeVisited(int32 NodeIndex, const FGuid& NodeGUID)
 {
-	FDlgMemory::Get().SetNodeVisited(Dialogue->GetGUID(), NodeIndex, NodeGUID);
+	GetHistoryStore().SetNodeVisited(Dialogue->GetGUID(), NodeIndex, NodeGUID);
 	History.Add(NodeIndex, NodeGUID);
+	NodeEvaluationCache.Invalidate();
 }
 
 bool UDlgContext::IsNodeVisited(int32 NodeIndex, const FGuid& NodeGUID, bool bLocalHistory) const
@@ -555,12 +602,53 @@ bool UDlgContext::IsNodeVisited(int32 NodeIndex, const FGuid& NodeGUID, bool bLo
 		return History.Contains(NodeIndex, NodeGUID);
 	}
 
-	return FDlgMemory::Get().IsNodeVisited(Dialogue->GetGUID(), NodeIndex, NodeGUID);
+	return GetHistoryStore().IsNodeVisited(Dialogue->GetGUID(), NodeIndex, NodeGUID);
 }
 
 FDlgNodeSavedData& UDlgContext::GetNodeSavedData(const FGuid& NodeGUID)
 {
-	return FDlgMemory::Get().FindOrAddEntry(Dialogue->GetGUID()).GetNodeData(NodeGUID);
+	return GetHistoryStore().FindOrAddEntry(Dialogue->GetGUID()).GetNodeData(NodeGUID);
+}
+
+void UDlgContext::ResetContext()
+{
+	Dialogue = nullptr;
+	Participants.Reset();
+	SerializedParticipants.Reset();
+	RuntimeGraphParticipantsVersion = 0;
+	ActiveNodeIndex = INDEX_NONE;
+	AvailableChildren.Reset();
+	AllChildren.Reset();
+	History = FDlgHistory();
+	HistoryOwner.Reset();
+	HistoryStore.Reset();
+	NodesState.Reset();
+	ParticipantValueCache = nullptr;
+	NodeEvaluationCache.Reset();
+	bDialogueEnded = false;
+}
+
+void UDlgContext::SetHistoryOwner(UObject* InHistoryOwner)
+{
+	HistoryOwner = InHistoryOwner;
+	HistoryStore = FDlgMemory::Get().FindOrAddStore(InHistoryOwner);
+}
+
+FDlgHistoryStore& UDlgContext::GetHistoryStore() const
+{
+	// Not started yet, use the global one
+	return HistoryStore.IsValid() ? *HistoryStore : *FDlgMemory::Get().GetGlobalStore();
+}
+
+void UDlgContext::BindDefaultHistoryStore()
+{
+	if (HistoryStore.IsValid())
+	{
+		return;
+	}
+
+	const UDlgSystemSettings* Settings = GetDefault<UDlgSystemSettings>();
+	SetHistoryOwner(Settings->DefaultHistoryScope == EDlgHistoryScope::World ? GetWorld() : nullptr);
 }
 
 UDlgNode_SpeechSequence* UDlgContext::GetMutableActiveNodeAsSpeechSequence() const
@@ -617,20 +705,48 @@ const UDlgNode* UDlgContext::GetNodeFromGUID(const FGuid& NodeGUID) const
 	return Dialogue->GetMutableNodeFromGUID(NodeGUID);
 }
 
-bool UDlgContext::IsNodeEnterable(int32 NodeIndex, TSet<const UDlgNode*> AlreadyVisitedNodes) const
+bool UDlgContext::IsNodeEnterable(int32 NodeIndex) const
+{
+	const FDlgNodeEvaluationCache::FScope EvaluationScope(NodeEvaluationCache);
+	FDlgVisitedNodes AlreadyVisitedNodes(Dialogue);
+	return IsNodeEnterable(NodeIndex, AlreadyVisitedNodes);
+}
+
+bool UDlgContext::IsNodeEnterable(int32 NodeIndex, FDlgVisitedNodes& AlreadyVisitedNodes) const
 {
 	check(Dialogue);
-	if (const UDlgNode* Node = GetNodeFromIndex(NodeIndex))
+	const FDlgRuntimeGraph& RuntimeGraph = Dialogue->GetRuntimeGraph();
+	if (RuntimeGraph.IsValid())
+	{
+		return RuntimeGraph.CheckNodeEnterConditions(*this, NodeIndex, AlreadyVisitedNodes);
+	}
+
+	const UDlgNode* Node = GetNodeFromIndex(NodeIndex);
+	if (Node == nullptr)
+	{
+		return false;
+	}
+
+	// Let the node handle the loop
+	if (AlreadyVisitedNodes.Contains(Node))
 	{
 		return Node->CheckNodeEnterConditions(*this, AlreadyVisitedNodes);
 	}
 
-	return false;
+	return NodeEvaluationCache.FindOrEvaluateEnterable(NodeIndex, [this, Node, &AlreadyVisitedNodes]()
+	{
+		return Node->CheckNodeEnterConditions(*this, AlreadyVisitedNodes);
+	});
 }
 
-bool UDlgContext::CanBeStarted(UDlgDialogue* InDialogue, const TMap<FName, UObject*>& InParticipants)
+bool UDlgContext::CanBeStarted(
+	UDlgDialogue* InDialogue,
+	const TMap<FName, UObject*>& InParticipants,
+	UObject* InHistoryOwner,
+	FDlgParticipantValueCache* ValueCache
+)
 {
-	if (!ValidateParticipantsMapForDialogue(TEXT("CanBeStarted"), InDialogue, InParticipants, false))
+	if (!ValidateParticipantsMapForDialogue(TEXT("CanBeStarted"), InDialogue, InParticipants, false, ValueCache))
 	{
 		return false;
 	}
@@ -647,21 +763,40 @@ bool UDlgContext::CanBeStarted(UDlgDialogue* InDialogue, const TMap<FName, UObje
 	}
 	check(FirstParticipant != nullptr);
 
-	// Create temporary context that is Garbage Collected after this function returns (hopefully)
-	auto* Context = NewObject<UDlgContext>(FirstParticipant, UDlgContext::StaticClass());
+	// Reuse the scratch context of the world so that we do not create an object for each check
+	UDlgContextPool::FScratchScope ScratchScope(UDlgContextPool::Get(FirstParticipant));
+	UDlgContext* Context = ScratchScope.Context;
+	if (Context == nullptr)
+	{
+		// Create temporary context that is Garbage Collected after this function returns (hopefully)
+		Context = NewObject<UDlgContext>(FirstParticipant, UDlgContext::StaticClass());
+	}
 	Context->Dialogue = InDialogue;
 	Context->SetParticipants(InParticipants);
+	if (InHistoryOwner)
+	{
+		Context->SetHistoryOwner(InHistoryOwner);
+	}
+	Context->BindDefaultHistoryStore();
+
+	// The cache only lives for the duration of the caller batch, do not keep it in the context
+	Context->ParticipantValueCache = ValueCache;
+	ON_SCOPE_EXIT
+	{
+		Context->ParticipantValueCache = nullptr;
+	};
+	const FDlgNodeEvaluationCache::FScope EvaluationScope(Context->NodeEvaluationCache);
 
 	// Evaluate edges/children of the start node
 	for (const UDlgNode* StartNode : InDialogue->GetStartNodes())
 	{
 		for (const FDlgEdge& ChildLink : StartNode->GetNodeChildren())
 		{
-			if (ChildLink.Evaluate(*Context, {}))
+			if (ChildLink.Evaluate(*Context))
 			{
 				// Simulate EnterNode
 				UDlgNode* Node = Context->GetMutableNodeFromIndex(ChildLink.TargetIndex);
-				if (Node && Node->HasAnySatisfiedChild(*Context, {}))
+				if (Node && Node->HasAnySatisfiedChild(*Context))
 				{
 					return true;
 				}
@@ -680,6 +815,8 @@ bool UDlgContext::StartWithContext(const FString& ContextString, UDlgDialogue* I
 
 	Dialogue = InDialogue;
 	SetParticipants(InParticipants);
+	NodesState.Empty();
+	BindDefaultHistoryStore();
 	if (!ValidateParticipantsMapForDialogue(ContextMessage, Dialogue, Participants))
 	{
 		return false;
@@ -691,9 +828,9 @@ bool UDlgContext::StartWithContext(const FString& ContextString, UDlgDialogue* I
 	{
 		for (const FDlgEdge& ChildLink : StartNode->GetNodeChildren())
 		{
-			if (ChildLink.Evaluate(*this, {}))
+			if (ChildLink.Evaluate(*this))
 			{
-				if (EnterNode(ChildLink.TargetIndex, {}))
+				if (EnterNode(ChildLink.TargetIndex))
 				{
 					return true;
 				}
@@ -725,6 +862,8 @@ bool UDlgContext::StartWithContextFromNode(
 	Dialogue = InDialogue;
 	SetParticipants(InParticipants);
 	History = StartHistory;
+	NodesState.Empty();
+	BindDefaultHistoryStore();
 	if (!ValidateParticipantsMapForDialogue(ContextMessage, Dialogue, Participants))
 	{
 		return false;
@@ -748,35 +887,45 @@ bool UDlgContext::StartWithContextFromNode(
 
 	if (bFireEnterEvents)
 	{
-		return EnterNode(StartNodeIndex, {});
+		return EnterNode(StartNodeIndex);
 	}
 
 	ActiveNodeIndex = StartNodeIndex;
 	SetNodeVisited(StartNodeIndex, Node->GetGUID());
 
-	return Node->ReevaluateChildren(*this, {});
+	const FDlgNodeEvaluationCache::FScope EvaluationScope(NodeEvaluationCache);
+	FDlgVisitedNodes AlreadyEvaluated(Dialogue);
+	return Node->ReevaluateChildren(*this, AlreadyEvaluated);
 }
 
 FString UDlgContext::GetContextString() const
 {
-	FString ContextParticipants;
-	TSet<FString> ParticipantsNames;
+	// The participant names are the keys of the map, unique already
+	FString ParticipantsNames;
+	ParticipantsNames.Reserve(Participants.Num() * 16);
 	for (const auto& KeyValue : Participants)
 	{
-		ParticipantsNames.Add(KeyValue.Key.ToString());
+		if (!ParticipantsNames.IsEmpty())
+		{
+			ParticipantsNames += TEXT(", ");
+		}
+		KeyValue.Key.AppendString(ParticipantsNames);
 	}
 
 	return FString::Printf(
 		TEXT("Dialogue = `%s`, ActiveNodeIndex = %d, Participants Names = `%s`"),
 		Dialogue ? *Dialogue->GetPathName() : TEXT("INVALID"),
 		ActiveNodeIndex,
-		*FString::Join(ParticipantsNames, TEXT(", "))
+		*ParticipantsNames
 	);
 }
 
 void UDlgContext::LogErrorWithContext(const FString& ErrorMessage) const
 {
-	FDlgLogger::Get().Error(GetErrorMessageWithContext(ErrorMessage));
+	FDlgLogger::Get().ErrorLazy([this, &ErrorMessage]()
+	{
+		return GetErrorMessageWithContext(ErrorMessage);
+	});
 }
 
 FString UDlgContext::GetErrorMessageWithContext(const FString& ErrorMessage) const
@@ -884,7 +1033,8 @@ bool UDlgContext::ValidateParticipantsMapForDialogue(
 	const FString& ContextString,
 	const UDlgDialogue* Dialogue,
 	const TMap<FName, UObject*>& ParticipantsMap,
-	bool bLog
+	bool bLog,
+	FDlgParticipantValueCache* ValueCache
 )
 {
 	const FString ContextMessage = ContextString.IsEmpty()
@@ -930,7 +1080,7 @@ bool UDlgContext::ValidateParticipantsMapForDialogue(
 		// This should only happen if you constructed the map incorrectly by mistake
 		// If you used ConvertArrayOfParticipantsToMap this should have NOT happened
 		{
-			const FName ObjectParticipantName = IDlgDialogueParticipant::Execute_GetParticipantName(Participant);
+			const FName ObjectParticipantName = FDlgParticipantValueCache::GetParticipantName(ValueCache, Participant);
 			if (ParticipantName != ObjectParticipantName)
 			{
 				if (bLog)
@@ -990,7 +1140,8 @@ bool UDlgContext::ConvertArrayOfParticipantsToMap(
 	const UDlgDialogue* Dialogue,
 	const TArray<UObject*>& ParticipantsArray,
 	TMap<FName, UObject*>& OutParticipantsMap,
-	bool bLog
+	bool bLog,
+	FDlgParticipantValueCache* ValueCache
 )
 {
 	const FString ContextMessage = ContextString.IsEmpty()
@@ -998,7 +1149,7 @@ bool UDlgContext::ConvertArrayOfParticipantsToMap(
 		: FString::Printf(TEXT("%s - ConvertArrayOfParticipantsToMap"), *ContextString);
 
 	// We don't allow to convert empty arrays
-	OutParticipantsMap.Empty();
+	OutParticipantsMap.Reset();
 	if (ParticipantsArray.Num() == 0)
 	{
 		if (bLog)
@@ -1014,7 +1165,8 @@ bool UDlgContext::ConvertArrayOfParticipantsToMap(
 	for (int32 Index = 0; Index < ParticipantsArray.Num(); Index++)
 	{
 		UObject* Participant = ParticipantsArray[Index];
-		const FString ContextMessageWithIndex = FString::Printf(TEXT("%s - Participant at Index = %d"), *ContextMessage,  Index);
+		// Only used for logging
+		const FString ContextMessageWithIndex = bLog ? FString::Printf(TEXT("%s - Participant at Index = %d"), *ContextMessage,  Index) : FString();
 
 		// We must check this otherwise we can't get the name
 		if (!ValidateParticipantForDialogue(ContextMessageWithIndex, Dialogue, Participant, bLog))
@@ -1024,7 +1176,7 @@ bool UDlgContext::ConvertArrayOfParticipantsToMap(
 
 		// Is Duplicate?
 		// Just warn the user about it, but still continue our conversion
-		const FName ParticipantName = IDlgDialogueParticipant::Execute_GetParticipantName(Participant);
+		const FName ParticipantName = FDlgParticipantValueCache::GetParticipantName(ValueCache, Participant);
 		if (OutParticipantsMap.Contains(ParticipantName))
 		{
 			if (bLog)
@@ -6,6 +6,7 @@
 #include "Nodes/DlgNode.h"
 #include "DlgMemory.h"
 #include "DlgParticipantName.h"
+#include "DlgNodeEvaluationCache.h"
 
 #include "DlgContext.generated.h"
 
@@ -16,6 +17,8 @@ class UTexture2D;
 class UDlgNodeData;
 class UDlgNode;
 class UDlgNode_SpeechSequence;
+class FDlgVisitedNodes;
+class FDlgParticipantValueCache;
 
 // Used to store temporary state of edges
 // This represents a const version of an Edge
@@ -37,7 +40,8 @@ public:
 		return DlgEdge;
 	}
 
-	// FDlgEdge& GetMutableEdge() { return *EdgePtr; }
+	// Only used on the options owned by a context
+	FDlgEdge& GetMutableEdge() { return Edge; }
 
 protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Dialogue|Edge")
@@ -48,6 +52,29 @@ protected:
 };
 
 
+// Runtime state of a single node that is owned by a context.
+// The Dialogue (and its nodes) is never modified at runtime, this way any number of contexts can share the same Dialogue.
+struct DLGSYSTEM_API FDlgNodeContextState
+{
+	const FText& GetConstructedEdgeText(int32 EdgeIndex) const
+	{
+		return ConstructedEdgeTexts.IsValidIndex(EdgeIndex) ? ConstructedEdgeTexts[EdgeIndex] : FText::GetEmpty();
+	}
+
+	// Constructed from the node text and the text arguments (if any)
+	FText ConstructedText;
+
+	// Constructed from the edge text and the text arguments (if any), same indices as the node Children
+	TArray<FText> ConstructedEdgeTexts;
+
+	// The current active index in the SpeechSequence array, used by UDlgNode_SpeechSequence
+	int32 SpeechSequenceIndex = INDEX_NONE;
+
+	// The first satisfied direct child of a virtual parent, used by UDlgNode_Speech
+	int32 VirtualParentFirstSatisfiedDirectChildIndex = INDEX_NONE;
+};
+
+
 UENUM()
 enum class EDlgValidateStatus : uint8
 {
@@ -146,6 +173,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Control")
 	bool HasDialogueEnded() const { return bDialogueEnded; }
 
+	// Is the context in the middle of a Dialogue? (started and not ended yet)
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Control")
+	bool IsDialogueActive() const { return Dialogue != nullptr && ActiveNodeIndex != INDEX_NONE && !bDialogueEnded; }
+
 	//
 	// Use these functions if you don't care about unsatisfied player options:
 	//
@@ -294,6 +325,10 @@ public:
 	UObject* GetMutableParticipant(FName ParticipantName) const;
 	const UObject* GetParticipant(FName ParticipantName) const;
 
+	// Same as GetParticipant for a participant slot of the RuntimeGraph (see FDlgRuntimeGraph::GetParticipantNames)
+	// The slots are resolved once and kept until the participants change, nullptr for INDEX_NONE
+	const UObject* GetRuntimeGraphParticipant(const FDlgRuntimeGraph& RuntimeGraph, int32 Slot) const;
+
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
 	const TMap<FName, UObject*>& GetParticipantsMap() const { return Participants; }
 
@@ -337,11 +372,16 @@ public:
 	// Returns the indices which were visited inside this single context. For global data check DlgMemory
 	// NOTE: You should use GetVisitedNodeGUIDs
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Context|History")
-	const TSet<int32>& GetVisitedNodeIndices() const { return History.VisitedNodeIndices; }
+	TSet<int32> GetVisitedNodeIndices() const { return History.GetVisitedNodeIndices(); }
 
 	// Returns the GUIDs which were visited inside this single context. For global data check DlgMemory
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Context|History")
-	const TSet<FGuid>& GetVisitedNodeGUIDs() const { return History.VisitedNodeGUIDs; }
+	TSet<FGuid> GetVisitedNodeGUIDs() const
+	{
+		TSet<FGuid> NodeGUIDs;
+		NodeGUIDs.Append(History.GetVisitedNodeGUIDs());
+		return NodeGUIDs;
+	}
 
 	// Helper methods to get some Dialogue properties
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
@@ -365,7 +405,8 @@ public:
 	// Depending on the node the EnterNode() call can lead to other EnterNode() calls - having NodeIndex as active node after the call
 	// is not granted
 	// Conditions are not checked here - they are expected to be satisfied
-	bool EnterNode(int32 NodeIndex, TSet<const UDlgNode*> NodesEnteredWithThisStep);
+	bool EnterNode(int32 NodeIndex);
+	bool EnterNode(int32 NodeIndex, FDlgVisitedNodes& NodesEnteredWithThisStep);
 
 	// Adds the node as visited in the current dialogue memory
 	virtual void SetNodeVisited(int32 NodeIndex, const FGuid& NodeGUID);
@@ -389,22 +430,50 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Context|History", DisplayName = "Was Node Index Visited In This Context")
 	bool WasNodeIndexVisitedInThisContext(int32 NodeIndex) const
 	{
-		return History.VisitedNodeIndices.Contains(NodeIndex);
+		return History.ContainsNodeIndex(NodeIndex);
 	}
 
 	// Was the node GUID visited in the lifetime of this context?
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Context|History", DisplayName = "Was Node GUID Visited In This Context")
 	bool WasNodeGUIDVisitedInThisContext(const FGuid& NodeGUID) const
 	{
-		return History.VisitedNodeGUIDs.Contains(NodeGUID);
+		return History.ContainsNodeGUID(NodeGUID);
 	}
 
 	// Gets the History of this context
 	const FDlgHistory& GetHistoryOfThisContext() const { return History; }
 
+	// Clears all the runtime data (Dialogue, participants, options, history) so that the context can be started again.
+	// The containers keep their memory, used by UDlgContextPool
+	void ResetContext();
+
+	// Binds this context to the history store of the HistoryOwner (a World, a PlayerState, any object), see FDlgMemory
+	// nullptr means the global store. If this is not called before the start, the owner is set from UDlgSystemSettings::DefaultHistoryScope
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Context|History")
+	void SetHistoryOwner(UObject* InHistoryOwner);
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Context|History")
+	UObject* GetHistoryOwner() const { return HistoryOwner.Get(); }
+
+	// Gets the store that holds the Dialogue history (not only of this context) used by this context
+	FDlgHistoryStore& GetHistoryStore() const;
+
+	// Values read from the participants shared between evaluations, only set while evaluating a batch (see UDlgManager::CanStartDialogues)
+	FDlgParticipantValueCache* GetParticipantValueCache() const { return ParticipantValueCache; }
+
+	// Memo table of the node evaluation results for the current evaluation step, also has the hit counters (see GetStats)
+	FDlgNodeEvaluationCache& GetNodeEvaluationCache() const { return NodeEvaluationCache; }
+
+	// Gets the runtime state of the Node inside this context, it is created if it does not exist yet
+	FDlgNodeContextState& FindOrAddNodeState(const UDlgNode* Node) { return NodesState.FindOrAdd(Node); }
+
+	// Gets the runtime state of the Node inside this context, nullptr if the Node was not touched by this context yet
+	const FDlgNodeContextState* FindNodeState(const UDlgNode* Node) const { return NodesState.Find(Node); }
+
 	// Checks the enter conditions of the node.
 	// return false if they are not satisfied or if the index is invalid
-	bool IsNodeEnterable(int32 NodeIndex, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
+	bool IsNodeEnterable(int32 NodeIndex) const;
+	bool IsNodeEnterable(int32 NodeIndex, FDlgVisitedNodes& AlreadyVisitedNodes) const;
 
 	// Initializes/Starts the context, the first (start) node is selected and the first valid child node is entered.
 	// Called by the UDlgManager which creates the context
@@ -537,7 +606,13 @@ public:
 	UDlgContext* CreateCopy() const;
 
 	// Checks if the context could be started, used to check if there is any reachable node from the start node
-	static bool CanBeStarted(UDlgDialogue* InDialogue, const TMap<FName, UObject*>& InParticipants);
+	// ValueCache is used for the values read from the participants by the conditions, can be nullptr
+	static bool CanBeStarted(
+		UDlgDialogue* InDialogue,
+		const TMap<FName, UObject*>& InParticipants,
+		UObject* InHistoryOwner = nullptr,
+		FDlgParticipantValueCache* ValueCache = nullptr
+	);
 
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Context")
 	FString GetContextString() const;
@@ -559,7 +634,8 @@ public:
 		const FString& ContextString,
 		const UDlgDialogue* Dialogue,
 		const TMap<FName, UObject*>& ParticipantsMap,
-		bool bLog = true
+		bool bLog = true,
+		FDlgParticipantValueCache* ValueCache = nullptr
 	);
 
 	// Just converts the array to a map, this does minimal checking just for the conversion to work
@@ -569,7 +645,8 @@ public:
 		const UDlgDialogue* Dialogue,
 		const TArray<UObject*>& ParticipantsArray,
 		TMap<FName, UObject*>& OutParticipantsMap,
-		bool bLog = true
+		bool bLog = true,
+		FDlgParticipantValueCache* ValueCache = nullptr
 	);
 
 protected:
@@ -581,8 +658,19 @@ protected:
 	{
 		Participants = InParticipants;
 		SerializeParticipants();
+		OnParticipantsChanged();
+	}
+
+	// Invalidates everything resolved from the Participants
+	void OnParticipantsChanged()
+	{
+		RuntimeGraphParticipantsVersion = 0;
+		NodeEvaluationCache.Invalidate();
 	}
 
+	// Binds the history store from the settings if SetHistoryOwner was not called
+	void BindDefaultHistoryStore();
+
 protected:
 	// Current Dialogue used in this context at runtime.
 	UPROPERTY(Replicated)
@@ -614,6 +702,29 @@ protected:
 	// History for this Context only
 	FDlgHistory History;
 
+	// Owner of the HistoryStore, nullptr for the global store
+	TWeakObjectPtr<UObject> HistoryOwner;
+
+	// The Dialogue history this context reads and writes, bound when started
+	TSharedPtr<FDlgHistoryStore> HistoryStore;
+
+	// Runtime state of the nodes of the Dialogue, only for the nodes touched by this context
+	// NOTE: the nodes are owned by the Dialogue which is referenced above
+	TMap<const UDlgNode*, FDlgNodeContextState> NodesState;
+
+	// Not owned, see GetParticipantValueCache
+	FDlgParticipantValueCache* ParticipantValueCache = nullptr;
+
+	// Evaluation results of the nodes, only valid during an evaluation step
+	mutable FDlgNodeEvaluationCache NodeEvaluationCache;
+
+	// Values of the Participants map for each participant slot of the runtime graph, nullptr if the participant does not exist
+	// Points inside the map, the map is not modified without calling OnParticipantsChanged
+	mutable TArray<UObject* const*, TInlineAllocator<8>> RuntimeGraphParticipants;
+
+	// FDlgRuntimeGraph::GetVersion of the graph RuntimeGraphParticipants was resolved for
+	mutable uint32 RuntimeGraphParticipantsVersion = 0;
+
 	// cache the result of the last ChooseOption call
 	bool bDialogueEnded = false;
 };
@@ -0,0 +1,92 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgContextPool.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+#include "DlgContext.h"
+#include "DlgSystemSettings.h"
+#include "Logging/DlgLogger.h"
+
+UDlgContextPool* UDlgContextPool::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject || !GEngine)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UDlgContextPool>() : nullptr;
+}
+
+void UDlgContextPool::Deinitialize()
+{
+	FreeContexts.Empty();
+	ScratchContext = nullptr;
+	bScratchContextInUse = false;
+
+	Super::Deinitialize();
+}
+
+UDlgContext* UDlgContextPool::Acquire()
+{
+	if (FreeContexts.Num() > 0)
+	{
+		return FreeContexts.Pop();
+	}
+
+	return NewObject<UDlgContext>(this, UDlgContext::StaticClass());
+}
+
+void UDlgContextPool::Release(UDlgContext* Context)
+{
+	if (!IsValid(Context) || !Owns(Context) || Context == ScratchContext)
+	{
+		return;
+	}
+
+	// Someone could still be listening to it (e.g. the UI of the Dialogue), end the Dialogue first
+	if (Context->IsDialogueActive())
+	{
+		FDlgLogger::Get().Warningf(
+			TEXT("UDlgContextPool::Release - The Context is still in the middle of a Dialogue, it is NOT put back into the pool. Context = %s"),
+			*Context->GetContextString()
+		);
+		return;
+	}
+
+	Context->ResetContext();
+	if (FreeContexts.Num() < GetDefault<UDlgSystemSettings>()->MaxPooledDialogueContexts)
+	{
+		FreeContexts.AddUnique(Context);
+	}
+}
+
+bool UDlgContextPool::Owns(const UDlgContext* Context) const
+{
+	return Context && Context->GetOuter() == this;
+}
+
+UDlgContext* UDlgContextPool::AcquireScratchContext()
+{
+	// Someone is already using it, e.g. a condition that checks if another Dialogue can be started
+	if (bScratchContextInUse)
+	{
+		return nullptr;
+	}
+
+	if (ScratchContext == nullptr)
+	{
+		ScratchContext = NewObject<UDlgContext>(this, UDlgContext::StaticClass());
+	}
+
+	bScratchContextInUse = true;
+	return ScratchContext;
+}
+
+void UDlgContextPool::ReleaseScratchContext(UDlgContext* Context)
+{
+	check(Context == ScratchContext);
+	Context->ResetContext();
+	bScratchContextInUse = false;
+}
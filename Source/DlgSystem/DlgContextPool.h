@@ -0,0 +1,73 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "DlgContextPool.generated.h"
+
+class UDlgContext;
+
+/**
+ * Pool of Dialogue contexts of a World, so that starting a lot of short Dialogues (e.g. barks) does not create a new
+ * UDlgContext every time. Used by UDlgManager when UDlgSystemSettings::bPoolDialogueContexts is enabled, the contexts
+ * go back into the pool with UDlgManager::ReleaseDialogueContext.
+ * It also owns the scratch context used by UDlgContext::CanBeStarted, which is used regardless of the setting.
+ *
+ * NOTE: the pooled contexts and the scratch context are outered to the pool (and not to the first participant like the
+ * other contexts), the pool keeps them alive and the outer of the context is not one of its participants.
+ */
+UCLASS()
+class DLGSYSTEM_API UDlgContextPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Gets the pool of the World of WorldContextObject, nullptr if there is no World
+	static UDlgContextPool* Get(const UObject* WorldContextObject);
+
+	void Deinitialize() override;
+
+	// Gets a reset context from the pool, creates a new one if the pool is empty
+	UDlgContext* Acquire();
+
+	// Resets the Context and puts it back into the pool, the Context must have been acquired from this pool
+	// and must not be used after this. Refuses (with a warning) the contexts that are still in the middle of a Dialogue.
+	void Release(UDlgContext* Context);
+
+	// Is the Context owned by this pool?
+	bool Owns(const UDlgContext* Context) const;
+
+	int32 GetNumFreeContexts() const { return FreeContexts.Num(); }
+	const UDlgContext* GetScratchContext() const { return ScratchContext; }
+
+	// Gets the scratch context, only one user at a time, nullptr if it is already in use. See FScratchScope
+	UDlgContext* AcquireScratchContext();
+	void ReleaseScratchContext(UDlgContext* Context);
+
+	// Holds the scratch context for the lifetime of the scope
+	struct FScratchScope
+	{
+		explicit FScratchScope(UDlgContextPool* InPool)
+			: Pool(InPool), Context(InPool ? InPool->AcquireScratchContext() : nullptr) {}
+		~FScratchScope()
+		{
+			if (Context)
+			{
+				Pool->ReleaseScratchContext(Context);
+			}
+		}
+
+		UDlgContextPool* Pool;
+		UDlgContext* Context;
+	};
+
+protected:
+	UPROPERTY(Transient)
+	TArray<UDlgContext*> FreeContexts;
+
+	UPROPERTY(Transient)
+	UDlgContext* ScratchContext = nullptr;
+
+	bool bScratchContextInUse = false;
+};
@@ -4,6 +4,9 @@
 #include "UObject/DevObjectVersion.h"
 #include "HAL/FileManager.h"
 #include "Misc/Paths.h"
+#if NY_ENGINE_VERSION >= 504
+#include "UObject/AssetRegistryTagsContext.h"
+#endif
 
 #if WITH_EDITOR
 #include "EdGraph/EdGraph.h"
@@ -20,6 +23,9 @@
 #include "Nodes/DlgNode_Start.h"
 #include "DlgManager.h"
 #include "Logging/DlgLogger.h"
+#include "DlgNameIndex.h"
+#include "DlgGUIDRegistry.h"
+#include "DlgDialogueAssetData.h"
 #include "DlgHelper.h"
 
 #define LOCTEXT_NAMESPACE "DlgDialogue"
@@ -171,9 +177,29 @@ void UDlgDialogue::PostLoad()
 		}
 	}
 
+	// Compile the text formats once instead of every time a text is constructed
+	for (UDlgNode* StartNode : StartNodes)
+	{
+		StartNode->RebuildTextFormats();
+	}
+	for (UDlgNode* Node : Nodes)
+	{
+		Node->RebuildTextFormats();
+	}
+
+	RebuildRuntimeGraph();
+	FDlgNameIndex::Get().UpdateDialogue(*this);
+	FDlgGUIDRegistry::Get().Register(*this);
 	bWasLoaded = true;
 }
 
+void UDlgDialogue::BeginDestroy()
+{
+	FDlgNameIndex::Get().RemoveDialogue(this);
+	FDlgGUIDRegistry::Get().Unregister(this);
+	Super::BeginDestroy();
+}
+
 void UDlgDialogue::PostInitProperties()
 {
 	Super::PostInitProperties();
@@ -228,6 +254,34 @@ void UDlgDialogue::PostDuplicate(bool bDuplicateForPIE)
 	);
 }
 
+#if NY_ENGINE_VERSION >= 504
+void UDlgDialogue::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
+{
+	Super::GetAssetRegistryTags(Context);
+
+	TArray<TPair<FName, FString>> TagValues;
+	FDlgDialogueAssetData::FromDialogue(*this).GetTagValues(TagValues);
+	for (TPair<FName, FString>& Pair : TagValues)
+	{
+		const FAssetRegistryTag::ETagType Type = Pair.Key == FDlgDialogueAssetData::TagNodesNum ? FAssetRegistryTag::TT_Numerical : FAssetRegistryTag::TT_Hidden;
+		Context.AddTag(FAssetRegistryTag(Pair.Key, MoveTemp(Pair.Value), Type));
+	}
+}
+#else
+void UDlgDialogue::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
+{
+	Super::GetAssetRegistryTags(OutTags);
+
+	TArray<TPair<FName, FString>> TagValues;
+	FDlgDialogueAssetData::FromDialogue(*this).GetTagValues(TagValues);
+	for (TPair<FName, FString>& Pair : TagValues)
+	{
+		const FAssetRegistryTag::ETagType Type = Pair.Key == FDlgDialogueAssetData::TagNodesNum ? FAssetRegistryTag::TT_Numerical : FAssetRegistryTag::TT_Hidden;
+		OutTags.Add(FAssetRegistryTag(Pair.Key, MoveTemp(Pair.Value), Type));
+	}
+}
+#endif // NY_ENGINE_VERSION >= 504
+
 void UDlgDialogue::PostEditImport()
 {
 	Super::PostEditImport();
@@ -516,24 +570,25 @@ void UDlgDialogue::ImportFromFileFormat(EDlgDialogueTextFormat TextFormat)
 
 	// TODO(vampy): validate if data is legit, indicies exist and that sort.
 	// Check if Guid is not a duplicate
-	const TArray<UDlgDialogue*> DuplicateDialogues = UDlgManager::GetDialoguesWithDuplicateGUIDs();
-	if (DuplicateDialogues.Num() > 0)
+	if (UDlgManager::IsDialogueGUIDTaken(GUID, this))
 	{
-		if (DuplicateDialogues.Contains(this))
-		{
-			// found duplicate of this Dialogue
-			RegenerateGUID();
-			FDlgLogger::Get().Warningf(
-				TEXT("Creating new GUID = `%s` for Dialogue = `%s` because the input file contained a duplicate GUID."),
-				*GUID.ToString(), *GetPathName()
-			);
-		}
-		else
+		// found duplicate of this Dialogue
+		RegenerateGUID();
+		FDlgLogger::Get().Warningf(
+			TEXT("Creating new GUID = `%s` for Dialogue = `%s` because the input file contained a duplicate GUID."),
+			*GUID.ToString(), *GetPathName()
+		);
+	}
+	else
+	{
+		FDlgGUIDRegistry& GUIDRegistry = FDlgGUIDRegistry::Get();
+		GUIDRegistry.Register(*this);
+		if (GUIDRegistry.HasDuplicateGUIDs())
 		{
 			// We have bigger problems on our hands
 			FDlgLogger::Get().Errorf(
 				TEXT("Found Duplicate Dialogue that does not belong to this Dialogue = `%s`, DuplicateDialogues.Num = %d"),
-				*GetPathName(),  DuplicateDialogues.Num()
+				*GetPathName(), GUIDRegistry.GetDialoguesWithDuplicateGUIDs().Num()
 			);
 		}
 	}
@@ -581,8 +636,7 @@ void UDlgDialogue::ExportToFileFormat(EDlgDialogueTextFormat TextFormat) const
 		case EDlgDialogueTextFormat::JSON:
 		{
 			FDlgJsonWriter JsonWriter;
-			JsonWriter.Write(GetClass(), this);
-			JsonWriter.ExportToFile(TextFileName);
+			JsonWriter.WriteToFile(GetClass(), this, TextFileName);
 			break;
 		}
 		case EDlgDialogueTextFormat::DialogueDEPRECATED:
@@ -612,7 +666,12 @@ void UDlgDialogue::ExportToFileFormat(EDlgDialogueTextFormat TextFormat) const
 	}
 }
 
-FDlgParticipantData& UDlgDialogue::GetParticipantDataEntry(FName ParticipantName, FName FallbackParticipantName, bool bCheckNone, const FString& ContextMessage)
+FDlgParticipantData& UDlgDialogue::GetParticipantDataEntry(
+	FName ParticipantName,
+	FName FallbackParticipantName,
+	bool bCheckNone,
+	TFunctionRef<FString()> GetContextMessage
+)
 {
 	// Used to ignore some participants
 	static FDlgParticipantData BlackHoleParticipant;
@@ -623,10 +682,13 @@ FDlgParticipantData& UDlgDialogue::GetParticipantDataEntry(FName ParticipantName
 	// Parent/child is not valid, simply do nothing
 	if (bCheckNone && ValidParticipantName == NAME_None)
 	{
-		FDlgLogger::Get().Warningf(
-			TEXT("Ignoring ParticipantName = None, Context = `%s`. Either your node participant name is None or your participant name is None."),
-			*ContextMessage
-		);
+		FDlgLogger::Get().WarningLazy([&GetContextMessage]()
+		{
+			return FString::Printf(
+				TEXT("Ignoring ParticipantName = None, Context = `%s`. Either your node participant name is None or your participant name is None."),
+				*GetContextMessage()
+			);
+		});
 		return BlackHoleParticipant;
 	}
 
@@ -635,7 +697,11 @@ FDlgParticipantData& UDlgDialogue::GetParticipantDataEntry(FName ParticipantName
 
 void UDlgDialogue::AddConditionsDataFromNodeEdges(const UDlgNode* Node, int32 NodeIndex)
 {
-	const FString NodeContext = FString::Printf(TEXT("Node %s"), NodeIndex > INDEX_NONE ? *FString::FromInt(NodeIndex) : TEXT("Start") );
+	// NOTE: the context messages are only built if the warning is logged
+	auto GetNodeContext = [NodeIndex]()
+	{
+		return FString::Printf(TEXT("Node %s"), NodeIndex > INDEX_NONE ? *FString::FromInt(NodeIndex) : TEXT("Start"));
+	};
 	const FName FallbackParticipantName = Node->GetNodeParticipantName();
 
 	for (const FDlgEdge& Edge : Node->GetNodeChildren())
@@ -646,15 +712,19 @@ void UDlgDialogue::AddConditionsDataFromNodeEdges(const UDlgNode* Node, int32 No
 		{
 			if (Condition.IsParticipantInvolved())
 			{
-				const FString ContextMessage = FString::Printf(TEXT("Adding Edge primary condition data from %s to Node %d"), *NodeContext, TargetIndex);
-				GetParticipantDataEntry(Condition.ParticipantName, FallbackParticipantName, true, ContextMessage)
-					.AddConditionPrimaryData(Condition);
+				FDlgParticipantData& ParticipantData = GetParticipantDataEntry(Condition.ParticipantName, FallbackParticipantName, true, [&]()
+				{
+					return FString::Printf(TEXT("Adding Edge primary condition data from %s to Node %d"), *GetNodeContext(), TargetIndex);
+				});
+				ParticipantData.AddConditionPrimaryData(Condition);
 			}
 			if (Condition.IsSecondParticipantInvolved())
 			{
-				const FString ContextMessage = FString::Printf(TEXT("Adding Edge secondary condition data from %s to Node %d"), *NodeContext, TargetIndex);
-				GetParticipantDataEntry(Condition.OtherParticipantName, FallbackParticipantName, true, ContextMessage)
-					.AddConditionSecondaryData(Condition);
+				FDlgParticipantData& ParticipantData = GetParticipantDataEntry(Condition.OtherParticipantName, FallbackParticipantName, true, [&]()
+				{
+					return FString::Printf(TEXT("Adding Edge secondary condition data from %s to Node %d"), *GetNodeContext(), TargetIndex);
+				});
+				ParticipantData.AddConditionSecondaryData(Condition);
 			}
 		}
 	}
@@ -676,6 +746,9 @@ void UDlgDialogue::RebuildAndUpdateNode(UDlgNode* Node, const UDlgSystemSettings
 
 	// Sync with the editor aka bUpdateGraphNode = true
 	Node->UpdateGraphNode();
+
+	// After the texts are final
+	Node->RebuildTextFormats();
 }
 
 void UDlgDialogue::UpdateAndRefreshData(bool bUpdateTextsNamespacesAndKeys)
@@ -697,7 +770,8 @@ void UDlgDialogue::UpdateAndRefreshData(bool bUpdateTextsNamespacesAndKeys)
 	const int32 NodesNum = Nodes.Num();
 	for (int32 NodeIndex = 0; NodeIndex < NodesNum; NodeIndex++)
 	{
-		const FString NodeContext = FString::Printf(TEXT("Node %d"), NodeIndex);
+		// NOTE: the context messages are only built if the warning is logged
+		auto GetNodeContext = [NodeIndex]() { return FString::Printf(TEXT("Node %d"), NodeIndex); };
 		UDlgNode* Node = Nodes[NodeIndex];
 		const FName NodeParticipantName = Node->GetNodeParticipantName();
 
@@ -723,15 +797,19 @@ void UDlgDialogue::UpdateAndRefreshData(bool bUpdateTextsNamespacesAndKeys)
 		{
 			if (Condition.IsParticipantInvolved())
 			{
-				const FString ContextMessage = FString::Printf(TEXT("Adding primary condition data for %s"), *NodeContext);
-				GetParticipantDataEntry(Condition.ParticipantName, NodeParticipantName, true, ContextMessage)
-					.AddConditionPrimaryData(Condition);
+				FDlgParticipantData& ParticipantData = GetParticipantDataEntry(Condition.ParticipantName, NodeParticipantName, true, [&]()
+				{
+					return FString::Printf(TEXT("Adding primary condition data for %s"), *GetNodeContext());
+				});
+				ParticipantData.AddConditionPrimaryData(Condition);
 			}
 			if (Condition.IsSecondParticipantInvolved())
 			{
-				const FString ContextMessage = FString::Printf(TEXT("Adding secondary condition data for %s"), *NodeContext);
-				GetParticipantDataEntry(Condition.OtherParticipantName, NodeParticipantName, true, ContextMessage)
-					.AddConditionSecondaryData(Condition);
+				FDlgParticipantData& ParticipantData = GetParticipantDataEntry(Condition.OtherParticipantName, NodeParticipantName, true, [&]()
+				{
+					return FString::Printf(TEXT("Adding secondary condition data for %s"), *GetNodeContext());
+				});
+				ParticipantData.AddConditionSecondaryData(Condition);
 			}
 		}
 
@@ -753,26 +831,32 @@ void UDlgDialogue::UpdateAndRefreshData(bool bUpdateTextsNamespacesAndKeys)
 			// Text arguments are rebuild from the Node
 			for (const FDlgTextArgument& TextArgument : Edge.GetTextArguments())
 			{
-				const FString ContextMessage = FString::Printf(TEXT("Adding Edge text arguments data from %s, to Node %d"), *NodeContext, TargetIndex);
-				GetParticipantDataEntry(TextArgument.ParticipantName, NodeParticipantName, true, ContextMessage)
-					.AddTextArgumentData(TextArgument);
+				FDlgParticipantData& ParticipantData = GetParticipantDataEntry(TextArgument.ParticipantName, NodeParticipantName, true, [&]()
+				{
+					return FString::Printf(TEXT("Adding Edge text arguments data from %s, to Node %d"), *GetNodeContext(), TargetIndex);
+				});
+				ParticipantData.AddTextArgumentData(TextArgument);
 			}
 		}
 
 		// Events
 		for (const FDlgEvent& Event : Node->GetNodeEnterEvents())
 		{
-			const FString ContextMessage = FString::Printf(TEXT("Adding events data for %s"), *NodeContext);
-			GetParticipantDataEntry(Event.ParticipantName, NodeParticipantName, true, ContextMessage)
-				.AddEventData(Event);
+			FDlgParticipantData& ParticipantData = GetParticipantDataEntry(Event.ParticipantName, NodeParticipantName, true, [&]()
+			{
+				return FString::Printf(TEXT("Adding events data for %s"), *GetNodeContext());
+			});
+			ParticipantData.AddEventData(Event);
 		}
 
 		// Text arguments
 		for (const FDlgTextArgument& TextArgument : Node->GetTextArguments())
 		{
-			const FString ContextMessage = FString::Printf(TEXT("Adding text arguments data for %s"), *NodeContext);
-			GetParticipantDataEntry(TextArgument.ParticipantName, NodeParticipantName, true, ContextMessage)
-				.AddTextArgumentData(TextArgument);
+			FDlgParticipantData& ParticipantData = GetParticipantDataEntry(TextArgument.ParticipantName, NodeParticipantName, true, [&]()
+			{
+				return FString::Printf(TEXT("Adding text arguments data for %s"), *GetNodeContext());
+			});
+			ParticipantData.AddTextArgumentData(TextArgument);
 		}
 	}
 
@@ -848,6 +932,15 @@ void UDlgDialogue::UpdateAndRefreshData(bool bUpdateTextsNamespacesAndKeys)
 			}
 		}
 	}
+
+	RebuildRuntimeGraph();
+	FDlgNameIndex::Get().UpdateDialogue(*this);
+}
+
+void UDlgDialogue::RegenerateGUID()
+{
+	GUID = FGuid::NewGuid();
+	FDlgGUIDRegistry::Get().Register(*this);
 }
 
 FGuid UDlgDialogue::GetNodeGUIDForIndex(int32 NodeIndex) const
@@ -884,6 +977,7 @@ void UDlgDialogue::SetNodes(const TArray<UDlgNode*>& InNodes)
 	{
 		UpdateGUIDToIndexMap(Nodes[NodeIndex], NodeIndex);
 	}
+	RebuildRuntimeGraph();
 }
 
 void UDlgDialogue::SetNode(int32 NodeIndex, UDlgNode* InNode)
@@ -895,6 +989,7 @@ void UDlgDialogue::SetNode(int32 NodeIndex, UDlgNode* InNode)
 
 	Nodes[NodeIndex] = InNode;
 	UpdateGUIDToIndexMap(InNode, NodeIndex);
+	RebuildRuntimeGraph();
 }
 
 void UDlgDialogue::UpdateGUIDToIndexMap(const UDlgNode* Node, int32 NodeIndex)
@@ -9,6 +9,7 @@
 #include "IDlgEditorAccess.h"
 #include "DlgSystemSettings.h"
 #include "DlgDialogueParticipantData.h"
+#include "DlgRuntimeGraph.h"
 
 #if NY_ENGINE_VERSION >= 500
 #include "UObject/ObjectSaveContext.h"
@@ -113,6 +114,9 @@ public:
 	 */
 	void PostInitProperties() override;
 
+	/** Called before destroying the object, removes the Dialogue from the FDlgNameIndex. */
+	void BeginDestroy() override;
+
 	/** Executed after Rename is executed. */
 	void PostRename(UObject* OldOuter, FName OldName) override;
 
@@ -129,6 +133,13 @@ public:
 	*/
 	void PostEditImport() override;
 
+	/** Exports the FDlgDialogueAssetData (GUID, participant names, ...) so that this Dialogue can be queried without loading it. */
+#if NY_ENGINE_VERSION >= 504
+	void GetAssetRegistryTags(FAssetRegistryTagsContext Context) const override;
+#else
+	void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
+#endif
+
 #if WITH_EDITOR
 	/**
 	 * Note that the object will be modified.  If we are currently recording into the
@@ -581,8 +592,8 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|GUID")
 	FGuid GetGUID() const { check(GUID.IsValid()); return GUID; }
 
-	// Regenerate the GUID of this Dialogue
-	void RegenerateGUID() { GUID = FGuid::NewGuid(); }
+	// Regenerate the GUID of this Dialogue, also updates the FDlgGUIDRegistry
+	void RegenerateGUID();
 
 	UFUNCTION(BlueprintPure, Category = "Dialogue|GUID")
 	bool HasGUID() const { return GUID.IsValid(); }
@@ -641,6 +652,12 @@ public:
 	// Sets the Node at index NodeIndex. Use with care.
 	void SetNode(int32 NodeIndex, UDlgNode* InNode);
 
+	// Compact representation of the Nodes used by the contexts to evaluate the nodes, see FDlgRuntimeGraph
+	const FDlgRuntimeGraph& GetRuntimeGraph() const { return RuntimeGraph; }
+
+	// Rebuilds the runtime graph from the Nodes, call this after modifying the Nodes or their edges/conditions
+	void RebuildRuntimeGraph() { RuntimeGraph.Build(*this); }
+
 	// Is the Node at NodeIndex (if it exists) an end node?
 	bool IsEndNode(int32 NodeIndex) const;
 
@@ -704,7 +721,8 @@ private:
 	void AddConditionsDataFromNodeEdges(const UDlgNode* Node, int32 NodeIndex);
 
 	// Gets the map entry - creates it first if it is not yet there
-	FDlgParticipantData& GetParticipantDataEntry(FName ParticipantName, FName FallbackParticipantName, bool bCheckNone, const FString& ContextMessage);
+	// GetContextMessage is only called if a warning is logged
+	FDlgParticipantData& GetParticipantDataEntry(FName ParticipantName, FName FallbackParticipantName, bool bCheckNone, TFunctionRef<FString()> GetContextMessage);
 
 	// Rebuild & Update and node and its edges
 	void RebuildAndUpdateNode(UDlgNode* Node, const UDlgSystemSettings& Settings, bool bUpdateTextsNamespacesAndKeys);
@@ -760,6 +778,9 @@ protected:
 	UPROPERTY(VisibleAnywhere, AdvancedDisplay, Category = "Dialogue", DisplayName = "Nodes GUID To Index Map")
 	TMap<FGuid, int32> NodesGUIDToIndexMap;
 
+	// Built from the Nodes when loaded/updated, not serialized
+	FDlgRuntimeGraph RuntimeGraph;
+
 	// Useful for syncing on the first run with the text file.
 	bool bIsSyncedWithTextFile = false;
 
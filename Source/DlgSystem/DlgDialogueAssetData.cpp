@@ -0,0 +1,219 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgDialogueAssetData.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "Dom/JsonObject.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include "DlgDialogue.h"
+#include "DlgHelper.h"
+
+const FName FDlgDialogueAssetData::TagGUID(TEXT("DlgGUID"));
+const FName FDlgDialogueAssetData::TagNodesNum(TEXT("DlgNodesNum"));
+const FName FDlgDialogueAssetData::TagParticipantNames(TEXT("DlgParticipantNames"));
+const FName FDlgDialogueAssetData::TagSpeakerStates(TEXT("DlgSpeakerStates"));
+const FName FDlgDialogueAssetData::TagParticipantsData(TEXT("DlgParticipantsData"));
+
+namespace DlgDialogueAssetData
+{
+	using FCondensedJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+	using FCondensedJsonWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	// Keys of the participants data, indexed by EDlgNameIndexType
+	static const TCHAR* NameTypeKeys[] = { TEXT("Int"), TEXT("Float"), TEXT("Bool"), TEXT("Name"), TEXT("Condition"), TEXT("Event") };
+	static_assert(NY_ARRAY_COUNT(NameTypeKeys) == static_cast<int32>(EDlgNameIndexType::Num), "NameTypeKeys must have a key for each EDlgNameIndexType");
+
+	static TArray<FName> ToSortedArray(const TSet<FName>& Set)
+	{
+		TArray<FName> Array = Set.Array();
+		FDlgHelper::SortDefault(Array);
+		return Array;
+	}
+
+	// Writes the names into the array started by the caller and ends it
+	static void WriteNames(FCondensedJsonWriter& Writer, const TArray<FName>& Names)
+	{
+		for (const FName Name : Names)
+		{
+			Writer.WriteValue(Name.ToString());
+		}
+		Writer.WriteArrayEnd();
+	}
+
+	static FString NamesToString(const TArray<FName>& Names)
+	{
+		FString String;
+		const TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&String);
+		Writer->WriteArrayStart();
+		WriteNames(*Writer, Names);
+		Writer->Close();
+		return String;
+	}
+
+	static void JsonValuesToNames(const TArray<TSharedPtr<FJsonValue>>& Values, TArray<FName>& OutNames)
+	{
+		OutNames.Reset(Values.Num());
+		for (const TSharedPtr<FJsonValue>& Value : Values)
+		{
+			FString String;
+			if (Value.IsValid() && Value->TryGetString(String))
+			{
+				OutNames.Add(FName(*String));
+			}
+		}
+	}
+
+	static bool StringToNames(const FString& String, TArray<FName>& OutNames)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(String);
+		if (!FJsonSerializer::Deserialize(Reader, Values))
+		{
+			return false;
+		}
+
+		JsonValuesToNames(Values, OutNames);
+		return true;
+	}
+}
+
+FDlgDialogueAssetData FDlgDialogueAssetData::FromDialogue(const UDlgDialogue& Dialogue)
+{
+	using namespace DlgDialogueAssetData;
+
+	FDlgDialogueAssetData Data;
+	Data.ObjectPath = FSoftObjectPath(&Dialogue);
+	if (Dialogue.HasGUID())
+	{
+		Data.GUID = Dialogue.GetGUID();
+	}
+	Data.NodesNum = Dialogue.GetNodes().Num();
+	Data.ParticipantNames = ToSortedArray(Dialogue.GetParticipantNames());
+	Data.SpeakerStates = ToSortedArray(Dialogue.GetSpeakerStates());
+
+	for (const auto& Pair : Dialogue.GetParticipantsData())
+	{
+		const FDlgParticipantData& ParticipantData = Pair.Value;
+		FParticipantNames& Names = Data.ParticipantsNames.Add(Pair.Key);
+		Names.Names[static_cast<int32>(EDlgNameIndexType::Int)] = ToSortedArray(ParticipantData.IntVariableNames);
+		Names.Names[static_cast<int32>(EDlgNameIndexType::Float)] = ToSortedArray(ParticipantData.FloatVariableNames);
+		Names.Names[static_cast<int32>(EDlgNameIndexType::Bool)] = ToSortedArray(ParticipantData.BoolVariableNames);
+		Names.Names[static_cast<int32>(EDlgNameIndexType::FName)] = ToSortedArray(ParticipantData.NameVariableNames);
+		Names.Names[static_cast<int32>(EDlgNameIndexType::Condition)] = ToSortedArray(ParticipantData.Conditions);
+		Names.Names[static_cast<int32>(EDlgNameIndexType::Event)] = ToSortedArray(ParticipantData.Events);
+	}
+	FDlgHelper::SortDefault(Data.ParticipantsNames);
+
+	return Data;
+}
+
+bool FDlgDialogueAssetData::FromAssetData(const FAssetData& AssetData, FDlgDialogueAssetData& OutData)
+{
+	using namespace DlgDialogueAssetData;
+
+	if (!HasMetadata(AssetData))
+	{
+		return false;
+	}
+
+	OutData = {};
+	OutData.ObjectPath = AssetData.ToSoftObjectPath();
+	GetGUID(AssetData, OutData.GUID);
+	GetParticipantNames(AssetData, OutData.ParticipantNames);
+
+	FString Value;
+	if (AssetData.GetTagValue(TagNodesNum, Value))
+	{
+		LexFromString(OutData.NodesNum, *Value);
+	}
+	if (AssetData.GetTagValue(TagSpeakerStates, Value))
+	{
+		StringToNames(Value, OutData.SpeakerStates);
+	}
+
+	TSharedPtr<FJsonObject> ParticipantsObject;
+	if (AssetData.GetTagValue(TagParticipantsData, Value))
+	{
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Value);
+		FJsonSerializer::Deserialize(Reader, ParticipantsObject);
+	}
+	if (ParticipantsObject.IsValid())
+	{
+		for (const auto& ParticipantPair : ParticipantsObject->Values)
+		{
+			const TSharedPtr<FJsonObject>* NamesObject = nullptr;
+			if (!ParticipantPair.Value.IsValid() || !ParticipantPair.Value->TryGetObject(NamesObject))
+			{
+				continue;
+			}
+
+			FParticipantNames& Names = OutData.ParticipantsNames.Add(FName(*ParticipantPair.Key));
+			for (int32 TypeIndex = 0; TypeIndex < static_cast<int32>(EDlgNameIndexType::Num); TypeIndex++)
+			{
+				const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+				if ((*NamesObject)->TryGetArrayField(NameTypeKeys[TypeIndex], Values))
+				{
+					JsonValuesToNames(*Values, Names.Names[TypeIndex]);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FDlgDialogueAssetData::GetGUID(const FAssetData& AssetData, FGuid& OutGUID)
+{
+	FString Value;
+	return AssetData.GetTagValue(TagGUID, Value) && FGuid::Parse(Value, OutGUID) && OutGUID.IsValid();
+}
+
+bool FDlgDialogueAssetData::GetParticipantNames(const FAssetData& AssetData, TArray<FName>& OutParticipantNames)
+{
+	FString Value;
+	return AssetData.GetTagValue(TagParticipantNames, Value) && DlgDialogueAssetData::StringToNames(Value, OutParticipantNames);
+}
+
+bool FDlgDialogueAssetData::HasMetadata(const FAssetData& AssetData)
+{
+	// All the tags are written together
+	return AssetData.TagsAndValues.Contains(TagParticipantNames);
+}
+
+void FDlgDialogueAssetData::GetTagValues(TArray<TPair<FName, FString>>& OutTagValues) const
+{
+	using namespace DlgDialogueAssetData;
+
+	// An all zero GUID would match the other Dialogues without a GUID
+	if (GUID.IsValid())
+	{
+		OutTagValues.Emplace(TagGUID, GUID.ToString());
+	}
+	OutTagValues.Emplace(TagNodesNum, LexToString(NodesNum));
+	OutTagValues.Emplace(TagParticipantNames, NamesToString(ParticipantNames));
+	OutTagValues.Emplace(TagSpeakerStates, NamesToString(SpeakerStates));
+
+	FString ParticipantsString;
+	const TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&ParticipantsString);
+	Writer->WriteObjectStart();
+	for (const auto& Pair : ParticipantsNames)
+	{
+		Writer->WriteObjectStart(Pair.Key.ToString());
+		for (int32 TypeIndex = 0; TypeIndex < static_cast<int32>(EDlgNameIndexType::Num); TypeIndex++)
+		{
+			const TArray<FName>& Names = Pair.Value.Names[TypeIndex];
+			if (Names.Num() > 0)
+			{
+				Writer->WriteArrayStart(NameTypeKeys[TypeIndex]);
+				WriteNames(*Writer, Names);
+			}
+		}
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	OutTagValues.Emplace(TagParticipantsData, MoveTemp(ParticipantsString));
+}
@@ -0,0 +1,68 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+#include "DlgNameIndex.h"
+
+class UDlgDialogue;
+struct FAssetData;
+
+/**
+ * Metadata of a Dialogue that is exported to its AssetRegistry tags (see UDlgDialogue::GetAssetRegistryTags),
+ * so that the Dialogues can be discovered and queried without loading them (see UDlgManager::GetAllDialoguesAssetData).
+ *
+ * The name lists are stored as JSON arrays, the participants data as a JSON object:
+ * { "ParticipantName": { "Int": ["Name", ...], "Float": [...], ... }, ... }
+ * NOTE: Dialogues saved before the tags existed do not have them, FromAssetData returns false for those.
+ */
+struct DLGSYSTEM_API FDlgDialogueAssetData
+{
+public:
+	// The names of a single participant, indexed by EDlgNameIndexType
+	struct FParticipantNames
+	{
+		TArray<FName> Names[static_cast<int32>(EDlgNameIndexType::Num)];
+
+		const TArray<FName>& Get(EDlgNameIndexType Type) const { return Names[static_cast<int32>(Type)]; }
+	};
+
+	// Builds the metadata from a loaded Dialogue
+	static FDlgDialogueAssetData FromDialogue(const UDlgDialogue& Dialogue);
+
+	// Reads the metadata from the tags, returns false if the asset does not have the tags
+	static bool FromAssetData(const FAssetData& AssetData, FDlgDialogueAssetData& OutData);
+
+	// Reads only some tags, cheaper than FromAssetData. Return false if the asset does not have the tag
+	// NOTE: the GUID tag is only written for the Dialogues with a valid GUID
+	static bool GetGUID(const FAssetData& AssetData, FGuid& OutGUID);
+	static bool GetParticipantNames(const FAssetData& AssetData, TArray<FName>& OutParticipantNames);
+	static bool HasMetadata(const FAssetData& AssetData);
+
+	// Key: Tag name, Value: Tag value
+	// NOTE: FAssetRegistryTag is not used directly because its scope differs between the engine versions
+	void GetTagValues(TArray<TPair<FName, FString>>& OutTagValues) const;
+
+	bool HasParticipant(FName ParticipantName) const { return ParticipantNames.Contains(ParticipantName); }
+
+public:
+	static const FName TagGUID;
+	static const FName TagNodesNum;
+	static const FName TagParticipantNames;
+	static const FName TagSpeakerStates;
+	static const FName TagParticipantsData;
+
+	// Path of the Dialogue asset
+	FSoftObjectPath ObjectPath;
+
+	FGuid GUID;
+	int32 NodesNum = 0;
+
+	// Sorted alphabetically ascending
+	TArray<FName> ParticipantNames;
+	TArray<FName> SpeakerStates;
+
+	// Key: Participant Name
+	TMap<FName, FParticipantNames> ParticipantsNames;
+};
@@ -4,6 +4,7 @@
 #include "DlgConstants.h"
 #include "DlgContext.h"
 #include "DlgLocalizationHelper.h"
+#include "DlgVisitedNodes.h"
 #include "Nodes/DlgNode_Selector.h"
 #include "Nodes/DlgNode_Speech.h"
 
@@ -81,7 +82,13 @@ void FDlgEdge::UpdateTextsNamespacesAndKeys(const UObject* ParentObject, const U
 	FDlgLocalizationHelper::UpdateTextNamespaceAndKey(ParentObject, Settings, Text);
 }
 
-bool FDlgEdge::Evaluate(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
+bool FDlgEdge::Evaluate(const UDlgContext& Context) const
+{
+	FDlgVisitedNodes AlreadyVisitedNodes(Context.GetDialogue());
+	return Evaluate(Context, AlreadyVisitedNodes);
+}
+
+bool FDlgEdge::Evaluate(const UDlgContext& Context, FDlgVisitedNodes& AlreadyVisitedNodes) const
 {
 	if (!IsValid())
 	{
@@ -98,17 +105,12 @@ bool FDlgEdge::Evaluate(const UDlgContext& Context, TSet<const UDlgNode*> Alread
 	return FDlgCondition::EvaluateArray(Context, Conditions);
 }
 
-void FDlgEdge::RebuildConstructedText(const UDlgContext& Context, FName FallbackParticipantName)
+FText FDlgEdge::ConstructText(const UDlgContext& Context, FName FallbackParticipantName) const
 {
 	if (TextArguments.Num() <= 0)
 	{
-		return;
+		return FText::GetEmpty();
 	}
 
-	FFormatNamedArguments OrderedArguments;
-	for (const FDlgTextArgument& DlgArgument : TextArguments)
-	{
-		OrderedArguments.Add(DlgArgument.DisplayString, DlgArgument.ConstructFormatArgumentValue(Context, FallbackParticipantName));
-	}
-	ConstructedText = FText::AsCultureInvariant(FText::Format(Text, OrderedArguments));
+	return FDlgTextArgument::ConstructFormattedText(Text, TextFormat, TextArguments, Context, FallbackParticipantName);
 }
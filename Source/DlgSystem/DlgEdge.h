@@ -14,6 +14,7 @@ class UDlgContext;
 class UDlgNode;
 class UDlgDialogue;
 class UDlgNodeData;
+class FDlgVisitedNodes;
 
 /**
  * The representation of a child in a node. Defined by a TargetIndex which points to the index array in the Dialogue.Nodes
@@ -62,14 +63,32 @@ public:
 	void UpdateTextsNamespacesAndKeys(const UObject* ParentObject, const UDlgSystemSettings& Settings);
 
 	// Rebuilds TextArguments
-	void RebuildTextArguments() { FDlgTextArgument::UpdateTextArgumentArray(Text, TextArguments); }
+	void RebuildTextArguments()
+	{
+		FDlgTextArgument::UpdateTextArgumentArray(Text, TextArguments);
+		RebuildTextFormat();
+	}
 	void RebuildTextArgumentsFromPreview(const FText& Preview) { FDlgTextArgument::UpdateTextArgumentArray(Preview, TextArguments); }
 
+	// Compiles the format pattern of the Text, used by ConstructText
+	void RebuildTextFormat() { TextFormat = FDlgTextArgument::CompileTextFormat(Text, TextArguments); }
+
 	// Returns with true if every condition attached to the edge and every enter condition of the target node are satisfied //
-	bool Evaluate(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
+	bool Evaluate(const UDlgContext& Context) const;
+	bool Evaluate(const UDlgContext& Context, FDlgVisitedNodes& AlreadyVisitedNodes) const;
 
 	// Constructs the ConstructedText.
-	void RebuildConstructedText(const UDlgContext& Context, FName FallbackParticipantName);
+	// NOTE: only call this on edges owned by the Context (the options), never on the edges of the Dialogue
+	void RebuildConstructedText(const UDlgContext& Context, FName FallbackParticipantName)
+	{
+		ConstructedText = ConstructText(Context, FallbackParticipantName);
+	}
+
+	// Formats the Text with the text arguments, returns an empty text if there are no text arguments
+	FText ConstructText(const UDlgContext& Context, FName FallbackParticipantName) const;
+
+	// Sets the text constructed by the Context, see ConstructText
+	void SetConstructedText(const FText& InConstructedText) { ConstructedText = InConstructedText; }
 
 	const TArray<FDlgTextArgument>& GetTextArguments() const { return TextArguments; }
 
@@ -147,7 +166,11 @@ protected:
 	TArray<FDlgTextArgument> TextArguments;
 
 	// Constructed at runtime from the original text and the arguments if there is any.
+	// Only set on the copies of the edge owned by a Context, the Dialogue edges never have this set.
 	FText ConstructedText;
+
+	// Compiled format pattern of the Text, only set if there are text arguments. See RebuildTextFormat
+	FTextFormat TextFormat;
 };
 
 template<>
@@ -10,21 +10,21 @@
 
 void FDlgEvent::Call(UDlgContext& Context, const FString& ContextString, UObject* Participant) const
 {
-	const bool bHasParticipant = ValidateIsParticipantValid(
-		Context,
-		FString::Printf(TEXT("%s::Call"), *ContextString),
-		Participant
-	);
+	// NOTE: the context string is only formatted on failure
+	const bool bHasParticipant = ValidateIsParticipantValid(Context, ContextString, Participant);
 
 	// We don't care if it has a participant, but warn nonetheless by calling validate it before this
 	if (EventType == EDlgEventType::Custom)
 	{
 		if (CustomEvent == nullptr)
 		{
-			FDlgLogger::Get().Warningf(
-				TEXT("Custom Event is empty (not valid). Ignoring. Context:\n\t%s, Participant = %s"),
-				*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
-			);
+			FDlgLogger::Get().WarningLazy([&]()
+			{
+				return FString::Printf(
+					TEXT("Custom Event is empty (not valid). Ignoring. Context:\n\t%s, Participant = %s"),
+					*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
+				);
+			});
 			return;
 		}
 
@@ -151,17 +151,23 @@ bool FDlgEvent::ValidateIsParticipantValid(const UDlgContext& Context, const FSt
 
 	if (MustHaveParticipant())
 	{
-		FDlgLogger::Get().Errorf(
-			TEXT("%s - Event FAILED because the PARTICIPANT is INVALID. \nContext:\n\t%s, \n\tParticipantName = %s, EventType = %s, EventName = %s, CustomEvent = %s"),
-			*ContextString, *Context.GetContextString(), *ParticipantName.ToString(), *EventTypeToString(EventType), *EventName.ToString(), *GetCustomEventName()
-		);
+		FDlgLogger::Get().ErrorLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("%s::Call - Event FAILED because the PARTICIPANT is INVALID. \nContext:\n\t%s, \n\tParticipantName = %s, EventType = %s, EventName = %s, CustomEvent = %s"),
+				*ContextString, *Context.GetContextString(), *ParticipantName.ToString(), *EventTypeToString(EventType), *EventName.ToString(), *GetCustomEventName()
+			);
+		});
 	}
 	else
 	{
-		FDlgLogger::Get().Warningf(
-			TEXT("%s - Event WARNING because the PARTICIPANT is INVALID. The call will NOT FAIL, but the participant is not present. \nContext:\n\t%s, \n\tParticipantName = %s, EventType = %s, EventName = %s, CustomEvent = %s"),
-			*ContextString, *Context.GetContextString(), *ParticipantName.ToString(), *EventTypeToString(EventType), *EventName.ToString(), *GetCustomEventName()
-		);
+		FDlgLogger::Get().WarningLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("%s::Call - Event WARNING because the PARTICIPANT is INVALID. The call will NOT FAIL, but the participant is not present. \nContext:\n\t%s, \n\tParticipantName = %s, EventType = %s, EventName = %s, CustomEvent = %s"),
+				*ContextString, *Context.GetContextString(), *ParticipantName.ToString(), *EventTypeToString(EventType), *EventName.ToString(), *GetCustomEventName()
+			);
+		});
 	}
 
 	return false;
@@ -181,15 +187,19 @@ void FDlgEvent::CallUnrealFunction(UDlgContext& Context, const FString& ContextS
 		return;
 	}
 
-	if (UFunction* Function = Participant->FindFunction(EventName))
+	const FNYFunctionBinding Binding = FNYReflectionHelper::FindFunctionCached(Participant->GetClass(), EventName);
+	if (Binding.IsValid())
 	{
-		Participant->ProcessEvent(Function, nullptr);
+		FNYReflectionHelper::CallFunction(Participant, Binding);
 	}
 	else
 	{
-		FDlgLogger::Get().Warningf(
-			TEXT("Unreal Function %s Not Found. Ignoring. Context:\n\t%s, Participant = %s"),
-			*EventName.ToString(), *Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
-		);
+		FDlgLogger::Get().WarningLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("Unreal Function %s Not Found. Ignoring. Context:\n\t%s, Participant = %s"),
+				*EventName.ToString(), *Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
+			);
+		});
 	}
 }
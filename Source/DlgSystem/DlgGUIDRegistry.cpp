@@ -0,0 +1,152 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgGUIDRegistry.h"
+
+#include "DlgDialogue.h"
+
+void FDlgGUIDRegistry::Register(const UDlgDialogue& Dialogue)
+{
+	if (!Dialogue.HasGUID())
+	{
+		Unregister(&Dialogue);
+		return;
+	}
+
+	const FGuid NewGUID = Dialogue.GetGUID();
+	FGuid& RegisteredGUID = DialoguesGUIDs.FindOrAdd(FObjectKey(&Dialogue));
+	if (RegisteredGUID == NewGUID)
+	{
+		return;
+	}
+
+	if (RegisteredGUID.IsValid())
+	{
+		RemoveFromGUID(RegisteredGUID, &Dialogue);
+	}
+	RegisteredGUID = NewGUID;
+
+	auto& Dialogues = GUIDsDialogues.FindOrAdd(NewGUID);
+	Dialogues.Add(const_cast<UDlgDialogue*>(&Dialogue));
+	if (Dialogues.Num() == 2)
+	{
+		NumDuplicateGUIDs++;
+	}
+}
+
+void FDlgGUIDRegistry::Unregister(const UDlgDialogue* Dialogue)
+{
+	FGuid RegisteredGUID;
+	if (DialoguesGUIDs.RemoveAndCopyValue(FObjectKey(Dialogue), RegisteredGUID) && RegisteredGUID.IsValid())
+	{
+		RemoveFromGUID(RegisteredGUID, Dialogue);
+	}
+}
+
+bool FDlgGUIDRegistry::IsGUIDTaken(const FGuid& GUID, const UDlgDialogue* IgnoreDialogue) const
+{
+	const auto* Dialogues = GUIDsDialogues.Find(GUID);
+	if (Dialogues == nullptr)
+	{
+		return false;
+	}
+
+	for (const TWeakObjectPtr<UDlgDialogue>& Dialogue : *Dialogues)
+	{
+		if (Dialogue.Get() != IgnoreDialogue && Dialogue.IsValid())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+UDlgDialogue* FDlgGUIDRegistry::FindDialogue(const FGuid& GUID) const
+{
+	if (const auto* Dialogues = GUIDsDialogues.Find(GUID))
+	{
+		for (const TWeakObjectPtr<UDlgDialogue>& Dialogue : *Dialogues)
+		{
+			if (UDlgDialogue* ValidDialogue = Dialogue.Get())
+			{
+				return ValidDialogue;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+TArray<UDlgDialogue*> FDlgGUIDRegistry::GetDialoguesWithDuplicateGUIDs() const
+{
+	TArray<UDlgDialogue*> DuplicateDialogues;
+	if (NumDuplicateGUIDs == 0)
+	{
+		return DuplicateDialogues;
+	}
+
+	for (const auto& Pair : GUIDsDialogues)
+	{
+		bool bFoundFirst = false;
+		for (const TWeakObjectPtr<UDlgDialogue>& Dialogue : Pair.Value)
+		{
+			if (UDlgDialogue* ValidDialogue = Dialogue.Get())
+			{
+				if (bFoundFirst)
+				{
+					DuplicateDialogues.Add(ValidDialogue);
+				}
+				bFoundFirst = true;
+			}
+		}
+	}
+
+	return DuplicateDialogues;
+}
+
+TMap<FGuid, UDlgDialogue*> FDlgGUIDRegistry::GetDialoguesMap() const
+{
+	TMap<FGuid, UDlgDialogue*> DialoguesMap;
+	DialoguesMap.Reserve(GUIDsDialogues.Num());
+	for (const auto& Pair : GUIDsDialogues)
+	{
+		if (UDlgDialogue* Dialogue = FindDialogue(Pair.Key))
+		{
+			DialoguesMap.Add(Pair.Key, Dialogue);
+		}
+	}
+
+	return DialoguesMap;
+}
+
+void FDlgGUIDRegistry::Empty()
+{
+	DialoguesGUIDs.Empty();
+	GUIDsDialogues.Empty();
+	NumDuplicateGUIDs = 0;
+}
+
+void FDlgGUIDRegistry::RemoveFromGUID(const FGuid& GUID, const UDlgDialogue* Dialogue)
+{
+	auto* Dialogues = GUIDsDialogues.Find(GUID);
+	if (Dialogues == nullptr)
+	{
+		return;
+	}
+
+	// Compare the index and serial number, the weak pointer is no longer valid if the Dialogue is being destroyed
+	const TWeakObjectPtr<UDlgDialogue> DialoguePtr(const_cast<UDlgDialogue*>(Dialogue));
+	const int32 NumBefore = Dialogues->Num();
+	Dialogues->RemoveAll([&DialoguePtr](const TWeakObjectPtr<UDlgDialogue>& Other)
+	{
+		return Other.HasSameIndexAndSerialNumber(DialoguePtr);
+	});
+
+	if (NumBefore >= 2 && Dialogues->Num() < 2)
+	{
+		NumDuplicateGUIDs--;
+	}
+	if (Dialogues->Num() == 0)
+	{
+		GUIDsDialogues.Remove(GUID);
+	}
+}
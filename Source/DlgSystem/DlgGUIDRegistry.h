@@ -0,0 +1,65 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UDlgDialogue;
+
+/**
+ * Registry of the GUIDs of all the loaded Dialogues, answers if a GUID is already taken without iterating the Dialogues.
+ * The Dialogues register themselves when their GUID is loaded or changes (PostLoad, RegenerateGUID, text file import)
+ * and are removed when destroyed or deleted, see FDlgSystemModule.
+ * NOTE: only use it on the game thread, just like the Dialogues.
+ */
+class DLGSYSTEM_API FDlgGUIDRegistry
+{
+public:
+	static FDlgGUIDRegistry& Get()
+	{
+		static FDlgGUIDRegistry Instance;
+		return Instance;
+	}
+
+	// Adds the Dialogue with its current GUID, or moves it to its new GUID if it was already registered
+	void Register(const UDlgDialogue& Dialogue);
+
+	// Removes the Dialogue, if it is registered
+	void Unregister(const UDlgDialogue* Dialogue);
+
+	// Is the GUID used by any other Dialogue than IgnoreDialogue?
+	bool IsGUIDTaken(const FGuid& GUID, const UDlgDialogue* IgnoreDialogue = nullptr) const;
+
+	// Gets the first registered Dialogue with the GUID, nullptr if there is none
+	UDlgDialogue* FindDialogue(const FGuid& GUID) const;
+
+	// Does any GUID belong to more than one Dialogue?
+	bool HasDuplicateGUIDs() const { return NumDuplicateGUIDs > 0; }
+
+	// Gets all the Dialogues except the first one registered for each GUID used by more than one Dialogue
+	TArray<UDlgDialogue*> GetDialoguesWithDuplicateGUIDs() const;
+
+	// Key: GUID
+	// Value: the first registered Dialogue with that GUID
+	TMap<FGuid, UDlgDialogue*> GetDialoguesMap() const;
+
+	int32 GetNumDialogues() const { return DialoguesGUIDs.Num(); }
+
+	void Empty();
+
+private:
+	void RemoveFromGUID(const FGuid& GUID, const UDlgDialogue* Dialogue);
+
+private:
+	// Key: Dialogue
+	// Value: the GUID the Dialogue is registered with
+	TMap<FObjectKey, FGuid> DialoguesGUIDs;
+
+	// Key: GUID
+	// Value: the Dialogues with that GUID, in the order they were registered, should only have one Dialogue
+	TMap<FGuid, TArray<TWeakObjectPtr<UDlgDialogue>, TInlineAllocator<1>>> GUIDsDialogues;
+
+	// Number of GUIDs used by more than one Dialogue
+	int32 NumDuplicateGUIDs = 0;
+};
@@ -4,15 +4,28 @@
 #include "UObject/UObjectIterator.h"
 #include "Engine/ObjectLibrary.h"
 #include "Interfaces/IPluginManager.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/AssetData.h"
 #include "Engine/Blueprint.h"
 #include "EngineUtils.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
 
 #include "IDlgSystemModule.h"
 #include "DlgConstants.h"
 #include "DlgDialogueParticipant.h"
 #include "DlgDialogue.h"
 #include "DlgMemory.h"
+#include "DlgNameIndex.h"
+#include "DlgDialogueAssetData.h"
+#include "DlgGUIDRegistry.h"
+#include "DlgParticipantRegistry.h"
+#include "DlgContextPool.h"
+#include "DlgParticipantValueCache.h"
+#include "DlgSystemSettings.h"
 #include "DlgContext.h"
 #include "Logging/DlgLogger.h"
 #include "DlgHelper.h"
@@ -42,13 +55,15 @@ UDlgContext* UDlgManager::StartDialogueWithDefaultParticipants(UObject* WorldCon
 	}
 
 	// Gather all objects that have our participant name
-	for (UObject* Participant : GetObjectsWithDialogueParticipantInterface(WorldContextObject))
+	if (UDlgParticipantRegistry* Registry = UDlgParticipantRegistry::Get(WorldContextObject))
 	{
-		const FName ParticipantName = IDlgDialogueParticipant::Execute_GetParticipantName(Participant);
-		if (ObjectMap.Contains(ParticipantName))
+		for (auto& Pair : ObjectMap)
 		{
-			ObjectMap[ParticipantName].AddUnique(Participant);
-			Participants.AddUnique(Participant);
+			Registry->GetParticipants(Pair.Key, Pair.Value);
+			for (UObject* Participant : Pair.Value)
+			{
+				Participants.AddUnique(Participant);
+			}
 		}
 	}
 
@@ -99,7 +114,12 @@ UDlgContext* UDlgManager::StartDialogueWithDefaultParticipants(UObject* WorldCon
 	return StartDialogueWithContext(TEXT("StartDialogueWithDefaultParticipants"), Dialogue, Participants);
 }
 
-UDlgContext* UDlgManager::StartDialogueWithContext(const FString& ContextString, UDlgDialogue* Dialogue, const TArray<UObject*>& Participants)
+UDlgContext* UDlgManager::StartDialogueWithContext(
+	const FString& ContextString,
+	UDlgDialogue* Dialogue,
+	const TArray<UObject*>& Participants,
+	UObject* HistoryOwner
+)
 {
 	const FString ContextMessage = ContextString.IsEmpty()
 		? FString::Printf(TEXT("StartDialogue"))
@@ -111,15 +131,81 @@ UDlgContext* UDlgManager::StartDialogueWithContext(const FString& ContextString,
 		return nullptr;
 	}
 
-	auto* Context = NewObject<UDlgContext>(Participants[0], UDlgContext::StaticClass());
+	UDlgContext* Context = CreateContext(Participants[0]);
+	if (HistoryOwner)
+	{
+		Context->SetHistoryOwner(HistoryOwner);
+	}
 	if (Context->StartWithContext(ContextMessage, Dialogue, ParticipantBinding))
 	{
 		return Context;
 	}
 
+	// The failed start can leave the Context in the middle of the Dialogue
+	Context->ResetContext();
+	ReleaseDialogueContext(Context);
 	return nullptr;
 }
 
+UDlgContext* UDlgManager::CreateContext(UObject* FirstParticipant)
+{
+	if (GetDefault<UDlgSystemSettings>()->bPoolDialogueContexts && CanPoolContext(FirstParticipant))
+	{
+		if (UDlgContextPool* Pool = UDlgContextPool::Get(FirstParticipant))
+		{
+			return Pool->Acquire();
+		}
+	}
+
+	return NewObject<UDlgContext>(FirstParticipant, UDlgContext::StaticClass());
+}
+
+bool UDlgManager::CanPoolContext(const UObject* FirstParticipant)
+{
+	if (!FirstParticipant)
+	{
+		return true;
+	}
+
+	const UWorld* World = FirstParticipant->GetWorld();
+	const AActor* Actor = Cast<AActor>(FirstParticipant);
+	if (!Actor)
+	{
+		Actor = FirstParticipant->GetTypedOuter<AActor>();
+	}
+
+	const bool bReplicated = (World && World->GetNetMode() != NM_Standalone) || (Actor && Actor->GetIsReplicated());
+	if (!bReplicated)
+	{
+		return true;
+	}
+
+	static bool bWarned = false;
+	if (!bWarned)
+	{
+		bWarned = true;
+		FDlgLogger::Get().Warningf(
+			TEXT("bPoolDialogueContexts is enabled but the contexts of multiplayer Worlds or replicated participants (like `%s`) are not pooled, they have to be outered to the participant to replicate."),
+			*FirstParticipant->GetName()
+		);
+	}
+	return false;
+}
+
+void UDlgManager::ReleaseDialogueContext(UDlgContext* Context)
+{
+	if (!IsValid(Context))
+	{
+		return;
+	}
+
+	// Not pooled, the Garbage Collector takes care of it
+	if (UDlgContextPool* Pool = Cast<UDlgContextPool>(Context->GetOuter()))
+	{
+		Pool->Release(Context);
+	}
+}
+
 bool UDlgManager::CanStartDialogue(UDlgDialogue* Dialogue, UPARAM(ref)const TArray<UObject*>& Participants)
 {
 	TMap<FName, UObject*> ParticipantBinding;
@@ -131,6 +217,69 @@ bool UDlgManager::CanStartDialogue(UDlgDialogue* Dialogue, UPARAM(ref)const TArr
 	return UDlgContext::CanBeStarted(Dialogue, ParticipantBinding);
 }
 
+int32 UDlgManager::CanStartDialogues(
+	TArrayView<const FDlgStartCandidate> Candidates,
+	TBitArray<>& OutCanStart,
+	int32 StartIndex,
+	double TimeBudgetSeconds
+)
+{
+	check(IsInGameThread());
+	if (StartIndex == 0 || OutCanStart.Num() != Candidates.Num())
+	{
+		OutCanStart.Init(false, Candidates.Num());
+	}
+
+	const bool bHasBudget = TimeBudgetSeconds > 0.0;
+	const double EndTime = FPlatformTime::Seconds() + TimeBudgetSeconds;
+
+	FDlgParticipantValueCache ValueCache;
+	TMap<FName, UObject*> ParticipantBinding;
+	for (int32 Index = FMath::Max(StartIndex, 0); Index < Candidates.Num(); Index++)
+	{
+		if (bHasBudget && Index > StartIndex && FPlatformTime::Seconds() >= EndTime)
+		{
+			return Index;
+		}
+
+		const FDlgStartCandidate& Candidate = Candidates[Index];
+		const bool bCanStart = UDlgContext::ConvertArrayOfParticipantsToMap(
+			TEXT("CanStartDialogues"), Candidate.Dialogue, Candidate.Participants, ParticipantBinding, false, &ValueCache
+		)
+			&& UDlgContext::CanBeStarted(Candidate.Dialogue, ParticipantBinding, nullptr, &ValueCache);
+		OutCanStart[Index] = bCanStart;
+	}
+
+	return Candidates.Num();
+}
+
+int32 UDlgManager::CanStartDialoguesArray(
+	const TArray<FDlgStartCandidate>& Candidates,
+	TArray<bool>& OutCanStart,
+	int32 StartIndex,
+	float TimeBudgetSeconds
+)
+{
+	// Keep the results of the previous calls when resuming
+	TBitArray<> CanStartBits(false, Candidates.Num());
+	if (StartIndex > 0 && OutCanStart.Num() == Candidates.Num())
+	{
+		for (int32 Index = 0; Index < FMath::Min(StartIndex, Candidates.Num()); Index++)
+		{
+			CanStartBits[Index] = OutCanStart[Index];
+		}
+	}
+
+	const int32 NextIndex = CanStartDialogues(Candidates, CanStartBits, StartIndex, TimeBudgetSeconds);
+	OutCanStart.SetNumUninitialized(Candidates.Num());
+	for (int32 Index = 0; Index < Candidates.Num(); Index++)
+	{
+		OutCanStart[Index] = CanStartBits[Index];
+	}
+
+	return NextIndex;
+}
+
 UDlgContext* UDlgManager::ResumeDialogueFromNodeIndex(
 	UDlgDialogue* Dialogue,
 	UPARAM(ref)const TArray<UObject*>& Participants,
@@ -146,14 +295,17 @@ UDlgContext* UDlgManager::ResumeDialogueFromNodeIndex(
 		return nullptr;
 	}
 
-	auto* Context = NewObject<UDlgContext>(Participants[0], UDlgContext::StaticClass());
+	UDlgContext* Context = CreateContext(Participants[0]);
 	FDlgHistory History;
-	History.VisitedNodeIndices = AlreadyVisitedNodes;
+	History.SetVisitedNodeIndices(AlreadyVisitedNodes);
 	if (Context->StartWithContextFromNodeIndex(ContextMessage, Dialogue, ParticipantBinding, StartNodeIndex, History, bFireEnterEvents))
 	{
 		return Context;
 	}
 
+	// The failed start can leave the Context in the middle of the Dialogue
+	Context->ResetContext();
+	ReleaseDialogueContext(Context);
 	return nullptr;
 }
 
@@ -172,14 +324,17 @@ UDlgContext* UDlgManager::ResumeDialogueFromNodeGUID(
 		return nullptr;
 	}
 
-	auto* Context = NewObject<UDlgContext>(Participants[0], UDlgContext::StaticClass());
+	UDlgContext* Context = CreateContext(Participants[0]);
 	FDlgHistory History;
-	History.VisitedNodeGUIDs = AlreadyVisitedNodes;
+	History.SetVisitedNodeGUIDs(AlreadyVisitedNodes);
 	if (Context->StartWithContextFromNodeGUID(ContextMessage, Dialogue, ParticipantBinding, StartNodeGUID, History, bFireEnterEvents))
 	{
 		return Context;
 	}
 
+	// The failed start can leave the Context in the middle of the Dialogue
+	Context->ResetContext();
+	ReleaseDialogueContext(Context);
 	return nullptr;
 }
 
@@ -222,11 +377,23 @@ int32 UDlgManager::LoadAllDialoguesIntoMemory(bool bAsync)
 {
 	bCalledLoadAllDialoguesIntoMemory = true;
 
+	UObjectLibrary* ObjectLibrary = UObjectLibrary::CreateLibrary(UDlgDialogue::StaticClass(), false, GIsEditor);
+	const TArray<FString> PathsToSearch = GetDialoguesSearchPaths();
+	ObjectLibrary->AddToRoot();
+
+	const bool bForceSynchronousScan = !bAsync;
+	const int32 Count = ObjectLibrary->LoadAssetDataFromPaths(PathsToSearch, bForceSynchronousScan);
+	ObjectLibrary->LoadAssetsFromAssetData();
+	ObjectLibrary->RemoveFromRoot();
+
+	return Count;
+}
+
+TArray<FString> UDlgManager::GetDialoguesSearchPaths()
+{
 	// NOTE: All paths must NOT have the forward slash "/" at the end.
 	// If they do, then this won't load Dialogues that are located in the Content root directory
-	UObjectLibrary* ObjectLibrary = UObjectLibrary::CreateLibrary(UDlgDialogue::StaticClass(), false, GIsEditor);
 	TArray<FString> PathsToSearch = { TEXT("/Game") };
-	ObjectLibrary->AddToRoot();
 
 	// Add the current plugin dir
 	// TODO maybe add all the non engine plugin paths? IPluginManager::Get().GetEnabledPlugins()
@@ -239,15 +406,162 @@ int32 UDlgManager::LoadAllDialoguesIntoMemory(bool bAsync)
 		PathsToSearch.Add(PluginPath);
 	}
 
-	const bool bForceSynchronousScan = !bAsync;
-	const int32 Count = ObjectLibrary->LoadAssetDataFromPaths(PathsToSearch, bForceSynchronousScan);
-	ObjectLibrary->LoadAssetsFromAssetData();
-	ObjectLibrary->RemoveFromRoot();
+	return PathsToSearch;
+}
 
-	return Count;
+void UDlgManager::GetAllDialogueAssets(TArray<FAssetData>& OutAssets)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(NAME_MODULE_AssetRegistry).Get();
+	const TArray<FString> PathsToSearch = GetDialoguesSearchPaths();
+
+#if WITH_EDITOR
+	// The editor discovers the assets in the background, the cooked game has the whole registry from the start
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		AssetRegistry.ScanPathsSynchronous(PathsToSearch);
+	}
+#endif
+
+	FARFilter Filter;
+#if NY_ENGINE_VERSION >= 501
+	Filter.ClassPaths.Add(UDlgDialogue::StaticClass()->GetClassPathName());
+#else
+	Filter.ClassNames.Add(UDlgDialogue::StaticClass()->GetFName());
+#endif
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (const FString& Path : PathsToSearch)
+	{
+		Filter.PackagePaths.Add(FName(*Path));
+	}
+
+	AssetRegistry.GetAssets(Filter, OutAssets);
 }
 
-TArray<UDlgDialogue*> UDlgManager::GetAllDialoguesFromMemory()
+void UDlgManager::WarnAboutDialoguesWithoutAssetData(int32 Num)
+{
+	static bool bWarned = false;
+	if (Num > 0 && !bWarned)
+	{
+		bWarned = true;
+		FDlgLogger::Get().Warningf(
+			TEXT("%d Dialogues do not have the AssetRegistry tags (saved with an older version of the plugin), the AssetRegistry queries only find them while they are loaded. Resave them to fix this."),
+			Num
+		);
+	}
+}
+
+int32 UDlgManager::GetAllDialoguesAssetData(TArray<FDlgDialogueAssetData>& OutDialoguesData)
+{
+	TArray<FAssetData> Assets;
+	GetAllDialogueAssets(Assets);
+
+	int32 NumWithoutAssetData = 0;
+	OutDialoguesData.Reserve(OutDialoguesData.Num() + Assets.Num());
+	for (const FAssetData& AssetData : Assets)
+	{
+		FDlgDialogueAssetData DialogueData;
+		if (FDlgDialogueAssetData::FromAssetData(AssetData, DialogueData))
+		{
+			OutDialoguesData.Add(MoveTemp(DialogueData));
+		}
+		else if (const UDlgDialogue* Dialogue = Cast<UDlgDialogue>(AssetData.IsAssetLoaded() ? AssetData.GetAsset() : nullptr))
+		{
+			OutDialoguesData.Add(FDlgDialogueAssetData::FromDialogue(*Dialogue));
+		}
+		else
+		{
+			NumWithoutAssetData++;
+		}
+	}
+
+	WarnAboutDialoguesWithoutAssetData(NumWithoutAssetData);
+	return Assets.Num() - NumWithoutAssetData;
+}
+
+TArray<TSoftObjectPtr<UDlgDialogue>> UDlgManager::GetAllDialogueAssetsForParticipantName(FName ParticipantName)
+{
+	const FDlgNameIndex& AssetIndex = GetDialogueAssetIndex();
+	WarnAboutDialoguesWithoutAssetData(AssetIndex.GetNumAssetsWithoutMetadata());
+
+	TArray<TSoftObjectPtr<UDlgDialogue>> Dialogues;
+	AssetIndex.GetDialogueAssetsForParticipantName(ParticipantName, Dialogues);
+	return Dialogues;
+}
+
+bool UDlgManager::FindDialogueAssetByGUID(const FGuid& GUID, FSoftObjectPath& OutObjectPath)
+{
+	if (!GUID.IsValid())
+	{
+		return false;
+	}
+
+	// Loaded already
+	if (const UDlgDialogue* Dialogue = FDlgGUIDRegistry::Get().FindDialogue(GUID))
+	{
+		OutObjectPath = FSoftObjectPath(Dialogue);
+		return true;
+	}
+
+	const FDlgNameIndex& AssetIndex = GetDialogueAssetIndex();
+	if (AssetIndex.FindDialogueAssetByGUID(GUID, OutObjectPath))
+	{
+		return true;
+	}
+
+	WarnAboutDialoguesWithoutAssetData(AssetIndex.GetNumAssetsWithoutMetadata());
+	return false;
+}
+
+void UDlgManager::RebuildDialogueAssetIndex()
+{
+	TArray<FAssetData> Assets;
+	GetAllDialogueAssets(Assets);
+	FDlgNameIndex::Get().RebuildAssets(Assets);
+}
+
+bool UDlgManager::IsDialogueAsset(const FAssetData& AssetData)
+{
+	const UClass* AssetClass = AssetData.GetClass();
+	if (!AssetClass || !AssetClass->IsChildOf(UDlgDialogue::StaticClass()))
+	{
+		return false;
+	}
+
+	const FString PackagePath = AssetData.PackagePath.ToString();
+	for (const FString& Path : GetDialoguesSearchPaths())
+	{
+		if (PackagePath == Path || PackagePath.StartsWith(Path + TEXT("/")))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FDlgNameIndex& UDlgManager::GetDialogueAssetIndex()
+{
+	FDlgNameIndex& NameIndex = FDlgNameIndex::Get();
+	if (!NameIndex.AreAssetsBuilt())
+	{
+		RebuildDialogueAssetIndex();
+	}
+	return NameIndex;
+}
+
+UDlgDialogue* UDlgManager::LoadDialogueByGUID(const FGuid& GUID)
+{
+	FSoftObjectPath ObjectPath;
+	if (!FindDialogueAssetByGUID(GUID, ObjectPath))
+	{
+		return nullptr;
+	}
+
+	return Cast<UDlgDialogue>(ObjectPath.TryLoad());
+}
+
+void UDlgManager::LoadAllDialoguesIntoMemoryIfNeeded()
 {
 #if WITH_EDITOR
 	// Hmm, something is wrong
@@ -257,6 +571,11 @@ TArray<UDlgDialogue*> UDlgManager::GetAllDialoguesFromMemory()
 	}
 // 	check(bCalledLoadAllDialoguesIntoMemory);
 #endif
+}
+
+TArray<UDlgDialogue*> UDlgManager::GetAllDialoguesFromMemory()
+{
+	LoadAllDialoguesIntoMemoryIfNeeded();
 
 	TArray<UDlgDialogue*> Array;
 	for (TObjectIterator<UDlgDialogue> Itr; Itr; ++Itr)
@@ -286,109 +605,51 @@ TArray<TWeakObjectPtr<AActor>> UDlgManager::GetAllWeakActorsWithDialogueParticip
 
 TArray<UObject*> UDlgManager::GetObjectsWithDialogueParticipantInterface(UObject* WorldContextObject)
 {
-	TArray<UObject*> Array;
-	if (!WorldContextObject)
-		return Array;
-
-	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	// The registry scans the World once and it is updated when actors are spawned and levels are streamed in
+	if (UDlgParticipantRegistry* Registry = UDlgParticipantRegistry::Get(WorldContextObject))
 	{
-		// TObjectIterator has some weird ghost objects in editor, I failed to find a way to validate them
-		// Instead of this ActorIterate is used and the properties inside the actors are examined in a recursive way
-		// Containers are not supported yet
-		TSet<UObject*> VisitedSet;
-		for (TActorIterator<AActor> Itr(World); Itr; ++Itr)
-		{
-			GatherParticipantsRecursive(*Itr, Array, VisitedSet);
-		}
+		return Registry->GetAllParticipants();
 	}
 
-	// TArray<UObject*> Array2;
-	// for (TObjectIterator<UObject> Itr; Itr; ++Itr)
-	// {
-	// 	UObject* Object = *Itr;
-	// 	if (IsValid(Object)
-	// 		&& !Object->IsPendingKill()
-	// 		&& Object->GetClass()->ImplementsInterface(UDlgDialogueParticipant::StaticClass()))
-	// 		//&& IDlgDialogueParticipant::Execute_GetParticipantName(Object) != NAME_None)
-	// 	{
-	// 		if (Object->HasAllFlags(RF_Transient | RF_Transactional) || !Object->HasAnyFlags(RF_Transient) )
-	// 		{
-	// 			Array2.AddUnique(Object);
-	// 		}
-	// 	}
-	// }
-
-	return Array;
+	return {};
 }
 
 TMap<FName, FDlgObjectsArray> UDlgManager::GetObjectsMapWithDialogueParticipantInterface(UObject* WorldContextObject)
 {
 	// Maps from Participant Name => Objects that have that participant name
-	TMap<FName, FDlgObjectsArray> ObjectsMap;
-	for (UObject* Participant : GetObjectsWithDialogueParticipantInterface(WorldContextObject))
+	if (UDlgParticipantRegistry* Registry = UDlgParticipantRegistry::Get(WorldContextObject))
 	{
-		const FName ParticipantName = IDlgDialogueParticipant::Execute_GetParticipantName(Participant);
-		if (ObjectsMap.Contains(ParticipantName))
-		{
-			// Update
-			ObjectsMap[ParticipantName].Array.Add(Participant);
-		}
-		else
-		{
-			// Create
-			FDlgObjectsArray ArrayStruct;
-			ArrayStruct.Array.Add(Participant);
-			ObjectsMap.Add(ParticipantName, ArrayStruct);
-		}
+		return Registry->GetParticipantsMap();
 	}
 
-	return ObjectsMap;
+	return {};
 }
 
 TArray<UDlgDialogue*> UDlgManager::GetDialoguesWithDuplicateGUIDs()
 {
-	TArray<UDlgDialogue*> Dialogues = GetAllDialoguesFromMemory();
-	TArray<UDlgDialogue*> DuplicateDialogues;
-
-	TSet<FGuid> DialogueGUIDs;
-	for (UDlgDialogue* Dialogue : Dialogues)
-	{
-		const FGuid ID = Dialogue->GetGUID();
-		if (DialogueGUIDs.Find(ID) == nullptr)
-		{
-			// does not exist, good
-			DialogueGUIDs.Add(ID);
-		}
-		else
-		{
-			// how?
-			DuplicateDialogues.Add(Dialogue);
-		}
-	}
-
-	return DuplicateDialogues;
+	LoadAllDialoguesIntoMemoryIfNeeded();
+	return FDlgGUIDRegistry::Get().GetDialoguesWithDuplicateGUIDs();
 }
 
 TMap<FGuid, UDlgDialogue*> UDlgManager::GetAllDialoguesGUIDsMap()
 {
-	TArray<UDlgDialogue*> Dialogues = GetAllDialoguesFromMemory();
-	TMap<FGuid, UDlgDialogue*> DialoguesMap;
-
-	for (UDlgDialogue* Dialogue : Dialogues)
+	LoadAllDialoguesIntoMemoryIfNeeded();
+	const FDlgGUIDRegistry& GUIDRegistry = FDlgGUIDRegistry::Get();
+	for (const UDlgDialogue* Dialogue : GUIDRegistry.GetDialoguesWithDuplicateGUIDs())
 	{
-		const FGuid ID = Dialogue->GetGUID();
-		if (DialoguesMap.Contains(ID))
-		{
-			FDlgLogger::Get().Errorf(
-				TEXT("GetAllDialoguesGUIDsMap - ID = `%s` for Dialogue = `%s` already exists"),
-				*ID.ToString(), *Dialogue->GetPathName()
-			);
-		}
-
-		DialoguesMap.Add(ID, Dialogue);
+		FDlgLogger::Get().Errorf(
+			TEXT("GetAllDialoguesGUIDsMap - ID = `%s` for Dialogue = `%s` already exists"),
+			*Dialogue->GetGUID().ToString(), *Dialogue->GetPathName()
+		);
 	}
 
-	return DialoguesMap;
+	return GUIDRegistry.GetDialoguesMap();
+}
+
+bool UDlgManager::IsDialogueGUIDTaken(const FGuid& GUID, const UDlgDialogue* IgnoreDialogue)
+{
+	LoadAllDialoguesIntoMemoryIfNeeded();
+	return FDlgGUIDRegistry::Get().IsGUIDTaken(GUID, IgnoreDialogue);
 }
 
 const TMap<FGuid, FDlgHistory>& UDlgManager::GetDialogueHistory()
@@ -406,6 +667,62 @@ void UDlgManager::ClearDialogueHistory()
 	FDlgMemory::Get().Empty();
 }
 
+void UDlgManager::SetDialogueHistoryForOwner(UObject* HistoryOwner, const TMap<FGuid, FDlgHistory>& DlgHistory)
+{
+	FDlgMemory::Get().FindOrAddStore(HistoryOwner)->SetHistoryMap(DlgHistory);
+}
+
+void UDlgManager::ClearDialogueHistoryForOwner(UObject* HistoryOwner)
+{
+	if (HistoryOwner)
+	{
+		FDlgMemory::Get().RemoveStore(HistoryOwner);
+		FDlgMemory::Get().RemoveStoresWithInvalidOwners();
+	}
+	else
+	{
+		FDlgMemory::Get().GetGlobalStore()->Empty();
+	}
+}
+
+const TMap<FGuid, FDlgHistory>& UDlgManager::GetDialogueHistoryForOwner(UObject* HistoryOwner)
+{
+	if (const TSharedPtr<FDlgHistoryStore> Store = FDlgMemory::Get().FindStore(HistoryOwner))
+	{
+		return Store->GetHistoryMaps();
+	}
+
+	static const TMap<FGuid, FDlgHistory> EmptyHistory;
+	return EmptyHistory;
+}
+
+TArray<uint8> UDlgManager::SaveDialogueHistoryToBytes(UObject* HistoryOwner)
+{
+	// An owner without a store is saved as an empty history
+	const TSharedPtr<FDlgHistoryStore> Store = FDlgMemory::Get().FindStore(HistoryOwner);
+	FDlgHistoryStore EmptyStore;
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	(Store.IsValid() ? *Store : EmptyStore).SerializeCompact(Writer);
+	return Bytes;
+}
+
+bool UDlgManager::LoadDialogueHistoryFromBytes(UObject* HistoryOwner, const TArray<uint8>& Bytes)
+{
+	FDlgHistoryStore LoadedStore;
+	FMemoryReader Reader(Bytes);
+	LoadedStore.SerializeCompact(Reader);
+	if (Reader.IsError())
+	{
+		FDlgLogger::Get().Errorf(TEXT("LoadDialogueHistoryFromBytes - Failed to load the Dialogue history from %d bytes"), Bytes.Num());
+		return false;
+	}
+
+	FDlgMemory::Get().FindOrAddStore(HistoryOwner)->SetHistoryMap(LoadedStore.GetHistoryMaps());
+	return true;
+}
+
 bool UDlgManager::DoesObjectImplementDialogueParticipantInterface(const UObject* Object)
 {
 	return FDlgHelper::IsObjectImplementingInterface(Object, UDlgDialogueParticipant::StaticClass());
@@ -434,119 +751,55 @@ bool UDlgManager::IsObjectANodeData(const UObject* Object)
 TArray<UDlgDialogue*> UDlgManager::GetAllDialoguesForParticipantName(FName ParticipantName)
 {
 	TArray<UDlgDialogue*> DialoguesArray;
-	for (UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		if (Dialogue->HasParticipant(ParticipantName))
-		{
-			DialoguesArray.Add(Dialogue);
-		}
-	}
-
+	GetNameIndex().GetDialoguesForParticipantName(ParticipantName, DialoguesArray);
 	return DialoguesArray;
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantNames()
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantNames());
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return GetNameIndex().GetParticipantNames();
 }
 
 TArray<FName> UDlgManager::GetDialoguesSpeakerStates()
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetSpeakerStates());
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return GetNameIndex().GetSpeakerStates();
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantIntNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantIntNames(ParticipantName));
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return GetNameIndex().GetParticipantNames(EDlgNameIndexType::Int, ParticipantName);
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantFloatNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantFloatNames(ParticipantName));
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return GetNameIndex().GetParticipantNames(EDlgNameIndexType::Float, ParticipantName);
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantBoolNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantBoolNames(ParticipantName));
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return GetNameIndex().GetParticipantNames(EDlgNameIndexType::Bool, ParticipantName);
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantFNameNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantFNameNames(ParticipantName));
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return GetNameIndex().GetParticipantNames(EDlgNameIndexType::FName, ParticipantName);
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantConditionNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantConditionNames(ParticipantName));
-	}
-
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+	return GetNameIndex().GetParticipantNames(EDlgNameIndexType::Condition, ParticipantName);
 }
 
 TArray<FName> UDlgManager::GetDialoguesParticipantEventNames(FName ParticipantName)
 {
-	TSet<FName> UniqueNames;
-	for (const UDlgDialogue* Dialogue : GetAllDialoguesFromMemory())
-	{
-		UniqueNames.Append(Dialogue->GetParticipantEventNames(ParticipantName));
-	}
+	return GetNameIndex().GetParticipantNames(EDlgNameIndexType::Event, ParticipantName);
+}
 
-	TArray<FName> Array;
-	FDlgHelper::AppendSortedSetToArray(UniqueNames, Array);
-	return Array;
+FDlgNameIndex& UDlgManager::GetNameIndex()
+{
+	// The index only knows about the loaded Dialogues
+	LoadAllDialoguesIntoMemoryIfNeeded();
+	return FDlgNameIndex::Get();
 }
 
 bool UDlgManager::RegisterDialogueConsoleCommands()
@@ -1,6 +1,7 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #pragma once
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "UObject/SoftObjectPtr.h"
 
 #include "DlgDialogue.h"
 #include "DlgDialogueParticipant.h"
@@ -11,6 +12,9 @@
 class AActor;
 class UDlgContext;
 class UDlgDialogue;
+class FDlgNameIndex;
+struct FDlgDialogueAssetData;
+struct FAssetData;
 
 
 USTRUCT(BlueprintType)
@@ -23,6 +27,20 @@ public:
 	TArray<UObject*> Array;
 };
 
+// Dialogue and participants pair checked by UDlgManager::CanStartDialogues
+USTRUCT(BlueprintType)
+struct DLGSYSTEM_API FDlgStartCandidate
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data")
+	UDlgDialogue* Dialogue = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data")
+	TArray<UObject*> Participants;
+};
+
 /**
  *  Class providing a collection of static functions to start a conversation and work with Dialogues.
  */
@@ -48,7 +66,13 @@ public:
 	static UDlgContext* StartDialogueWithDefaultParticipants(UObject* WorldContextObject, UDlgDialogue* Dialogue);
 
 	// Supplies where we called this from
-	static UDlgContext* StartDialogueWithContext(const FString& ContextString, UDlgDialogue* Dialogue, const TArray<UObject*>& Participants);
+	// HistoryOwner: the owner of the history the context uses (see UDlgContext::SetHistoryOwner), nullptr for the default one
+	static UDlgContext* StartDialogueWithContext(
+		const FString& ContextString,
+		UDlgDialogue* Dialogue,
+		const TArray<UObject*>& Participants,
+		UObject* HistoryOwner = nullptr
+	);
 
 	/**
 	 * Starts a Dialogue with the provided Dialogue and Participants array
@@ -65,6 +89,14 @@ public:
 		return StartDialogueWithContext(TEXT("StartDialogue"), Dialogue, Participants);
 	}
 
+	// Same as StartDialogue but the Dialogue uses the history of the HistoryOwner (a World, a PlayerState, any object).
+	// See SetDialogueHistoryForOwner.
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Launch")
+	static UDlgContext* StartDialogueWithHistoryOwner(UDlgDialogue* Dialogue, UPARAM(ref)const TArray<UObject*>& Participants, UObject* HistoryOwner)
+	{
+		return StartDialogueWithContext(TEXT("StartDialogueWithHistoryOwner"), Dialogue, Participants, HistoryOwner);
+	}
+
 	/**
 	 * Checks if there is any child of the start node which can be enterred based on the conditions
 	 *
@@ -73,6 +105,53 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Dialogue|Launch")
 	static bool CanStartDialogue(UDlgDialogue* Dialogue, UPARAM(ref)const TArray<UObject*>& Participants);
 
+	/**
+	 * Same as calling CanStartDialogue for each of the Candidates, but the participant names and the values the conditions
+	 * read from the participants (getters and class variables) are only read once for the whole batch.
+	 * Event calls and custom conditions are still evaluated for each candidate.
+	 *
+	 * Can be spread over multiple frames: evaluate from StartIndex until TimeBudgetSeconds runs out (at least one candidate
+	 * is evaluated), then call it again in the next frame with the returned index.
+	 * NOTE: the participant values are only shared inside one call.
+	 *
+	 * @param OutCanStart			bit for each candidate, set if it can be started. Initialized when StartIndex is 0 or the size does not match
+	 * @param StartIndex			index of the first candidate to evaluate
+	 * @param TimeBudgetSeconds		stop evaluating after this much time, 0 or less means no budget
+	 * @returns the index of the first candidate that was not evaluated, Candidates.Num() if all of them were evaluated
+	 */
+	static int32 CanStartDialogues(
+		TArrayView<const FDlgStartCandidate> Candidates,
+		TBitArray<>& OutCanStart,
+		int32 StartIndex = 0,
+		double TimeBudgetSeconds = 0.0
+	);
+
+	/**
+	 * Blueprint version of CanStartDialogues, see that for the details.
+	 *
+	 * @param OutCanStart			for each candidate if it can be started. Initialized when StartIndex is 0 or the size does not match
+	 * @param StartIndex			index of the first candidate to evaluate
+	 * @param TimeBudgetSeconds		stop evaluating after this much time, 0 or less means no budget
+	 * @returns the index of the first candidate that was not evaluated, Candidates.Num() if all of them were evaluated
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Launch", DisplayName = "Can Start Dialogues")
+	static int32 CanStartDialoguesArray(
+		const TArray<FDlgStartCandidate>& Candidates,
+		UPARAM(ref) TArray<bool>& OutCanStart,
+		int32 StartIndex = 0,
+		float TimeBudgetSeconds = 0.f
+	);
+
+	/**
+	 * Puts the Context back into the pool of its world so that it is reused by the next started Dialogue.
+	 * Only does something if the Context was created from a pool (UDlgSystemSettings::bPoolDialogueContexts),
+	 * do not use the Context after this. The Context must not be in the middle of a Dialogue (see UDlgContext::IsDialogueActive),
+	 * the active contexts are not put back into the pool.
+	 * NOTE: the pooled contexts are outered to the UDlgContextPool of the World and not to the first participant.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Launch")
+	static void ReleaseDialogueContext(UDlgContext* Context);
+
 	/**
 	 * Starts a Dialogue with the provided Dialogue and Participants array, at the given entry point
 	 *
@@ -163,10 +242,37 @@ public:
 	// Gets all loaded dialogues from memory. LoadAllDialoguesIntoMemory must be called before this
 	static TArray<UDlgDialogue*> GetAllDialoguesFromMemory();
 
+	/**
+	 * Gets the metadata of all the Dialogues from the AssetRegistry tags (see FDlgDialogueAssetData) without loading them.
+	 * Dialogues saved before the tags existed are only included if they are loaded, resave them to fix this.
+	 * @return number of Dialogues found
+	 */
+	static int32 GetAllDialoguesAssetData(TArray<FDlgDialogueAssetData>& OutDialoguesData);
+
+	// Same as GetAllDialoguesForParticipantName but also finds the Dialogues that are not loaded, from the AssetRegistry tags
+	// Served by the asset index of FDlgNameIndex, does not iterate over all the Dialogues.
+	// The loaded Dialogues without tags are included, the unloaded ones are not, resave them to fix this.
+	static TArray<TSoftObjectPtr<UDlgDialogue>> GetAllDialogueAssetsForParticipantName(FName ParticipantName);
+
+	// Finds the Dialogue asset with the GUID from the AssetRegistry tags, without loading it
+	// Served by the asset index of FDlgNameIndex, does not iterate over all the Dialogues.
+	static bool FindDialogueAssetByGUID(const FGuid& GUID, FSoftObjectPath& OutObjectPath);
+
+	// Rebuilds the asset index of FDlgNameIndex from the AssetRegistry. Called once the AssetRegistry finished loading the files,
+	// after that the index is kept up to date from the AssetRegistry events by FDlgSystemModule
+	static void RebuildDialogueAssetIndex();
+
+	// Is the asset a Dialogue inside GetDialoguesSearchPaths?
+	static bool IsDialogueAsset(const FAssetData& AssetData);
+
+	// Same as FindDialogueAssetByGUID but loads the Dialogue if it is not loaded already. Returns nullptr if not found
+	static UDlgDialogue* LoadDialogueByGUID(const FGuid& GUID);
+
 	// Gets all the objects from the provided World that implement the Dialogue Participant Interface. Iterates through all objects, DO NOT CALL EACH FRAME
 	static TArray<TWeakObjectPtr<AActor>> GetAllWeakActorsWithDialogueParticipantInterface(UWorld* World);
 
 	// Gets all objects from the World that implement the Dialogue Participant Interface
+	// Served by the UDlgParticipantRegistry of the World, which only scans the World the first time
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Helper", meta = (WorldContext = "WorldContextObject"))
 	static TArray<UObject*> GetObjectsWithDialogueParticipantInterface(UObject* WorldContextObject);
 
@@ -182,14 +288,18 @@ public:
 	// Helper methods that gets all the dialogues in a map by guid.
 	static TMap<FGuid, UDlgDialogue*> GetAllDialoguesGUIDsMap();
 
+	// Is the GUID used by any loaded Dialogue other than IgnoreDialogue? See FDlgGUIDRegistry
+	static bool IsDialogueGUIDTaken(const FGuid& GUID, const UDlgDialogue* IgnoreDialogue = nullptr);
+
 	// Gets all the loaded dialogues from memory that have the ParticipantName included inside them.
+	// Uses the FDlgNameIndex, does not iterate over all the Dialogues.
 	static TArray<UDlgDialogue*> GetAllDialoguesForParticipantName(FName ParticipantName);
 
 	// Sets the FDlgMemory Dialogue history.
 	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
 	static void SetDialogueHistory(const TMap<FGuid, FDlgHistory>& DlgHistory);
 
-	// Empties the FDlgMemory Dialogue history.
+	// Empties the FDlgMemory Dialogue history (the global one and the ones of all the owners).
 	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
 	static void ClearDialogueHistory();
 
@@ -197,6 +307,53 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Memory")
 	static const TMap<FGuid, FDlgHistory>& GetDialogueHistory();
 
+	// Sets the Dialogue history of the HistoryOwner (e.g. a PlayerState), used by the contexts started with this owner
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
+	static void SetDialogueHistoryForOwner(UObject* HistoryOwner, const TMap<FGuid, FDlgHistory>& DlgHistory);
+
+	// Removes the Dialogue history of the HistoryOwner
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
+	static void ClearDialogueHistoryForOwner(UObject* HistoryOwner);
+
+	// Gets the Dialogue history of the HistoryOwner, empty if the owner does not have any history
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Memory")
+	static const TMap<FGuid, FDlgHistory>& GetDialogueHistoryForOwner(UObject* HistoryOwner);
+
+	// Saves the Dialogue history of the HistoryOwner (nullptr means the global one) in a compact binary format.
+	// Store the bytes in your save game instead of the history map to keep the save files small.
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
+	static TArray<uint8> SaveDialogueHistoryToBytes(UObject* HistoryOwner);
+
+	// Loads the Dialogue history of the HistoryOwner (nullptr means the global one) saved with SaveDialogueHistoryToBytes.
+	// Returns false if the bytes are not valid, in which case the history is not modified.
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
+	static bool LoadDialogueHistoryFromBytes(UObject* HistoryOwner, const TArray<uint8>& Bytes);
+
+	// Gets the already visited Node indices of the History
+	// NOTE: if you serialize this but then later change the dialogue node positions this will have the wrong indices
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Memory")
+	static TSet<int32> GetHistoryVisitedNodeIndices(const FDlgHistory& History) { return History.GetVisitedNodeIndices(); }
+
+	// Gets the already visited Node GUIDs of the History
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Memory")
+	static TSet<FGuid> GetHistoryVisitedNodeGUIDs(const FDlgHistory& History) { return TSet<FGuid>(History.GetVisitedNodeGUIDs()); }
+
+	// Replaces the already visited Node indices of the History
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
+	static void SetHistoryVisitedNodeIndices(UPARAM(ref) FDlgHistory& History, const TSet<int32>& NodeIndices) { History.SetVisitedNodeIndices(NodeIndices); }
+
+	// Replaces the already visited Node GUIDs of the History
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
+	static void SetHistoryVisitedNodeGUIDs(UPARAM(ref) FDlgHistory& History, const TSet<FGuid>& NodeGUIDs) { History.SetVisitedNodeGUIDs(NodeGUIDs); }
+
+	// Marks the Node as visited in the History, the NodeGUID can be invalid
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
+	static void AddHistoryVisitedNode(UPARAM(ref) FDlgHistory& History, int32 NodeIndex, FGuid NodeGUID) { History.Add(NodeIndex, NodeGUID); }
+
+	// Was the Node visited in the History? Uses the NodeGUID if the History has the GUIDs, see FDlgHistory::CanUseGUIDForSearch
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Memory")
+	static bool IsHistoryNodeVisited(const FDlgHistory& History, int32 NodeIndex, FGuid NodeGUID) { return History.Contains(NodeIndex, NodeGUID); }
+
 	// Does the Object implement the Dialogue Participant Interface?
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Helper")
 	static bool DoesObjectImplementDialogueParticipantInterface(const UObject* Object);
@@ -343,9 +500,36 @@ public:
 
 	static bool HasCalledLoadAllDialoguesIntoMemory() { return bCalledLoadAllDialoguesIntoMemory; }
 
-private:
+	// Gathers Object and all the objects referenced by its properties (recursive) that implement the Dialogue Participant Interface
+	// Containers are not supported yet. Used by UDlgParticipantRegistry
 	static void GatherParticipantsRecursive(UObject* Object, TArray<UObject*>& Array, TSet<UObject*>& AlreadyVisited);
 
+private:
+	// Gets a context from the pool of the world if pooling is enabled, otherwise creates a new one
+	static UDlgContext* CreateContext(UObject* FirstParticipant);
+
+	// The pooled contexts are outered to the pool, so the contexts that could replicate through the actor of the
+	// FirstParticipant (multiplayer World or replicated actor) are never pooled
+	static bool CanPoolContext(const UObject* FirstParticipant);
+
+	// Makes sure all the Dialogues are loaded in the editor, the game loads them on demand
+	static void LoadAllDialoguesIntoMemoryIfNeeded();
+
+	// The content paths the Dialogues are searched in, without the forward slash "/" at the end
+	static TArray<FString> GetDialoguesSearchPaths();
+
+	// Gets the AssetRegistry data of all the Dialogues in GetDialoguesSearchPaths
+	static void GetAllDialogueAssets(TArray<FAssetData>& OutAssets);
+
+	// Warns once about the Dialogues that do not have the AssetRegistry tags
+	static void WarnAboutDialoguesWithoutAssetData(int32 Num);
+
+	// Gets the index of the names used by all the Dialogues, makes sure all the Dialogues are loaded in the editor
+	static FDlgNameIndex& GetNameIndex();
+
+	// Gets the index of the Dialogue assets, builds it if it was not built yet
+	static FDlgNameIndex& GetDialogueAssetIndex();
+
 	// Set by the user, we will default to automagically resolve the world
 	static TWeakObjectPtr<const UObject> UserWorldContextObjectPtr;
 
@@ -1,17 +1,75 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #include "DlgMemory.h"
-#include "DlgHelper.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/IsSorted.h"
+#include "UObject/Object.h"
+
+#include "Logging/DlgLogger.h"
+
+namespace DlgMemory
+{
+	// 'DLGH'
+	static constexpr uint32 CompactMagic = 0x44474C48;
+
+	enum class ECompactVersion : int32
+	{
+		Initial = 0,
+
+		// -----<new versions can be added before this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	// Can the Ar still have Num elements of at least MinElementSize bytes? Guards the reserves against corrupted data.
+	static bool CanLoadNum(FArchive& Ar, int32 Num, int64 MinElementSize)
+	{
+		if (Num < 0)
+		{
+			return false;
+		}
+
+		// Some archives do not know their size
+		const int64 TotalSize = Ar.TotalSize();
+		return TotalSize < 0 || Num <= (TotalSize - Ar.Tell()) / MinElementSize;
+	}
+}
 
 void FDlgHistory::Add(int32 NodeIndex, const FGuid& NodeGUID)
 {
-	if (NodeIndex >= 0)
+	AddNodeIndex(NodeIndex);
+	AddNodeGUID(NodeGUID);
+}
+
+void FDlgHistory::AddNodeIndex(int32 NodeIndex)
+{
+	if (NodeIndex < 0 || ContainsNodeIndex(NodeIndex))
 	{
-		VisitedNodeIndices.Add(NodeIndex);
+		return;
 	}
-	if (NodeGUID.IsValid())
+
+	const int32 WordIndex = NodeIndex / NumBitsPerDWORD;
+	if (WordIndex >= VisitedNodeIndexBits.Num())
+	{
+		VisitedNodeIndexBits.AddZeroed(WordIndex + 1 - VisitedNodeIndexBits.Num());
+	}
+	VisitedNodeIndexBits[WordIndex] |= 1u << (NodeIndex % NumBitsPerDWORD);
+	NumVisitedNodeIndices++;
+}
+
+void FDlgHistory::AddNodeGUID(const FGuid& NodeGUID)
+{
+	if (!NodeGUID.IsValid())
+	{
+		return;
+	}
+
+	const int32 Index = Algo::LowerBound(SortedVisitedNodeGUIDs, NodeGUID);
+	if (SortedVisitedNodeGUIDs.IsValidIndex(Index) && SortedVisitedNodeGUIDs[Index] == NodeGUID)
 	{
-		VisitedNodeGUIDs.Add(NodeGUID);
+		return;
 	}
+	SortedVisitedNodeGUIDs.Insert(NodeGUID, Index);
 }
 
 bool FDlgHistory::Contains(int32 NodeIndex, const FGuid& NodeGUID) const
@@ -19,17 +77,79 @@ bool FDlgHistory::Contains(int32 NodeIndex, const FGuid& NodeGUID) const
 	// Use GUID
 	if (CanUseGUIDForSearch() && NodeGUID.IsValid())
 	{
-		return VisitedNodeGUIDs.Contains(NodeGUID);
+		return ContainsNodeGUID(NodeGUID);
 	}
 
 	// FallBack to Node Index
-	return VisitedNodeIndices.Contains(NodeIndex);
+	return ContainsNodeIndex(NodeIndex);
+}
+
+bool FDlgHistory::ContainsNodeGUID(const FGuid& NodeGUID) const
+{
+	return Algo::BinarySearch(SortedVisitedNodeGUIDs, NodeGUID) != INDEX_NONE;
+}
+
+TSet<int32> FDlgHistory::GetVisitedNodeIndices() const
+{
+	TSet<int32> NodeIndices;
+	NodeIndices.Reserve(NumVisitedNodeIndices);
+	for (int32 WordIndex = 0; WordIndex < VisitedNodeIndexBits.Num(); WordIndex++)
+	{
+		uint32 Word = VisitedNodeIndexBits[WordIndex];
+		while (Word != 0)
+		{
+			const int32 Bit = FMath::CountTrailingZeros(Word);
+			NodeIndices.Add(WordIndex * NumBitsPerDWORD + Bit);
+			Word &= Word - 1;
+		}
+	}
+
+	return NodeIndices;
+}
+
+void FDlgHistory::SetVisitedNodeIndices(const TSet<int32>& NodeIndices)
+{
+	VisitedNodeIndexBits.Empty();
+	NumVisitedNodeIndices = 0;
+	for (const int32 NodeIndex : NodeIndices)
+	{
+		AddNodeIndex(NodeIndex);
+	}
+}
+
+void FDlgHistory::SetVisitedNodeGUIDs(const TSet<FGuid>& NodeGUIDs)
+{
+	SortedVisitedNodeGUIDs.Empty(NodeGUIDs.Num());
+	for (const FGuid& NodeGUID : NodeGUIDs)
+	{
+		if (NodeGUID.IsValid())
+		{
+			SortedVisitedNodeGUIDs.Add(NodeGUID);
+		}
+	}
+	SortedVisitedNodeGUIDs.Sort();
 }
 
 bool FDlgHistory::operator==(const FDlgHistory& Other) const
 {
-	return FDlgHelper::IsSetEqual(VisitedNodeIndices, Other.VisitedNodeIndices)
-		&& FDlgHelper::IsSetEqual(VisitedNodeGUIDs, Other.VisitedNodeGUIDs);
+	if (NumVisitedNodeIndices != Other.NumVisitedNodeIndices || SortedVisitedNodeGUIDs != Other.SortedVisitedNodeGUIDs)
+	{
+		return false;
+	}
+
+	// The arrays can have trailing zero words
+	const int32 MaxWords = FMath::Max(VisitedNodeIndexBits.Num(), Other.VisitedNodeIndexBits.Num());
+	for (int32 WordIndex = 0; WordIndex < MaxWords; WordIndex++)
+	{
+		const uint32 Word = VisitedNodeIndexBits.IsValidIndex(WordIndex) ? VisitedNodeIndexBits[WordIndex] : 0;
+		const uint32 OtherWord = Other.VisitedNodeIndexBits.IsValidIndex(WordIndex) ? Other.VisitedNodeIndexBits[WordIndex] : 0;
+		if (Word != OtherWord)
+		{
+			return false;
+		}
+	}
+
+	return true;
 }
 
 FDlgNodeSavedData& FDlgHistory::GetNodeData(const FGuid& NodeGUID)
@@ -37,3 +157,185 @@ FDlgNodeSavedData& FDlgHistory::GetNodeData(const FGuid& NodeGUID)
 	return NodeData.FindOrAdd(NodeGUID);
 }
 
+void FDlgHistory::PostSerialize(const FArchive& Ar)
+{
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+
+	// Old save file
+	for (const int32 NodeIndex : VisitedNodeIndices)
+	{
+		AddNodeIndex(NodeIndex);
+	}
+	for (const FGuid& NodeGUID : VisitedNodeGUIDs)
+	{
+		AddNodeGUID(NodeGUID);
+	}
+	VisitedNodeIndices.Empty();
+	VisitedNodeGUIDs.Empty();
+}
+
+void FDlgHistory::SerializeCompact(FArchive& Ar)
+{
+	if (Ar.IsSaving())
+	{
+		// Trailing zero words do not have any information
+		int32 NumWords = VisitedNodeIndexBits.Num();
+		while (NumWords > 0 && VisitedNodeIndexBits[NumWords - 1] == 0)
+		{
+			NumWords--;
+		}
+		VisitedNodeIndexBits.SetNum(NumWords);
+	}
+
+	Ar << VisitedNodeIndexBits;
+	Ar << SortedVisitedNodeGUIDs;
+
+	int32 NumNodeData = NodeData.Num();
+	Ar << NumNodeData;
+	if (Ar.IsLoading())
+	{
+		// GUID + array num for every entry
+		if (!DlgMemory::CanLoadNum(Ar, NumNodeData, sizeof(FGuid) + sizeof(int32)))
+		{
+			FDlgLogger::Get().Errorf(TEXT("FDlgHistory::SerializeCompact - Invalid NumNodeData = %d"), NumNodeData);
+			Ar.SetError();
+			return;
+		}
+
+		NumVisitedNodeIndices = 0;
+		for (const uint32 Word : VisitedNodeIndexBits)
+		{
+			NumVisitedNodeIndices += FMath::CountBits(Word);
+		}
+
+		// Do not trust the data
+		if (!Algo::IsSorted(SortedVisitedNodeGUIDs))
+		{
+			SortedVisitedNodeGUIDs.Sort();
+		}
+
+		NodeData.Empty(NumNodeData);
+		for (int32 Index = 0; Index < NumNodeData && !Ar.IsError(); Index++)
+		{
+			FGuid NodeGUID;
+			Ar << NodeGUID;
+			Ar << NodeData.Add(NodeGUID).GUIDList;
+		}
+	}
+	else
+	{
+		for (auto& Pair : NodeData)
+		{
+			Ar << Pair.Key;
+			Ar << Pair.Value.GUIDList;
+		}
+	}
+}
+
+
+void FDlgHistoryStore::SerializeCompact(FArchive& Ar)
+{
+	uint32 Magic = DlgMemory::CompactMagic;
+	int32 Version = static_cast<int32>(DlgMemory::ECompactVersion::LatestVersion);
+	Ar << Magic;
+	Ar << Version;
+	if (Magic != DlgMemory::CompactMagic || Version < 0 || Version > static_cast<int32>(DlgMemory::ECompactVersion::LatestVersion))
+	{
+		FDlgLogger::Get().Errorf(
+			TEXT("FDlgHistoryStore::SerializeCompact - Unknown format, Magic = %u, Version = %d"),
+			Magic, Version
+		);
+		Ar.SetError();
+		return;
+	}
+
+	int32 NumEntries = HistoryMap.Num();
+	Ar << NumEntries;
+	if (Ar.IsLoading())
+	{
+		if (!DlgMemory::CanLoadNum(Ar, NumEntries, sizeof(FGuid)))
+		{
+			FDlgLogger::Get().Errorf(TEXT("FDlgHistoryStore::SerializeCompact - Invalid NumEntries = %d"), NumEntries);
+			Ar.SetError();
+			return;
+		}
+
+		// Load into a temporary map so that we do not end up with half of the entries
+		TMap<FGuid, FDlgHistory> LoadedMap;
+		for (int32 Index = 0; Index < NumEntries && !Ar.IsError(); Index++)
+		{
+			FGuid DialogueGUID;
+			Ar << DialogueGUID;
+			LoadedMap.FindOrAdd(DialogueGUID).SerializeCompact(Ar);
+		}
+		if (!Ar.IsError())
+		{
+			HistoryMap = MoveTemp(LoadedMap);
+		}
+	}
+	else
+	{
+		for (auto& Pair : HistoryMap)
+		{
+			Ar << Pair.Key;
+			Pair.Value.SerializeCompact(Ar);
+		}
+	}
+}
+
+
+TSharedRef<FDlgHistoryStore> FDlgMemory::FindOrAddStore(const UObject* Owner)
+{
+	if (Owner == nullptr)
+	{
+		return GlobalStore;
+	}
+
+	if (const TSharedRef<FDlgHistoryStore>* Store = OwnerStores.Find(FObjectKey(Owner)))
+	{
+		return *Store;
+	}
+
+	return OwnerStores.Add(FObjectKey(Owner), MakeShared<FDlgHistoryStore>());
+}
+
+TSharedPtr<FDlgHistoryStore> FDlgMemory::FindStore(const UObject* Owner) const
+{
+	if (Owner == nullptr)
+	{
+		return GlobalStore;
+	}
+
+	if (const TSharedRef<FDlgHistoryStore>* Store = OwnerStores.Find(FObjectKey(Owner)))
+	{
+		return *Store;
+	}
+
+	return nullptr;
+}
+
+void FDlgMemory::RemoveStoresIn(const UObject* Outer)
+{
+	for (auto It = OwnerStores.CreateIterator(); It; ++It)
+	{
+		const UObject* Owner = It.Key().ResolveObjectPtr();
+		if (Owner == nullptr || Owner == Outer || Owner->IsIn(Outer))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FDlgMemory::RemoveStoresWithInvalidOwners()
+{
+	for (auto It = OwnerStores.CreateIterator(); It; ++It)
+	{
+		if (It.Key().ResolveObjectPtr() == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
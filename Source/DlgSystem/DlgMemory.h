@@ -2,6 +2,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
 
 #include "DlgMemory.generated.h"
 
@@ -20,6 +21,9 @@ public:
 };
 
 
+// Visited nodes of a single Dialogue
+// The node indices are stored as a bitset and the node GUIDs as a sorted array, this keeps the history small
+// (no hash buckets per visited node) which matters because there is one history per Dialogue in every save file.
 USTRUCT(BlueprintType)
 struct DLGSYSTEM_API FDlgHistory
 {
@@ -28,6 +32,8 @@ public:
 	FDlgHistory() {}
 
 	void Add(int32 NodeIndex, const FGuid& NodeGUID);
+	void AddNodeIndex(int32 NodeIndex);
+	void AddNodeGUID(const FGuid& NodeGUID);
 
 	// The following scenarios will be present:
 	//
@@ -63,54 +69,77 @@ public:
 	//	 VisitedNodeGUIDs.Num() >= VisitedNodeIndices.Num() is NOT met
 	bool CanUseGUIDForSearch() const
 	{
-		return VisitedNodeGUIDs.Num() >= VisitedNodeIndices.Num();
+		return SortedVisitedNodeGUIDs.Num() >= NumVisitedNodeIndices;
 	}
 
 	bool Contains(int32 NodeIndex, const FGuid& NodeGUID) const;
 
+	bool ContainsNodeIndex(int32 NodeIndex) const
+	{
+		const int32 WordIndex = NodeIndex / NumBitsPerDWORD;
+		return NodeIndex >= 0 && WordIndex < VisitedNodeIndexBits.Num()
+			&& (VisitedNodeIndexBits[WordIndex] & (1u << (NodeIndex % NumBitsPerDWORD))) != 0;
+	}
+
+	bool ContainsNodeGUID(const FGuid& NodeGUID) const;
+
+	int32 GetNumVisitedNodeIndices() const { return NumVisitedNodeIndices; }
+	int32 GetNumVisitedNodeGUIDs() const { return SortedVisitedNodeGUIDs.Num(); }
+
+	// Set of already visited Node indices
+	// NOTE: if you serialize this but then later change the dialogue node positions this will have the wrong indices
+	// NOTE: You should use GetVisitedNodeGUIDs
+	TSet<int32> GetVisitedNodeIndices() const;
+	void SetVisitedNodeIndices(const TSet<int32>& NodeIndices);
+
+	// Already visited node GUIDs, sorted
+	// This was added to fix Issue 30 (https://gitlab.com/NotYetGames/DlgSystem/-/issues/30)
+	const TArray<FGuid>& GetVisitedNodeGUIDs() const { return SortedVisitedNodeGUIDs; }
+	void SetVisitedNodeGUIDs(const TSet<FGuid>& NodeGUIDs);
+
 	bool operator==(const FDlgHistory& Other) const;
 
 	FDlgNodeSavedData& GetNodeData(const FGuid& NodeGUID);
 
-public:
-	// Sed of already visited Node indices
-	// NOTE: if you serialize this but then later change the dialogue node positions this will have the wrong indices
-	// NOTE: You should use VisitedNodeGUIDs
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|History")
+	// Converts the data saved before the history was stored as a bitset
+	void PostSerialize(const FArchive& Ar);
+
+	// Compact binary format, used by FDlgHistoryStore::SerializeCompact
+	void SerializeCompact(FArchive& Ar);
+
+protected:
+	// NOTE: not visible to Blueprints anymore, use the history functions of UDlgManager (e.g. GetHistoryVisitedNodeGUIDs)
+	// Bit for each already visited Node index
+	UPROPERTY()
+	TArray<uint32> VisitedNodeIndexBits;
+
+	// Number of bits set in VisitedNodeIndexBits
+	UPROPERTY()
+	int32 NumVisitedNodeIndices = 0;
+
+	// Already visited node GUIDs, sorted so that we can binary search them
+	UPROPERTY()
+	TArray<FGuid> SortedVisitedNodeGUIDs;
+
+	// DEPRECATED, only here to load the old save files, moved into the members above in PostSerialize
+	UPROPERTY()
 	TSet<int32> VisitedNodeIndices;
 
-	// Set of already visited node GUIDs
-	// This was added to fix Issue 30 (https://gitlab.com/NotYetGames/DlgSystem/-/issues/30)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|History")
+	// DEPRECATED, same as above
+	UPROPERTY()
 	TSet<FGuid> VisitedNodeGUIDs;
 
-
+public:
 	// Key: Dialogue node identifier GUID
 	// Value: data used by the node
 	UPROPERTY()
 	TMap<FGuid, FDlgNodeSavedData> NodeData;
 };
 
-// Singleton to store Dialogue history
-// TODO: investigate if this is multiplayer friendly, it does not seem so as there exists only a single global dialogue memory
-USTRUCT()
-struct DLGSYSTEM_API FDlgMemory
+// Histories of the Dialogues for one owner (world, player, game, etc), see FDlgMemory
+struct DLGSYSTEM_API FDlgHistoryStore
 {
-	GENERATED_USTRUCT_BODY()
 public:
-	FDlgMemory() {}
-	static FDlgMemory* GetInstance()
-	{
-		static FDlgMemory Instance;
-		return &Instance;
-	}
-	static FDlgMemory& Get()
-	{
-		auto* Instance = GetInstance();
-		check(Instance != nullptr);
-		return *Instance;
-	}
-
 	// Removes all entries
 	void Empty() { HistoryMap.Empty(); }
 
@@ -131,6 +160,7 @@ public:
 
 	// Returns the entry for the given name, or nullptr if it does not exist */
 	FDlgHistory* GetEntry(const FGuid& DialogueGUID) { return HistoryMap.Find(DialogueGUID); }
+	const FDlgHistory* GetEntry(const FGuid& DialogueGUID) const { return HistoryMap.Find(DialogueGUID); }
 
 	FDlgHistory& FindOrAddEntry(const FGuid& DialogueGUID) { return HistoryMap.FindOrAdd(DialogueGUID); }
 
@@ -162,7 +192,7 @@ public:
 			return false;
 		}
 
-		return History->VisitedNodeIndices.Contains(NodeIndex);
+		return History->ContainsNodeIndex(NodeIndex);
 	}
 
 	bool IsNodeGUIDVisited(const FGuid& DialogueGUID, const FGuid& NodeGUID) const
@@ -174,24 +204,126 @@ public:
 			return false;
 		}
 
-		return History->VisitedNodeGUIDs.Contains(NodeGUID);
+		return History->ContainsNodeGUID(NodeGUID);
 	}
 
 	const TMap<FGuid, FDlgHistory>& GetHistoryMaps() const { return HistoryMap; }
 	void SetHistoryMap(const TMap<FGuid, FDlgHistory>& Map) { HistoryMap = Map; }
 
+	// Saves/Loads all the entries in a compact binary format, meant for save games and network transfer.
+	// When loading the entries are replaced, on an invalid or unknown format the archive is set to error and the entries are untouched.
+	void SerializeCompact(FArchive& Ar);
+
 private:
-	 // Key: Dialogue unique identifier GUID
-	 // Value: set of already visited nodes
-	UPROPERTY()
+	// Key: Dialogue unique identifier GUID
+	// Value: set of already visited nodes
 	TMap<FGuid, FDlgHistory> HistoryMap;
 };
 
+// Singleton to store Dialogue history
+// The history is split into stores, one global store (used by default) and one store for each owner.
+// An owner can be any object: a World, a PlayerState or a custom object, so that for example each player on a
+// dedicated server has its own history. The contexts bind to their store when started, see UDlgContext::SetHistoryOwner
+// NOTE: the functions without an owner work on the global store
+USTRUCT()
+struct DLGSYSTEM_API FDlgMemory
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	FDlgMemory() : GlobalStore(MakeShared<FDlgHistoryStore>()) {}
+	static FDlgMemory* GetInstance()
+	{
+		static FDlgMemory Instance;
+		return &Instance;
+	}
+	static FDlgMemory& Get()
+	{
+		auto* Instance = GetInstance();
+		check(Instance != nullptr);
+		return *Instance;
+	}
+
+	//
+	// Stores
+	//
+
+	const TSharedRef<FDlgHistoryStore>& GetGlobalStore() const { return GlobalStore; }
+
+	// Gets the store of the Owner, creates it if it does not exist. Returns the global store if the Owner is nullptr
+	TSharedRef<FDlgHistoryStore> FindOrAddStore(const UObject* Owner);
+
+	// Gets the store of the Owner, nullptr if it does not exist. Returns the global store if the Owner is nullptr
+	TSharedPtr<FDlgHistoryStore> FindStore(const UObject* Owner) const;
+
+	// Removes the store of the Owner, the contexts already bound to it keep it alive
+	void RemoveStore(const UObject* Owner) { OwnerStores.Remove(FObjectKey(Owner)); }
+
+	// Removes the stores of the owners that were destroyed
+	// NOTE: the lookups never prune, this is only called at explicit points, see RemoveStoresIn
+	void RemoveStoresWithInvalidOwners();
+
+	// Removes the stores of the owners inside Outer (e.g. a World that is torn down) and of the destroyed owners
+	void RemoveStoresIn(const UObject* Outer);
+
+	int32 GetNumStores() const { return OwnerStores.Num() + 1; }
+
+	// Removes all entries and the stores of all owners
+	void Empty()
+	{
+		GlobalStore->Empty();
+		OwnerStores.Empty();
+	}
+
+	//
+	// Global store
+	//
+
+	// Adds an entry to the map or overrides an existing one
+	void SetEntry(const FGuid& DialogueGUID, const FDlgHistory& History) { GlobalStore->SetEntry(DialogueGUID, History); }
+
+	// Returns the entry for the given name, or nullptr if it does not exist */
+	FDlgHistory* GetEntry(const FGuid& DialogueGUID) { return GlobalStore->GetEntry(DialogueGUID); }
+
+	FDlgHistory& FindOrAddEntry(const FGuid& DialogueGUID) { return GlobalStore->FindOrAddEntry(DialogueGUID); }
+
+	void SetNodeVisited(const FGuid& DialogueGUID, int32 NodeIndex, const FGuid& NodeGUID)
+	{
+		GlobalStore->SetNodeVisited(DialogueGUID, NodeIndex, NodeGUID);
+	}
+
+	bool IsNodeVisited(const FGuid& DialogueGUID, int32 NodeIndex, const FGuid& NodeGUID) const
+	{
+		return GlobalStore->IsNodeVisited(DialogueGUID, NodeIndex, NodeGUID);
+	}
+
+	bool IsNodeIndexVisited(const FGuid& DialogueGUID, int32 NodeIndex) const
+	{
+		return GlobalStore->IsNodeIndexVisited(DialogueGUID, NodeIndex);
+	}
+
+	bool IsNodeGUIDVisited(const FGuid& DialogueGUID, const FGuid& NodeGUID) const
+	{
+		return GlobalStore->IsNodeGUIDVisited(DialogueGUID, NodeGUID);
+	}
+
+	const TMap<FGuid, FDlgHistory>& GetHistoryMaps() const { return GlobalStore->GetHistoryMaps(); }
+	void SetHistoryMap(const TMap<FGuid, FDlgHistory>& Map) { GlobalStore->SetHistoryMap(Map); }
+
+private:
+	// Used when no owner is specified
+	TSharedRef<FDlgHistoryStore> GlobalStore;
+
+	// Key: owner of the store
+	// Value: the histories of that owner
+	TMap<FObjectKey, TSharedRef<FDlgHistoryStore>> OwnerStores;
+};
+
 template<>
 struct TStructOpsTypeTraits<FDlgHistory> : public TStructOpsTypeTraitsBase2<FDlgHistory>
 {
 	enum
 	{
-		WithIdenticalViaEquality = true
+		WithIdenticalViaEquality = true,
+		WithPostSerialize = true
 	};
 };
@@ -0,0 +1,302 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgNameIndex.h"
+
+#include "AssetRegistry/AssetData.h"
+
+#include "DlgDialogue.h"
+#include "DlgDialogueAssetData.h"
+#include "DlgHelper.h"
+
+void FDlgNameIndex::UpdateDialogue(const UDlgDialogue& Dialogue)
+{
+	FDialogueNames NewNames;
+	NewNames.ParticipantNames = Dialogue.GetParticipantNames();
+	NewNames.SpeakerStates = Dialogue.GetSpeakerStates();
+	for (const auto& Pair : Dialogue.GetParticipantsData())
+	{
+		const FName ParticipantName = Pair.Key;
+		const FDlgParticipantData& Data = Pair.Value;
+		auto AddParticipantNames = [&NewNames, ParticipantName](EDlgNameIndexType Type, const TSet<FName>& Names)
+		{
+			if (Names.Num() > 0)
+			{
+				NewNames.ParticipantsNames[static_cast<int32>(Type)].Add(ParticipantName, Names);
+			}
+		};
+
+		AddParticipantNames(EDlgNameIndexType::Int, Data.IntVariableNames);
+		AddParticipantNames(EDlgNameIndexType::Float, Data.FloatVariableNames);
+		AddParticipantNames(EDlgNameIndexType::Bool, Data.BoolVariableNames);
+		AddParticipantNames(EDlgNameIndexType::FName, Data.NameVariableNames);
+		AddParticipantNames(EDlgNameIndexType::Condition, Data.Conditions);
+		AddParticipantNames(EDlgNameIndexType::Event, Data.Events);
+	}
+
+	const FObjectKey DialogueKey(&Dialogue);
+	FDialogueNames& DialogueNames = DialoguesNames.FindOrAdd(DialogueKey);
+	RemoveNames(DialogueKey, DialogueNames);
+	DialogueNames = MoveTemp(NewNames);
+	AddNames(DialogueKey, DialogueNames);
+}
+
+void FDlgNameIndex::RemoveDialogue(const UDlgDialogue* Dialogue)
+{
+	const FObjectKey DialogueKey(Dialogue);
+	FDialogueNames DialogueNames;
+	if (DialoguesNames.RemoveAndCopyValue(DialogueKey, DialogueNames))
+	{
+		RemoveNames(DialogueKey, DialogueNames);
+	}
+}
+
+void FDlgNameIndex::Empty()
+{
+	DialoguesNames.Empty();
+	ParticipantNames = {};
+	SpeakerStates = {};
+	for (TMap<FName, FNameCounter>& Map : ParticipantsNames)
+	{
+		Map.Empty();
+	}
+	ParticipantsDialogues.Empty();
+	EmptyAssets();
+}
+
+const TArray<FName>& FDlgNameIndex::GetParticipantNames(EDlgNameIndexType Type, FName ParticipantName)
+{
+	check(Type < EDlgNameIndexType::Num);
+	if (FNameCounter* Counter = ParticipantsNames[static_cast<int32>(Type)].Find(ParticipantName))
+	{
+		return Counter->GetSortedNames();
+	}
+
+	static const TArray<FName> EmptyNames;
+	return EmptyNames;
+}
+
+void FDlgNameIndex::GetDialoguesForParticipantName(FName ParticipantName, TArray<UDlgDialogue*>& OutDialogues) const
+{
+	const TArray<FObjectKey>* DialogueKeys = ParticipantsDialogues.Find(ParticipantName);
+	if (!DialogueKeys)
+	{
+		return;
+	}
+
+	OutDialogues.Reserve(OutDialogues.Num() + DialogueKeys->Num());
+	for (const FObjectKey& DialogueKey : *DialogueKeys)
+	{
+		UDlgDialogue* Dialogue = Cast<UDlgDialogue>(DialogueKey.ResolveObjectPtr());
+		if (IsValid(Dialogue))
+		{
+			OutDialogues.Add(Dialogue);
+		}
+	}
+}
+
+int32 FDlgNameIndex::GetNumDialoguesForParticipantName(FName ParticipantName) const
+{
+	const TArray<FObjectKey>* DialogueKeys = ParticipantsDialogues.Find(ParticipantName);
+	return DialogueKeys ? DialogueKeys->Num() : 0;
+}
+
+void FDlgNameIndex::RebuildAssets(const TArray<FAssetData>& InAssets)
+{
+	EmptyAssets();
+	Assets.Reserve(InAssets.Num());
+	for (const FAssetData& AssetData : InAssets)
+	{
+		UpdateAsset(AssetData);
+	}
+	bAssetsBuilt = true;
+}
+
+void FDlgNameIndex::EmptyAssets()
+{
+	Assets.Empty();
+	AssetsWithoutMetadata.Empty();
+	ParticipantsAssets.Empty();
+	GUIDsAssets.Empty();
+	bAssetsBuilt = false;
+}
+
+void FDlgNameIndex::UpdateAsset(const FAssetData& AssetData)
+{
+	const FSoftObjectPath ObjectPath = AssetData.ToSoftObjectPath();
+	RemoveAsset(ObjectPath);
+
+	FDialogueAsset Asset;
+	if (!FDlgDialogueAssetData::GetParticipantNames(AssetData, Asset.ParticipantNames))
+	{
+		AssetsWithoutMetadata.Add(ObjectPath);
+		return;
+	}
+	FDlgDialogueAssetData::GetGUID(AssetData, Asset.GUID);
+
+	for (const FName ParticipantName : Asset.ParticipantNames)
+	{
+		ParticipantsAssets.FindOrAdd(ParticipantName).Add(ObjectPath);
+	}
+	if (Asset.GUID.IsValid())
+	{
+		GUIDsAssets.FindOrAdd(Asset.GUID).Add(ObjectPath);
+	}
+	Assets.Add(ObjectPath, MoveTemp(Asset));
+}
+
+void FDlgNameIndex::RemoveAsset(const FSoftObjectPath& ObjectPath)
+{
+	AssetsWithoutMetadata.Remove(ObjectPath);
+
+	FDialogueAsset Asset;
+	if (!Assets.RemoveAndCopyValue(ObjectPath, Asset))
+	{
+		return;
+	}
+
+	for (const FName ParticipantName : Asset.ParticipantNames)
+	{
+		if (TArray<FSoftObjectPath>* ObjectPaths = ParticipantsAssets.Find(ParticipantName))
+		{
+			ObjectPaths->RemoveSingleSwap(ObjectPath);
+			if (ObjectPaths->Num() == 0)
+			{
+				ParticipantsAssets.Remove(ParticipantName);
+			}
+		}
+	}
+
+	if (auto* ObjectPaths = GUIDsAssets.Find(Asset.GUID))
+	{
+		// Keep the order, the first one is the one that is found
+		ObjectPaths->Remove(ObjectPath);
+		if (ObjectPaths->Num() == 0)
+		{
+			GUIDsAssets.Remove(Asset.GUID);
+		}
+	}
+}
+
+void FDlgNameIndex::GetDialogueAssetsForParticipantName(FName ParticipantName, TArray<TSoftObjectPtr<UDlgDialogue>>& OutDialogues) const
+{
+	if (const TArray<FSoftObjectPath>* ObjectPaths = ParticipantsAssets.Find(ParticipantName))
+	{
+		OutDialogues.Reserve(OutDialogues.Num() + ObjectPaths->Num());
+		for (const FSoftObjectPath& ObjectPath : *ObjectPaths)
+		{
+			OutDialogues.Add(TSoftObjectPtr<UDlgDialogue>(ObjectPath));
+		}
+	}
+
+	// The loaded Dialogues with tags are already added above, from their tags
+	if (const TArray<FObjectKey>* DialogueKeys = ParticipantsDialogues.Find(ParticipantName))
+	{
+		for (const FObjectKey& DialogueKey : *DialogueKeys)
+		{
+			UDlgDialogue* Dialogue = Cast<UDlgDialogue>(DialogueKey.ResolveObjectPtr());
+			if (IsValid(Dialogue) && !Assets.Contains(FSoftObjectPath(Dialogue)))
+			{
+				OutDialogues.Add(TSoftObjectPtr<UDlgDialogue>(Dialogue));
+			}
+		}
+	}
+}
+
+bool FDlgNameIndex::FindDialogueAssetByGUID(const FGuid& GUID, FSoftObjectPath& OutObjectPath) const
+{
+	const auto* ObjectPaths = GUIDsAssets.Find(GUID);
+	if (!ObjectPaths || ObjectPaths->Num() == 0)
+	{
+		return false;
+	}
+
+	OutObjectPath = (*ObjectPaths)[0];
+	return true;
+}
+
+void FDlgNameIndex::AddNames(const FObjectKey& DialogueKey, const FDialogueNames& Names)
+{
+	for (const FName ParticipantName : Names.ParticipantNames)
+	{
+		ParticipantsDialogues.FindOrAdd(ParticipantName).Add(DialogueKey);
+	}
+
+	ParticipantNames.Add(Names.ParticipantNames);
+	SpeakerStates.Add(Names.SpeakerStates);
+	for (int32 TypeIndex = 0; TypeIndex < static_cast<int32>(EDlgNameIndexType::Num); TypeIndex++)
+	{
+		for (const auto& Pair : Names.ParticipantsNames[TypeIndex])
+		{
+			ParticipantsNames[TypeIndex].FindOrAdd(Pair.Key).Add(Pair.Value);
+		}
+	}
+}
+
+void FDlgNameIndex::RemoveNames(const FObjectKey& DialogueKey, const FDialogueNames& Names)
+{
+	for (const FName ParticipantName : Names.ParticipantNames)
+	{
+		if (TArray<FObjectKey>* DialogueKeys = ParticipantsDialogues.Find(ParticipantName))
+		{
+			DialogueKeys->RemoveSingleSwap(DialogueKey);
+			if (DialogueKeys->Num() == 0)
+			{
+				ParticipantsDialogues.Remove(ParticipantName);
+			}
+		}
+	}
+
+	ParticipantNames.Remove(Names.ParticipantNames);
+	SpeakerStates.Remove(Names.SpeakerStates);
+	for (int32 TypeIndex = 0; TypeIndex < static_cast<int32>(EDlgNameIndexType::Num); TypeIndex++)
+	{
+		TMap<FName, FNameCounter>& Counters = ParticipantsNames[TypeIndex];
+		for (const auto& Pair : Names.ParticipantsNames[TypeIndex])
+		{
+			if (FNameCounter* Counter = Counters.Find(Pair.Key))
+			{
+				Counter->Remove(Pair.Value);
+				if (Counter->IsEmpty())
+				{
+					Counters.Remove(Pair.Key);
+				}
+			}
+		}
+	}
+}
+
+void FDlgNameIndex::FNameCounter::Add(const TSet<FName>& Names)
+{
+	for (const FName Name : Names)
+	{
+		int32& Count = Counts.FindOrAdd(Name, 0);
+		if (Count++ == 0)
+		{
+			bDirty = true;
+		}
+	}
+}
+
+void FDlgNameIndex::FNameCounter::Remove(const TSet<FName>& Names)
+{
+	for (const FName Name : Names)
+	{
+		int32* Count = Counts.Find(Name);
+		if (Count && --(*Count) <= 0)
+		{
+			Counts.Remove(Name);
+			bDirty = true;
+		}
+	}
+}
+
+const TArray<FName>& FDlgNameIndex::FNameCounter::GetSortedNames()
+{
+	if (bDirty)
+	{
+		Counts.GenerateKeyArray(SortedNames);
+		FDlgHelper::SortDefault(SortedNames);
+		bDirty = false;
+	}
+
+	return SortedNames;
+}
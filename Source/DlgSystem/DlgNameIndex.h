@@ -0,0 +1,159 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/SoftObjectPtr.h"
+
+class UDlgDialogue;
+struct FAssetData;
+
+// The names of a participant that are indexed, see FDlgNameIndex
+enum class EDlgNameIndexType : uint8
+{
+	Int = 0,
+	Float,
+	Bool,
+	FName,
+	Condition,
+	Event,
+
+	Num
+};
+
+/**
+ * Index of the names used by all the loaded Dialogues (participant names, speaker states, variable names, etc)
+ * and of the Dialogues each participant name is used in.
+ * Each Dialogue adds its names when its data is refreshed (PostLoad and UpdateAndRefreshData) and removes them when it is
+ * destroyed or deleted. Every name is reference counted by the number of Dialogues using it and the queries return sorted
+ * arrays that are only rebuilt after the names changed, so they do not touch the Dialogues.
+ * Used by UDlgManager::GetDialoguesParticipantNames, UDlgManager::GetAllDialoguesForParticipantName and friends.
+ *
+ * It also indexes the Dialogue assets (loaded or not) by participant name and GUID from their AssetRegistry tags
+ * (see FDlgDialogueAssetData). The assets are added once with RebuildAssets and kept up to date from the AssetRegistry
+ * events, see FDlgSystemModule. The asset queries merge them with the loaded Dialogues that do not have the tags yet
+ * (new or saved with an older version), so the same index serves the loaded and the unloaded Dialogues.
+ * Used by UDlgManager::GetAllDialogueAssetsForParticipantName and FindDialogueAssetByGUID.
+ * NOTE: only use it on the game thread, just like the Dialogues.
+ */
+class DLGSYSTEM_API FDlgNameIndex
+{
+public:
+	static FDlgNameIndex& Get()
+	{
+		static FDlgNameIndex Instance;
+		return Instance;
+	}
+
+	// Adds the names of the Dialogue or replaces the ones from a previous update
+	void UpdateDialogue(const UDlgDialogue& Dialogue);
+
+	// Removes the names of the Dialogue, if any
+	void RemoveDialogue(const UDlgDialogue* Dialogue);
+
+	bool ContainsDialogue(const UDlgDialogue* Dialogue) const { return DialoguesNames.Contains(FObjectKey(Dialogue)); }
+	int32 GetNumDialogues() const { return DialoguesNames.Num(); }
+
+	void Empty();
+
+	// All the queries return the names sorted alphabetically ascending
+	const TArray<FName>& GetParticipantNames() { return ParticipantNames.GetSortedNames(); }
+	const TArray<FName>& GetSpeakerStates() { return SpeakerStates.GetSortedNames(); }
+	const TArray<FName>& GetParticipantNames(EDlgNameIndexType Type, FName ParticipantName);
+
+	// Appends the Dialogues that have the ParticipantName to OutDialogues, in no particular order
+	// Only touches the Dialogues of the result.
+	void GetDialoguesForParticipantName(FName ParticipantName, TArray<UDlgDialogue*>& OutDialogues) const;
+	int32 GetNumDialoguesForParticipantName(FName ParticipantName) const;
+
+	//
+	// Dialogue assets
+	//
+
+	// Replaces all the indexed assets with Assets (must be Dialogue assets)
+	void RebuildAssets(const TArray<FAssetData>& Assets);
+	void EmptyAssets();
+	bool AreAssetsBuilt() const { return bAssetsBuilt; }
+
+	// Adds the Dialogue asset or replaces its previous tags
+	void UpdateAsset(const FAssetData& AssetData);
+	void RemoveAsset(const FSoftObjectPath& ObjectPath);
+
+	// Appends the Dialogue assets that have the ParticipantName in their tags and the loaded Dialogues without tags that have it
+	// to OutDialogues, in no particular order
+	void GetDialogueAssetsForParticipantName(FName ParticipantName, TArray<TSoftObjectPtr<UDlgDialogue>>& OutDialogues) const;
+
+	// Finds the first indexed Dialogue asset with the GUID tag
+	bool FindDialogueAssetByGUID(const FGuid& GUID, FSoftObjectPath& OutObjectPath) const;
+
+	bool ContainsAsset(const FSoftObjectPath& ObjectPath) const { return Assets.Contains(ObjectPath); }
+	int32 GetNumAssets() const { return Assets.Num(); }
+
+	// The Dialogue assets saved before the tags existed
+	int32 GetNumAssetsWithoutMetadata() const { return AssetsWithoutMetadata.Num(); }
+
+private:
+	// Names used by a single Dialogue
+	struct FDialogueNames
+	{
+		TSet<FName> ParticipantNames;
+		TSet<FName> SpeakerStates;
+
+		// Key: Participant Name
+		TMap<FName, TSet<FName>> ParticipantsNames[static_cast<int32>(EDlgNameIndexType::Num)];
+	};
+
+	// Names with the number of Dialogues that use them
+	struct FNameCounter
+	{
+		void Add(const TSet<FName>& Names);
+		void Remove(const TSet<FName>& Names);
+		bool IsEmpty() const { return Counts.Num() == 0; }
+		const TArray<FName>& GetSortedNames();
+
+		TMap<FName, int32> Counts;
+		TArray<FName> SortedNames;
+		bool bDirty = false;
+	};
+
+	// The tags of a Dialogue asset
+	struct FDialogueAsset
+	{
+		FGuid GUID;
+		TArray<FName> ParticipantNames;
+	};
+
+	void AddNames(const FObjectKey& DialogueKey, const FDialogueNames& Names);
+	void RemoveNames(const FObjectKey& DialogueKey, const FDialogueNames& Names);
+
+private:
+	// Key: Dialogue
+	TMap<FObjectKey, FDialogueNames> DialoguesNames;
+
+	FNameCounter ParticipantNames;
+	FNameCounter SpeakerStates;
+
+	// Key: Participant Name
+	TMap<FName, FNameCounter> ParticipantsNames[static_cast<int32>(EDlgNameIndexType::Num)];
+
+	// Key: Participant Name
+	// Value: the Dialogues that use it
+	TMap<FName, TArray<FObjectKey>> ParticipantsDialogues;
+
+	// Key: Dialogue asset with the tags
+	TMap<FSoftObjectPath, FDialogueAsset> Assets;
+
+	// Dialogue assets without the tags
+	TSet<FSoftObjectPath> AssetsWithoutMetadata;
+
+	// Key: Participant Name
+	// Value: the Dialogue assets that use it
+	TMap<FName, TArray<FSoftObjectPath>> ParticipantsAssets;
+
+	// Key: GUID
+	// Value: the Dialogue assets with that GUID, should only have one
+	TMap<FGuid, TArray<FSoftObjectPath, TInlineAllocator<1>>> GUIDsAssets;
+
+	bool bAssetsBuilt = false;
+};
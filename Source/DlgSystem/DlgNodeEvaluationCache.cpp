@@ -0,0 +1,33 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgNodeEvaluationCache.h"
+
+FString FDlgNodeEvaluationCacheStats::ToString() const
+{
+	return FString::Printf(
+		TEXT("Enterable Hits = %lld, Misses = %lld | SatisfiedChild Hits = %lld, Misses = %lld | Invalidations = %lld | Hit Rate = %.1f%%"),
+		EnterableHits, EnterableMisses, SatisfiedChildHits, SatisfiedChildMisses, Invalidations, GetHitRate() * 100.0
+	);
+}
+
+void FDlgNodeEvaluationCache::Invalidate()
+{
+	// Also invalidates the evaluations in progress
+	InvalidationsNum++;
+
+	const bool bHasValues = EnterableKnown.Contains(true) || SatisfiedChildKnown.Contains(true);
+	if (!bHasValues)
+	{
+		return;
+	}
+
+	// Keep the memory, this happens every step
+	EnterableKnown.SetRange(0, EnterableKnown.Num(), false);
+	SatisfiedChildKnown.SetRange(0, SatisfiedChildKnown.Num(), false);
+	Stats.Invalidations++;
+}
+
+void FDlgNodeEvaluationCache::Reset()
+{
+	Invalidate();
+	ResetStats();
+}
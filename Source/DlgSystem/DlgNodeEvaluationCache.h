@@ -0,0 +1,140 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/BitArray.h"
+
+// Counters of a FDlgNodeEvaluationCache, used to see how much evaluation the cache saves
+struct DLGSYSTEM_API FDlgNodeEvaluationCacheStats
+{
+	int64 EnterableHits = 0;
+	int64 EnterableMisses = 0;
+	int64 SatisfiedChildHits = 0;
+	int64 SatisfiedChildMisses = 0;
+
+	// Number of times the cached results were thrown away (step ended, event fired, node visited, ...)
+	int64 Invalidations = 0;
+
+	int64 GetHits() const { return EnterableHits + SatisfiedChildHits; }
+	int64 GetLookups() const { return GetHits() + EnterableMisses + SatisfiedChildMisses; }
+
+	// Between 0 and 1
+	double GetHitRate() const
+	{
+		const int64 Lookups = GetLookups();
+		return Lookups > 0 ? static_cast<double>(GetHits()) / static_cast<double>(Lookups) : 0.0;
+	}
+
+	FString ToString() const;
+};
+
+/**
+ * Memo table of a Context for the results of the node evaluation (IsNodeEnterable/CheckNodeEnterConditions and
+ * HasAnySatisfiedChild), indexed by the index of the node in the Dialogue Nodes array.
+ * Without it, shared sub-trees (behind proxies, selectors, HasSatisfiedChild conditions) are evaluated again for every path.
+ *
+ * The results are only cached during an evaluation step (see FScope), the participants can change between steps.
+ * Inside a step the cache is invalidated when an event fires or the Context changes (e.g. a node is visited).
+ *
+ * A result is only cached if it did not depend on the path of the evaluation: the loop detection (FDlgVisitedNodes)
+ * considers the nodes that are already being evaluated as satisfied, so those results are not stored (see NotifyLoopCut).
+ */
+class DLGSYSTEM_API FDlgNodeEvaluationCache
+{
+public:
+	// Evaluation step, the cache is used while at least one scope is alive and invalidated when the last one ends
+	class FScope
+	{
+	public:
+		explicit FScope(FDlgNodeEvaluationCache& InCache) : Cache(InCache) { Cache.ScopesNum++; }
+		~FScope()
+		{
+			Cache.ScopesNum--;
+			if (Cache.ScopesNum == 0)
+			{
+				Cache.Invalidate();
+			}
+		}
+
+	private:
+		FDlgNodeEvaluationCache& Cache;
+	};
+
+public:
+	bool IsActive() const { return ScopesNum > 0; }
+
+	// Returns the cached enterability of the node at NodeIndex or calls Evaluate and caches its result
+	template <typename FunctionType>
+	bool FindOrEvaluateEnterable(int32 NodeIndex, FunctionType&& Evaluate)
+	{
+		return FindOrEvaluate(EnterableKnown, EnterableValues, Stats.EnterableHits, Stats.EnterableMisses, NodeIndex, Forward<FunctionType>(Evaluate));
+	}
+
+	// Same as FindOrEvaluateEnterable but for HasAnySatisfiedChild
+	template <typename FunctionType>
+	bool FindOrEvaluateSatisfiedChild(int32 NodeIndex, FunctionType&& Evaluate)
+	{
+		return FindOrEvaluate(SatisfiedChildKnown, SatisfiedChildValues, Stats.SatisfiedChildHits, Stats.SatisfiedChildMisses, NodeIndex, Forward<FunctionType>(Evaluate));
+	}
+
+	// Called by the loop detection when a node is considered satisfied because it is already being evaluated
+	void NotifyLoopCut() { LoopCutsNum++; }
+
+	// Throws away the cached results
+	void Invalidate();
+
+	// Invalidate + clears the stats
+	void Reset();
+
+	const FDlgNodeEvaluationCacheStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FDlgNodeEvaluationCacheStats(); }
+
+private:
+	template <typename FunctionType>
+	bool FindOrEvaluate(TBitArray<>& Known, TBitArray<>& Values, int64& Hits, int64& Misses, int32 NodeIndex, FunctionType&& Evaluate)
+	{
+		if (!IsActive() || NodeIndex < 0)
+		{
+			return Evaluate();
+		}
+
+		if (Known.IsValidIndex(NodeIndex) && Known[NodeIndex])
+		{
+			Hits++;
+			return Values[NodeIndex];
+		}
+
+		Misses++;
+		const uint32 LoopCutsBefore = LoopCutsNum;
+		const uint32 InvalidationsBefore = InvalidationsNum;
+		const bool bResult = Evaluate();
+
+		// Depends on the path or the context changed in the meantime
+		if (LoopCutsNum != LoopCutsBefore || InvalidationsNum != InvalidationsBefore)
+		{
+			return bResult;
+		}
+
+		if (NodeIndex >= Known.Num())
+		{
+			Known.Add(false, NodeIndex + 1 - Known.Num());
+			Values.Add(false, NodeIndex + 1 - Values.Num());
+		}
+		Known[NodeIndex] = true;
+		Values[NodeIndex] = bResult;
+		return bResult;
+	}
+
+private:
+	// Bit for each node index, set if the value is cached
+	TBitArray<> EnterableKnown;
+	TBitArray<> EnterableValues;
+	TBitArray<> SatisfiedChildKnown;
+	TBitArray<> SatisfiedChildValues;
+
+	int32 ScopesNum = 0;
+	uint32 LoopCutsNum = 0;
+	uint32 InvalidationsNum = 0;
+
+	FDlgNodeEvaluationCacheStats Stats;
+};
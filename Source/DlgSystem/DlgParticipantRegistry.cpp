@@ -0,0 +1,330 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgParticipantRegistry.h"
+
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+#include "DlgDialogueParticipant.h"
+#include "DlgManager.h"
+
+UDlgParticipantRegistry* UDlgParticipantRegistry::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject || !GEngine)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return World ? World->GetSubsystem<UDlgParticipantRegistry>() : nullptr;
+}
+
+void UDlgParticipantRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UWorld* World = GetWorld();
+	check(World);
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::HandleActorSpawned));
+	LevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::HandleLevelAddedToWorld);
+	LevelRemovedFromWorldHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::HandleLevelRemovedFromWorld);
+}
+
+void UDlgParticipantRegistry::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedFromWorldHandle);
+
+	ParticipantsByName.Empty();
+	ParticipantsNames.Empty();
+	PendingActors.Empty();
+	bBuilt = false;
+
+	Super::Deinitialize();
+}
+
+void UDlgParticipantRegistry::RegisterParticipant(UObject* Participant)
+{
+	if (!IsValid(Participant) || !Participant->GetClass()->ImplementsInterface(UDlgDialogueParticipant::StaticClass()))
+	{
+		return;
+	}
+
+	AddParticipant(Participant, IDlgDialogueParticipant::Execute_GetParticipantName(Participant));
+}
+
+void UDlgParticipantRegistry::UnregisterParticipant(UObject* Participant)
+{
+	RemoveParticipant(Participant);
+}
+
+void UDlgParticipantRegistry::RegisterActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	TArray<UObject*> Participants;
+	TSet<UObject*> AlreadyVisited;
+	UDlgManager::GatherParticipantsRecursive(Actor, Participants, AlreadyVisited);
+	for (UObject* Participant : Participants)
+	{
+		RegisterParticipant(Participant);
+	}
+
+	// Only the actors with participants are listened to
+	if (Participants.Num() > 0)
+	{
+		Actor->OnDestroyed.AddUniqueDynamic(this, &ThisClass::HandleActorDestroyed);
+	}
+}
+
+void UDlgParticipantRegistry::GetParticipants(FName ParticipantName, TArray<UObject*>& OutParticipants)
+{
+	BuildIfNeeded();
+	TArray<TWeakObjectPtr<UObject>>* Participants = ParticipantsByName.Find(ParticipantName);
+	if (Participants == nullptr)
+	{
+		return;
+	}
+
+	// Remove the destroyed ones while we are here
+	for (int32 Index = Participants->Num() - 1; Index >= 0; Index--)
+	{
+		if (!(*Participants)[Index].IsValid())
+		{
+			Participants->RemoveAt(Index);
+		}
+	}
+
+	// The name could have changed since it was registered
+	TArray<UObject*> RenamedParticipants;
+	for (const TWeakObjectPtr<UObject>& Participant : *Participants)
+	{
+		if (IDlgDialogueParticipant::Execute_GetParticipantName(Participant.Get()) == ParticipantName)
+		{
+			OutParticipants.AddUnique(Participant.Get());
+		}
+		else
+		{
+			RenamedParticipants.Add(Participant.Get());
+		}
+	}
+
+	// Files them under the new name, this can remove the Participants array
+	for (UObject* Participant : RenamedParticipants)
+	{
+		RegisterParticipant(Participant);
+	}
+}
+
+TArray<UObject*> UDlgParticipantRegistry::GetAllParticipants()
+{
+	BuildIfNeeded();
+	TArray<UObject*> AllParticipants;
+	for (const auto& Pair : ParticipantsByName)
+	{
+		for (const TWeakObjectPtr<UObject>& Participant : Pair.Value)
+		{
+			if (UObject* ValidParticipant = Participant.Get())
+			{
+				AllParticipants.Add(ValidParticipant);
+			}
+		}
+	}
+
+	return AllParticipants;
+}
+
+TMap<FName, FDlgObjectsArray> UDlgParticipantRegistry::GetParticipantsMap()
+{
+	BuildIfNeeded();
+	TMap<FName, FDlgObjectsArray> ObjectsMap;
+	for (const auto& Pair : ParticipantsByName)
+	{
+		FDlgObjectsArray ArrayStruct;
+		for (const TWeakObjectPtr<UObject>& Participant : Pair.Value)
+		{
+			if (UObject* ValidParticipant = Participant.Get())
+			{
+				ArrayStruct.Array.Add(ValidParticipant);
+			}
+		}
+
+		if (ArrayStruct.Array.Num() > 0)
+		{
+			ObjectsMap.Add(Pair.Key, ArrayStruct);
+		}
+	}
+
+	return ObjectsMap;
+}
+
+void UDlgParticipantRegistry::RegisterPendingActors()
+{
+	// Registering can spawn actors
+	TArray<TWeakObjectPtr<AActor>> Actors = MoveTemp(PendingActors);
+	PendingActors.Reset();
+	for (const TWeakObjectPtr<AActor>& Actor : Actors)
+	{
+		RegisterActor(Actor.Get());
+	}
+}
+
+void UDlgParticipantRegistry::Rebuild()
+{
+	ParticipantsByName.Empty();
+	ParticipantsNames.Empty();
+	PendingActors.Empty();
+	bBuilt = true;
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// TObjectIterator has some weird ghost objects in editor, I failed to find a way to validate them
+	// Instead of this ActorIterate is used and the properties inside the actors are examined in a recursive way
+	for (TActorIterator<AActor> Itr(World); Itr; ++Itr)
+	{
+		RegisterActor(*Itr);
+	}
+}
+
+void UDlgParticipantRegistry::AddParticipant(UObject* Participant, FName ParticipantName)
+{
+	const FObjectKey ParticipantKey(Participant);
+	if (const FName* OldName = ParticipantsNames.Find(ParticipantKey))
+	{
+		if (*OldName == ParticipantName)
+		{
+			return;
+		}
+
+		RemoveParticipant(Participant);
+	}
+
+	ParticipantsNames.Add(ParticipantKey, ParticipantName);
+	ParticipantsByName.FindOrAdd(ParticipantName).Add(Participant);
+}
+
+void UDlgParticipantRegistry::RemoveParticipant(const UObject* Participant)
+{
+	FName ParticipantName;
+	if (!ParticipantsNames.RemoveAndCopyValue(FObjectKey(Participant), ParticipantName))
+	{
+		return;
+	}
+
+	if (TArray<TWeakObjectPtr<UObject>>* Participants = ParticipantsByName.Find(ParticipantName))
+	{
+		Participants->RemoveAll([Participant](const TWeakObjectPtr<UObject>& Other)
+		{
+			return Other.Get() == Participant || !Other.IsValid();
+		});
+		if (Participants->Num() == 0)
+		{
+			ParticipantsByName.Remove(ParticipantName);
+		}
+	}
+}
+
+void UDlgParticipantRegistry::RemoveParticipantsIn(const UObject* Outer)
+{
+	TArray<const UObject*> ParticipantsToRemove;
+	for (const auto& Pair : ParticipantsByName)
+	{
+		for (const TWeakObjectPtr<UObject>& Participant : Pair.Value)
+		{
+			const UObject* ValidParticipant = Participant.Get();
+			if (ValidParticipant && (ValidParticipant == Outer || ValidParticipant->IsIn(Outer)))
+			{
+				ParticipantsToRemove.Add(ValidParticipant);
+			}
+		}
+	}
+	for (const UObject* Participant : ParticipantsToRemove)
+	{
+		RemoveParticipant(Participant);
+	}
+
+	// Prune the destroyed ones
+	for (auto It = ParticipantsNames.CreateIterator(); It; ++It)
+	{
+		if (It.Key().ResolveObjectPtr() == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = ParticipantsByName.CreateIterator(); It; ++It)
+	{
+		It.Value().RemoveAll([](const TWeakObjectPtr<UObject>& Participant) { return !Participant.IsValid(); });
+		if (It.Value().Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UDlgParticipantRegistry::HandleActorSpawned(AActor* Actor)
+{
+	// Not built yet, it will be found by the scan
+	// Otherwise register it on the next query, the actor did not finish spawning yet
+	if (bBuilt && Actor)
+	{
+		PendingActors.Add(Actor);
+	}
+}
+
+void UDlgParticipantRegistry::HandleActorDestroyed(AActor* Actor)
+{
+	if (Actor)
+	{
+		RemoveParticipantsIn(Actor);
+	}
+}
+
+void UDlgParticipantRegistry::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (!bBuilt || World != GetWorld() || !Level)
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		RegisterActor(Actor);
+	}
+}
+
+void UDlgParticipantRegistry::HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	if (!bBuilt || World != GetWorld())
+	{
+		return;
+	}
+
+	// nullptr Level means all the levels were removed
+	if (!Level)
+	{
+		ParticipantsByName.Empty();
+		ParticipantsNames.Empty();
+		PendingActors.Empty();
+		bBuilt = false;
+		return;
+	}
+
+	RemoveParticipantsIn(Level);
+	PendingActors.RemoveAll([Level](const TWeakObjectPtr<AActor>& Actor)
+	{
+		return !Actor.IsValid() || Actor->IsIn(Level);
+	});
+}
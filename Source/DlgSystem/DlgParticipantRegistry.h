@@ -0,0 +1,116 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "DlgParticipantRegistry.generated.h"
+
+class AActor;
+class ULevel;
+struct FDlgObjectsArray;
+
+/**
+ * Index of the objects that implement the Dialogue Participant Interface in a World, by Participant Name.
+ * The World is scanned once, the first time the registry is used, after that the index is kept up to date from the
+ * spawned and destroyed actors, the streamed in levels and the RegisterParticipant/UnregisterParticipant calls.
+ * Used by UDlgManager::StartDialogueWithDefaultParticipants and GetObjectsMapWithDialogueParticipantInterface.
+ *
+ * The spawned actors are only registered the next time the registry is queried, so that their Participant Name is read
+ * after the actor finished spawning (construction script, ExposeOnSpawn properties, BeginPlay, added components).
+ * NOTE: the Participant Name is read when the object is registered. The participants returned by GetParticipants are
+ * checked again and moved to their new name if it changed, if your participant changes its name call RefreshParticipant
+ * so that it is also found by the new name right away.
+ */
+UCLASS()
+class DLGSYSTEM_API UDlgParticipantRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Gets the registry of the World of WorldContextObject, nullptr if there is no World
+	static UDlgParticipantRegistry* Get(const UObject* WorldContextObject);
+
+	void Initialize(FSubsystemCollectionBase& Collection) override;
+	void Deinitialize() override;
+
+	// Adds the Participant (does nothing if it does not implement the Dialogue Participant Interface)
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Participants")
+	void RegisterParticipant(UObject* Participant);
+
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Participants")
+	void UnregisterParticipant(UObject* Participant);
+
+	// Reads again the Participant Name of the Participant
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Participants")
+	void RefreshParticipant(UObject* Participant) { RegisterParticipant(Participant); }
+
+	// Adds the Actor and all the participants referenced by its properties (components, etc)
+	// The participants inside the Actor are removed when the Actor is destroyed.
+	void RegisterActor(AActor* Actor);
+
+	// Gets the participants with the ParticipantName
+	void GetParticipants(FName ParticipantName, TArray<UObject*>& OutParticipants);
+
+	// Gets all the participants
+	TArray<UObject*> GetAllParticipants();
+
+	// Key: Participant Name
+	// Value: Participants with that name
+	TMap<FName, FDlgObjectsArray> GetParticipantsMap();
+
+	// Scans the whole World again
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Participants")
+	void Rebuild();
+
+	int32 GetNumParticipants() const { return ParticipantsNames.Num(); }
+
+protected:
+	void BuildIfNeeded()
+	{
+		if (!bBuilt)
+		{
+			Rebuild();
+		}
+		else
+		{
+			RegisterPendingActors();
+		}
+	}
+
+	// Registers the actors spawned since the last query
+	void RegisterPendingActors();
+
+	void AddParticipant(UObject* Participant, FName ParticipantName);
+	void RemoveParticipant(const UObject* Participant);
+
+	// Removes the participants inside Outer and the destroyed ones
+	void RemoveParticipantsIn(const UObject* Outer);
+
+	void HandleActorSpawned(AActor* Actor);
+
+	UFUNCTION()
+	void HandleActorDestroyed(AActor* Actor);
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+
+protected:
+	// Key: Participant Name
+	// Value: Participants with that name
+	TMap<FName, TArray<TWeakObjectPtr<UObject>>> ParticipantsByName;
+
+	// Key: Participant
+	// Value: the Participant Name it was registered with
+	TMap<FObjectKey, FName> ParticipantsNames;
+
+	// Actors spawned since the last query, see HandleActorSpawned
+	TArray<TWeakObjectPtr<AActor>> PendingActors;
+
+	// Was the World scanned?
+	bool bBuilt = false;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle LevelAddedToWorldHandle;
+	FDelegateHandle LevelRemovedFromWorldHandle;
+};
@@ -0,0 +1,145 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgParticipantValueCache.h"
+
+#include "DlgDialogueParticipant.h"
+#include "NYReflectionHelper.h"
+
+FName FDlgParticipantValueCache::GetParticipantName(const UObject* Participant)
+{
+	if (const FName* Name = ParticipantNames.Find(Participant))
+	{
+		return *Name;
+	}
+
+	return ParticipantNames.Add(Participant, IDlgDialogueParticipant::Execute_GetParticipantName(Participant));
+}
+
+bool FDlgParticipantValueCache::GetBoolValue(const UObject* Participant, FName ValueName)
+{
+	return FindOrRead(BoolValues, Participant, ValueName, [Participant, ValueName]()
+	{
+		return IDlgDialogueParticipant::Execute_GetBoolValue(Participant, ValueName);
+	});
+}
+
+float FDlgParticipantValueCache::GetFloatValue(const UObject* Participant, FName ValueName)
+{
+	return FindOrRead(FloatValues, Participant, ValueName, [Participant, ValueName]()
+	{
+		return IDlgDialogueParticipant::Execute_GetFloatValue(Participant, ValueName);
+	});
+}
+
+int32 FDlgParticipantValueCache::GetIntValue(const UObject* Participant, FName ValueName)
+{
+	return FindOrRead(IntValues, Participant, ValueName, [Participant, ValueName]()
+	{
+		return IDlgDialogueParticipant::Execute_GetIntValue(Participant, ValueName);
+	});
+}
+
+FName FDlgParticipantValueCache::GetNameValue(const UObject* Participant, FName ValueName)
+{
+	return FindOrRead(NameValues, Participant, ValueName, [Participant, ValueName]()
+	{
+		return IDlgDialogueParticipant::Execute_GetNameValue(Participant, ValueName);
+	});
+}
+
+bool FDlgParticipantValueCache::GetClassBoolVariable(const UObject* Participant, FName VariableName)
+{
+	return FindOrRead(ClassBoolVariables, Participant, VariableName, [Participant, VariableName]()
+	{
+		return FNYReflectionHelper::GetVariable<FBoolProperty, bool>(Participant, VariableName);
+	});
+}
+
+double FDlgParticipantValueCache::GetClassFloatVariable(const UObject* Participant, FName VariableName)
+{
+	return FindOrRead(ClassFloatVariables, Participant, VariableName, [Participant, VariableName]()
+	{
+		return FNYReflectionHelper::GetVariable<FDoubleProperty, double>(Participant, VariableName);
+	});
+}
+
+int32 FDlgParticipantValueCache::GetClassIntVariable(const UObject* Participant, FName VariableName)
+{
+	return FindOrRead(ClassIntVariables, Participant, VariableName, [Participant, VariableName]()
+	{
+		return FNYReflectionHelper::GetVariable<FIntProperty, int32>(Participant, VariableName);
+	});
+}
+
+FName FDlgParticipantValueCache::GetClassNameVariable(const UObject* Participant, FName VariableName)
+{
+	return FindOrRead(ClassNameVariables, Participant, VariableName, [Participant, VariableName]()
+	{
+		return FNYReflectionHelper::GetVariable<FNameProperty, FName>(Participant, VariableName);
+	});
+}
+
+void FDlgParticipantValueCache::Empty()
+{
+	ParticipantNames.Empty();
+	BoolValues.Empty();
+	FloatValues.Empty();
+	IntValues.Empty();
+	NameValues.Empty();
+	ClassBoolVariables.Empty();
+	ClassFloatVariables.Empty();
+	ClassIntVariables.Empty();
+	ClassNameVariables.Empty();
+}
+
+FName FDlgParticipantValueCache::GetParticipantName(FDlgParticipantValueCache* Cache, const UObject* Participant)
+{
+	return Cache ? Cache->GetParticipantName(Participant) : IDlgDialogueParticipant::Execute_GetParticipantName(Participant);
+}
+
+bool FDlgParticipantValueCache::GetBoolValue(FDlgParticipantValueCache* Cache, const UObject* Participant, FName ValueName)
+{
+	return Cache ? Cache->GetBoolValue(Participant, ValueName) : IDlgDialogueParticipant::Execute_GetBoolValue(Participant, ValueName);
+}
+
+float FDlgParticipantValueCache::GetFloatValue(FDlgParticipantValueCache* Cache, const UObject* Participant, FName ValueName)
+{
+	return Cache ? Cache->GetFloatValue(Participant, ValueName) : IDlgDialogueParticipant::Execute_GetFloatValue(Participant, ValueName);
+}
+
+int32 FDlgParticipantValueCache::GetIntValue(FDlgParticipantValueCache* Cache, const UObject* Participant, FName ValueName)
+{
+	return Cache ? Cache->GetIntValue(Participant, ValueName) : IDlgDialogueParticipant::Execute_GetIntValue(Participant, ValueName);
+}
+
+FName FDlgParticipantValueCache::GetNameValue(FDlgParticipantValueCache* Cache, const UObject* Participant, FName ValueName)
+{
+	return Cache ? Cache->GetNameValue(Participant, ValueName) : IDlgDialogueParticipant::Execute_GetNameValue(Participant, ValueName);
+}
+
+bool FDlgParticipantValueCache::GetClassBoolVariable(FDlgParticipantValueCache* Cache, const UObject* Participant, FName VariableName)
+{
+	return Cache
+		? Cache->GetClassBoolVariable(Participant, VariableName)
+		: FNYReflectionHelper::GetVariable<FBoolProperty, bool>(Participant, VariableName);
+}
+
+double FDlgParticipantValueCache::GetClassFloatVariable(FDlgParticipantValueCache* Cache, const UObject* Participant, FName VariableName)
+{
+	return Cache
+		? Cache->GetClassFloatVariable(Participant, VariableName)
+		: FNYReflectionHelper::GetVariable<FDoubleProperty, double>(Participant, VariableName);
+}
+
+int32 FDlgParticipantValueCache::GetClassIntVariable(FDlgParticipantValueCache* Cache, const UObject* Participant, FName VariableName)
+{
+	return Cache
+		? Cache->GetClassIntVariable(Participant, VariableName)
+		: FNYReflectionHelper::GetVariable<FIntProperty, int32>(Participant, VariableName);
+}
+
+FName FDlgParticipantValueCache::GetClassNameVariable(FDlgParticipantValueCache* Cache, const UObject* Participant, FName VariableName)
+{
+	return Cache
+		? Cache->GetClassNameVariable(Participant, VariableName)
+		: FNYReflectionHelper::GetVariable<FNameProperty, FName>(Participant, VariableName);
+}
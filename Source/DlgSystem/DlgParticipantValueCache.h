@@ -0,0 +1,72 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Values read by the conditions from the participants, shared between the evaluations of a batch
+ * (see UDlgManager::CanStartDialogues) so that each participant is asked only once for the same value.
+ *
+ * Only the values that do not depend on the context are cached: the participant names, the participant getters
+ * (GetBoolValue, GetIntValue, ...) and the class variables. Event calls and custom conditions are always evaluated.
+ * The cache must not outlive the batch, the values are not invalidated.
+ */
+class DLGSYSTEM_API FDlgParticipantValueCache
+{
+public:
+	FName GetParticipantName(const UObject* Participant);
+
+	bool GetBoolValue(const UObject* Participant, FName ValueName);
+	float GetFloatValue(const UObject* Participant, FName ValueName);
+	int32 GetIntValue(const UObject* Participant, FName ValueName);
+	FName GetNameValue(const UObject* Participant, FName ValueName);
+
+	bool GetClassBoolVariable(const UObject* Participant, FName VariableName);
+	double GetClassFloatVariable(const UObject* Participant, FName VariableName);
+	int32 GetClassIntVariable(const UObject* Participant, FName VariableName);
+	FName GetClassNameVariable(const UObject* Participant, FName VariableName);
+
+	void Empty();
+
+	// Same as the above, but reads the value directly from the Participant if Cache is nullptr
+	static FName GetParticipantName(FDlgParticipantValueCache* Cache, const UObject* Participant);
+
+	static bool GetBoolValue(FDlgParticipantValueCache* Cache, const UObject* Participant, FName ValueName);
+	static float GetFloatValue(FDlgParticipantValueCache* Cache, const UObject* Participant, FName ValueName);
+	static int32 GetIntValue(FDlgParticipantValueCache* Cache, const UObject* Participant, FName ValueName);
+	static FName GetNameValue(FDlgParticipantValueCache* Cache, const UObject* Participant, FName ValueName);
+
+	static bool GetClassBoolVariable(FDlgParticipantValueCache* Cache, const UObject* Participant, FName VariableName);
+	static double GetClassFloatVariable(FDlgParticipantValueCache* Cache, const UObject* Participant, FName VariableName);
+	static int32 GetClassIntVariable(FDlgParticipantValueCache* Cache, const UObject* Participant, FName VariableName);
+	static FName GetClassNameVariable(FDlgParticipantValueCache* Cache, const UObject* Participant, FName VariableName);
+
+private:
+	// Participant and the name of the value/variable
+	using FValueKey = TPair<const UObject*, FName>;
+
+	template <typename ValueType, typename GetterType>
+	static ValueType FindOrRead(TMap<FValueKey, ValueType>& Values, const UObject* Participant, FName ValueName, GetterType&& Getter)
+	{
+		const FValueKey Key(Participant, ValueName);
+		if (const ValueType* Value = Values.Find(Key))
+		{
+			return *Value;
+		}
+
+		return Values.Add(Key, Getter());
+	}
+
+private:
+	TMap<const UObject*, FName> ParticipantNames;
+
+	TMap<FValueKey, bool> BoolValues;
+	TMap<FValueKey, float> FloatValues;
+	TMap<FValueKey, int32> IntValues;
+	TMap<FValueKey, FName> NameValues;
+
+	TMap<FValueKey, bool> ClassBoolVariables;
+	TMap<FValueKey, double> ClassFloatVariables;
+	TMap<FValueKey, int32> ClassIntVariables;
+	TMap<FValueKey, FName> ClassNameVariables;
+};
@@ -0,0 +1,371 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgRuntimeGraph.h"
+
+#include "Algo/StableSort.h"
+#include "HAL/ThreadSafeCounter.h"
+
+#include "DlgContext.h"
+#include "DlgDialogue.h"
+#include "DlgVisitedNodes.h"
+#include "DlgNodeEvaluationCache.h"
+#include "Nodes/DlgNode.h"
+#include "Nodes/DlgNode_End.h"
+#include "Nodes/DlgNode_Proxy.h"
+#include "Nodes/DlgNode_Selector.h"
+#include "Nodes/DlgNode_Speech.h"
+#include "Nodes/DlgNode_SpeechSequence.h"
+
+void FDlgRuntimeGraph::Build(const UDlgDialogue& Dialogue)
+{
+	Reset();
+
+	const TArray<UDlgNode*>& DialogueNodes = Dialogue.GetNodes();
+	const int32 NodesNum = DialogueNodes.Num();
+	Nodes.Reserve(NodesNum);
+
+	int32 EdgesNum = 0;
+	for (const UDlgNode* Node : DialogueNodes)
+	{
+		// The visited nodes and the history are indexed through the GUIDs, they must match the node indices
+		if (!IsValid(Node) || Dialogue.GetNodeIndexForGUID(Node->GetGUID()) != Nodes.Num())
+		{
+			Reset();
+			return;
+		}
+		EdgesNum += Node->GetNodeChildren().Num();
+
+		FDlgRuntimeNode& RuntimeNode = Nodes.AddDefaulted_GetRef();
+		RuntimeNode.NodeGUID = Node->GetGUID();
+		RuntimeNode.OwnerName = Node->GetNodeParticipantName();
+		RuntimeNode.EnterRestriction = Node->GetEnterRestriction();
+		RuntimeNode.bCheckChildrenOnEvaluation = Node->GetCheckChildrenOnEvaluation();
+
+		// Only the node classes we know the evaluation of, anything else can override CheckNodeEnterConditions
+		const UClass* NodeClass = Node->GetClass();
+		if (NodeClass == UDlgNode_Proxy::StaticClass())
+		{
+			RuntimeNode.Type = EDlgRuntimeNodeType::Proxy;
+			RuntimeNode.ProxyTargetIndex = CastChecked<UDlgNode_Proxy>(Node)->GetTargetNodeIndex();
+		}
+		else if (NodeClass == UDlgNode_Speech::StaticClass() ||
+				 NodeClass == UDlgNode_SpeechSequence::StaticClass() ||
+				 NodeClass == UDlgNode_Selector::StaticClass() ||
+				 NodeClass == UDlgNode_End::StaticClass())
+		{
+			RuntimeNode.Type = EDlgRuntimeNodeType::Default;
+		}
+		else
+		{
+			RuntimeNode.Type = EDlgRuntimeNodeType::NodeObject;
+		}
+	}
+
+	// Fill the edges and conditions
+	Edges.Reserve(EdgesNum);
+	for (int32 NodeIndex = 0; NodeIndex < NodesNum; NodeIndex++)
+	{
+		const UDlgNode* Node = DialogueNodes[NodeIndex];
+		FDlgRuntimeNode& RuntimeNode = Nodes[NodeIndex];
+		if (RuntimeNode.Type == EDlgRuntimeNodeType::Proxy && !Nodes.IsValidIndex(RuntimeNode.ProxyTargetIndex))
+		{
+			// Let the node handle it
+			RuntimeNode.Type = EDlgRuntimeNodeType::NodeObject;
+		}
+
+		RuntimeNode.EnterConditions = AddConditions(Node->GetNodeEnterConditions(), RuntimeNode.OwnerName);
+
+		RuntimeNode.FirstEdge = Edges.Num();
+		for (const FDlgEdge& Edge : Node->GetNodeChildren())
+		{
+			// Invalid edges are never satisfied
+			if (!Edge.IsValid())
+			{
+				continue;
+			}
+
+			FDlgRuntimeEdge& RuntimeEdge = Edges.AddDefaulted_GetRef();
+			RuntimeEdge.TargetIndex = Edge.TargetIndex;
+			RuntimeEdge.Conditions = AddConditions(Edge.Conditions);
+		}
+		RuntimeNode.EdgesNum = Edges.Num() - RuntimeNode.FirstEdge;
+	}
+
+	Conditions.Shrink();
+	ConditionSlots.Shrink();
+
+	// Build can run from PostLoad on the async loading thread
+	// 0 means not built, skip it when the counter wraps around
+	static FThreadSafeCounter LastVersion;
+	do
+	{
+		Version = static_cast<uint32>(LastVersion.Increment());
+	} while (Version == 0);
+	bIsValid = true;
+}
+
+void FDlgRuntimeGraph::Reset()
+{
+	Nodes.Empty();
+	Edges.Empty();
+	Conditions.Empty();
+	ConditionSlots.Empty();
+	ParticipantNames.Empty();
+	Version = 0;
+	bIsValid = false;
+}
+
+int32 FDlgRuntimeGraph::GetConditionCost(const FDlgCondition& Condition)
+{
+	int32 Cost;
+	switch (Condition.ConditionType)
+	{
+		// Memory lookup
+		case EDlgConditionType::WasNodeVisited:
+			Cost = 0;
+			break;
+
+		// Property read, the properties are cached
+		case EDlgConditionType::ClassBoolVariable:
+		case EDlgConditionType::ClassFloatVariable:
+		case EDlgConditionType::ClassIntVariable:
+		case EDlgConditionType::ClassNameVariable:
+			Cost = 1;
+			break;
+
+		// Interface getters, can be implemented in Blueprint
+		case EDlgConditionType::BoolCall:
+		case EDlgConditionType::FloatCall:
+		case EDlgConditionType::IntCall:
+		case EDlgConditionType::NameCall:
+			Cost = 2;
+			break;
+
+		// Blueprint logic or a whole sub graph evaluation
+		case EDlgConditionType::EventCall:
+		case EDlgConditionType::HasSatisfiedChild:
+		case EDlgConditionType::Custom:
+		default:
+			Cost = 3;
+			break;
+	}
+
+	// The other value comes from an interface getter
+	if (Condition.IsSecondParticipantInvolved() && Condition.CompareType == EDlgCompare::ToVariable)
+	{
+		Cost = FMath::Max(Cost, 2);
+	}
+
+	return Cost;
+}
+
+FDlgRuntimeConditions FDlgRuntimeGraph::AddConditions(const TArray<FDlgCondition>& InConditions, FName DefaultParticipantName)
+{
+	FDlgRuntimeConditions RuntimeConditions;
+	RuntimeConditions.First = Conditions.Num();
+	if (InConditions.Num() == 0)
+	{
+		return RuntimeConditions;
+	}
+
+	// Strong conditions first, then cheap conditions first, keep the order of the user otherwise
+	TArray<int32, TInlineAllocator<16>> Order;
+	Order.Reserve(InConditions.Num());
+	for (int32 Index = 0; Index < InConditions.Num(); Index++)
+	{
+		Order.Add(Index);
+	}
+	Algo::StableSortBy(Order, [&InConditions](int32 Index)
+	{
+		const FDlgCondition& Condition = InConditions[Index];
+		const int32 StrengthOrder = Condition.Strength == EDlgConditionStrength::Weak ? 1 : 0;
+		return StrengthOrder * 16 + GetConditionCost(Condition);
+	});
+
+	for (const int32 Index : Order)
+	{
+		const FDlgCondition& Condition = InConditions[Index];
+		Conditions.Add(Condition);
+		if (Condition.Strength == EDlgConditionStrength::Weak)
+		{
+			RuntimeConditions.WeakNum++;
+		}
+		else
+		{
+			RuntimeConditions.StrongNum++;
+		}
+
+		// Same participant as FDlgCondition::EvaluateArray, the participant is not used by every condition type but is still passed
+		FDlgRuntimeConditionSlots& Slots = ConditionSlots.AddDefaulted_GetRef();
+		Slots.Participant = FindOrAddParticipantSlot(Condition.ParticipantName == NAME_None ? DefaultParticipantName : Condition.ParticipantName);
+		if (Condition.IsSecondParticipantInvolved())
+		{
+			Slots.OtherParticipant = FindOrAddParticipantSlot(Condition.OtherParticipantName);
+		}
+	}
+
+	return RuntimeConditions;
+}
+
+int16 FDlgRuntimeGraph::FindOrAddParticipantSlot(FName ParticipantName)
+{
+	const int32 Slot = ParticipantNames.AddUnique(ParticipantName);
+	check(Slot <= MAX_int16);
+	return static_cast<int16>(Slot);
+}
+
+bool FDlgRuntimeGraph::CheckNodeEnterConditions(const UDlgContext& Context, int32 NodeIndex, FDlgVisitedNodes& AlreadyVisitedNodes) const
+{
+	if (!Nodes.IsValidIndex(NodeIndex))
+	{
+		return false;
+	}
+
+	const FDlgRuntimeNode& Node = Nodes[NodeIndex];
+	if (Node.Type == EDlgRuntimeNodeType::NodeObject)
+	{
+		const UDlgNode* NodeObject = Context.GetNodeFromIndex(NodeIndex);
+		if (NodeObject == nullptr)
+		{
+			return false;
+		}
+
+		// Let the node handle the loop
+		if (AlreadyVisitedNodes.ContainsIndex(NodeIndex))
+		{
+			return NodeObject->CheckNodeEnterConditions(Context, AlreadyVisitedNodes);
+		}
+
+		return Context.GetNodeEvaluationCache().FindOrEvaluateEnterable(NodeIndex, [NodeObject, &Context, &AlreadyVisitedNodes]()
+		{
+			return NodeObject->CheckNodeEnterConditions(Context, AlreadyVisitedNodes);
+		});
+	}
+
+	if (AlreadyVisitedNodes.ContainsIndex(NodeIndex))
+	{
+		Context.GetNodeEvaluationCache().NotifyLoopCut();
+		return true;
+	}
+
+	return Context.GetNodeEvaluationCache().FindOrEvaluateEnterable(NodeIndex, [this, &Context, NodeIndex, &AlreadyVisitedNodes]()
+	{
+		return CheckNodeEnterConditionsUncached(Context, NodeIndex, AlreadyVisitedNodes);
+	});
+}
+
+bool FDlgRuntimeGraph::CheckNodeEnterConditionsUncached(const UDlgContext& Context, int32 NodeIndex, FDlgVisitedNodes& AlreadyVisitedNodes) const
+{
+	const FDlgRuntimeNode& Node = Nodes[NodeIndex];
+	{
+		const FDlgVisitedNodes::FScope VisitedScope(AlreadyVisitedNodes, NodeIndex);
+		if (!EvaluateConditions(Context, Node.EnterConditions))
+		{
+			return false;
+		}
+
+		switch (Node.EnterRestriction)
+		{
+			case EDlgEntryRestriction::None:
+				break;
+
+			case EDlgEntryRestriction::OncePerContext:
+				if (Context.IsNodeVisited(NodeIndex, Node.NodeGUID, true))
+				{
+					return false;
+				}
+				break;
+
+			case EDlgEntryRestriction::Once:
+				if (Context.IsNodeVisited(NodeIndex, Node.NodeGUID, false))
+				{
+					return false;
+				}
+				break;
+
+			default:
+				break;
+		}
+
+		if (Node.bCheckChildrenOnEvaluation && !HasAnySatisfiedChild(Context, NodeIndex, AlreadyVisitedNodes))
+		{
+			return false;
+		}
+	}
+
+	// The proxy checks its target after it is no longer visited, same as UDlgNode_Proxy
+	if (Node.Type == EDlgRuntimeNodeType::Proxy)
+	{
+		return CheckNodeEnterConditions(Context, Node.ProxyTargetIndex, AlreadyVisitedNodes);
+	}
+
+	return true;
+}
+
+bool FDlgRuntimeGraph::HasAnySatisfiedChild(const UDlgContext& Context, int32 NodeIndex, FDlgVisitedNodes& AlreadyVisitedNodes) const
+{
+	return Context.GetNodeEvaluationCache().FindOrEvaluateSatisfiedChild(NodeIndex, [this, &Context, NodeIndex, &AlreadyVisitedNodes]()
+	{
+		for (const FDlgRuntimeEdge& Edge : GetNodeEdges(Nodes[NodeIndex]))
+		{
+			// Found at least one valid child
+			if (EvaluateEdge(Context, Edge, AlreadyVisitedNodes))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	});
+}
+
+bool FDlgRuntimeGraph::EvaluateEdge(const UDlgContext& Context, const FDlgRuntimeEdge& Edge, FDlgVisitedNodes& AlreadyVisitedNodes) const
+{
+	// Check target node enter conditions
+	if (!CheckNodeEnterConditions(Context, Edge.TargetIndex, AlreadyVisitedNodes))
+	{
+		return false;
+	}
+
+	// Check this edge conditions
+	return EvaluateConditions(Context, Edge.Conditions);
+}
+
+bool FDlgRuntimeGraph::EvaluateConditions(const UDlgContext& Context, const FDlgRuntimeConditions& InConditions) const
+{
+	// All strong conditions must be satisfied
+	const int32 FirstWeak = InConditions.First + InConditions.StrongNum;
+	for (int32 ConditionIndex = InConditions.First; ConditionIndex < FirstWeak; ConditionIndex++)
+	{
+		if (!IsConditionMet(Context, ConditionIndex))
+		{
+			return false;
+		}
+	}
+
+	if (InConditions.WeakNum == 0)
+	{
+		return true;
+	}
+
+	// At least one weak condition must be satisfied
+	const int32 EndWeak = FirstWeak + InConditions.WeakNum;
+	for (int32 ConditionIndex = FirstWeak; ConditionIndex < EndWeak; ConditionIndex++)
+	{
+		if (IsConditionMet(Context, ConditionIndex))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FDlgRuntimeGraph::IsConditionMet(const UDlgContext& Context, int32 ConditionIndex) const
+{
+	const FDlgRuntimeConditionSlots& Slots = ConditionSlots[ConditionIndex];
+	return Conditions[ConditionIndex].IsConditionMet(
+		Context,
+		Context.GetRuntimeGraphParticipant(*this, Slots.Participant),
+		Context.GetRuntimeGraphParticipant(*this, Slots.OtherParticipant)
+	);
+}
@@ -0,0 +1,141 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "DlgCondition.h"
+
+class UDlgContext;
+class UDlgDialogue;
+class FDlgVisitedNodes;
+enum class EDlgEntryRestriction : uint8;
+
+// How a node of the runtime graph is evaluated
+enum class EDlgRuntimeNodeType : uint8
+{
+	// Enter conditions, entry restriction and optionally the children, see UDlgNode::CheckNodeEnterConditions
+	Default = 0,
+
+	// Same as Default + the enter conditions of the target node, see UDlgNode_Proxy::CheckNodeEnterConditions
+	Proxy,
+
+	// Unknown node class (e.g. user defined), the node UObject is asked
+	NodeObject
+};
+
+// Compiled condition array: a range inside FDlgRuntimeGraph::Conditions with the strong conditions first and the weak ones after,
+// each group ordered from the cheapest to the most expensive condition (see FDlgRuntimeGraph::GetConditionCost)
+struct DLGSYSTEM_API FDlgRuntimeConditions
+{
+	int32 Num() const { return StrongNum + WeakNum; }
+
+	int32 First = 0;
+	int32 StrongNum = 0;
+	int32 WeakNum = 0;
+};
+
+// Participants of a compiled condition, indices inside FDlgRuntimeGraph::GetParticipantNames, INDEX_NONE if not used
+struct DLGSYSTEM_API FDlgRuntimeConditionSlots
+{
+	int16 Participant = INDEX_NONE;
+	int16 OtherParticipant = INDEX_NONE;
+};
+
+// Edge of the runtime graph
+struct DLGSYSTEM_API FDlgRuntimeEdge
+{
+	int32 TargetIndex = INDEX_NONE;
+	FDlgRuntimeConditions Conditions;
+};
+
+// Node of the runtime graph, the edges and enter conditions are ranges inside the FDlgRuntimeGraph arrays
+struct DLGSYSTEM_API FDlgRuntimeNode
+{
+	FGuid NodeGUID;
+	FName OwnerName;
+
+	int32 FirstEdge = 0;
+	int32 EdgesNum = 0;
+	FDlgRuntimeConditions EnterConditions;
+
+	// Only used by EDlgRuntimeNodeType::Proxy
+	int32 ProxyTargetIndex = INDEX_NONE;
+
+	EDlgEntryRestriction EnterRestriction;
+	EDlgRuntimeNodeType Type = EDlgRuntimeNodeType::Default;
+	bool bCheckChildrenOnEvaluation = false;
+};
+
+/**
+ * Compact, read only representation of the Dialogue Nodes used to evaluate the enter conditions of the nodes without
+ * going through the node UObjects: contiguous node records, one edge array and one packed condition table.
+ *
+ * The condition arrays are compiled: the participant names are resolved to slots (resolved once per Context, see
+ * UDlgContext::GetRuntimeGraphParticipant), the cheap conditions are checked before the expensive ones (Blueprint calls,
+ * custom conditions) and the evaluation stops as soon as the result is known (first failed strong condition, first
+ * satisfied weak condition). The conditions are expected to not have side effects, some of them may not be called.
+ *
+ * Built by the Dialogue when it is loaded and every time its nodes are updated (see UDlgDialogue::RebuildRuntimeGraph).
+ * If it is not valid the evaluation falls back to the node UObjects.
+ */
+class DLGSYSTEM_API FDlgRuntimeGraph
+{
+public:
+	// Builds the graph from the Nodes of the Dialogue. The graph stays invalid if the nodes do not have valid GUIDs (not compiled)
+	void Build(const UDlgDialogue& Dialogue);
+	void Reset();
+
+	bool IsValid() const { return bIsValid; }
+
+	// Unique for each Build, 0 if not built. Used to know if something cached for this graph is still valid
+	uint32 GetVersion() const { return Version; }
+	bool IsValidNodeIndex(int32 NodeIndex) const { return Nodes.IsValidIndex(NodeIndex); }
+	int32 GetNodesNum() const { return Nodes.Num(); }
+	int32 GetEdgesNum() const { return Edges.Num(); }
+	int32 GetConditionsNum() const { return Conditions.Num(); }
+	const TArray<FName>& GetParticipantNames() const { return ParticipantNames; }
+
+	const FDlgRuntimeNode& GetNode(int32 NodeIndex) const { return Nodes[NodeIndex]; }
+	TArrayView<const FDlgRuntimeEdge> GetNodeEdges(const FDlgRuntimeNode& Node) const
+	{
+		return MakeArrayView(Edges.GetData() + Node.FirstEdge, Node.EdgesNum);
+	}
+
+	// Same as UDlgNode::CheckNodeEnterConditions for the node at NodeIndex
+	// The results are cached in the FDlgNodeEvaluationCache of the Context
+	bool CheckNodeEnterConditions(const UDlgContext& Context, int32 NodeIndex, FDlgVisitedNodes& AlreadyVisitedNodes) const;
+
+	// Same as UDlgNode::HasAnySatisfiedChild for the node at NodeIndex
+	bool HasAnySatisfiedChild(const UDlgContext& Context, int32 NodeIndex, FDlgVisitedNodes& AlreadyVisitedNodes) const;
+
+	// Same as FDlgEdge::Evaluate
+	bool EvaluateEdge(const UDlgContext& Context, const FDlgRuntimeEdge& Edge, FDlgVisitedNodes& AlreadyVisitedNodes) const;
+
+	// Same as FDlgCondition::EvaluateArray for the compiled conditions
+	bool EvaluateConditions(const UDlgContext& Context, const FDlgRuntimeConditions& InConditions) const;
+
+	// Relative cost of evaluating the Condition, the cheaper conditions are evaluated first
+	static int32 GetConditionCost(const FDlgCondition& Condition);
+
+private:
+	// CheckNodeEnterConditions without the cache and the loop detection, for the nodes that are not EDlgRuntimeNodeType::NodeObject
+	bool CheckNodeEnterConditionsUncached(const UDlgContext& Context, int32 NodeIndex, FDlgVisitedNodes& AlreadyVisitedNodes) const;
+
+	bool IsConditionMet(const UDlgContext& Context, int32 ConditionIndex) const;
+
+	// Compiles the Conditions into the packed table, DefaultParticipantName is used for the conditions without a participant
+	FDlgRuntimeConditions AddConditions(const TArray<FDlgCondition>& InConditions, FName DefaultParticipantName = NAME_None);
+	int16 FindOrAddParticipantSlot(FName ParticipantName);
+
+private:
+	TArray<FDlgRuntimeNode> Nodes;
+	TArray<FDlgRuntimeEdge> Edges;
+	TArray<FDlgCondition> Conditions;
+	TArray<FDlgRuntimeConditionSlots> ConditionSlots;
+
+	// Participant name for each slot
+	TArray<FName> ParticipantNames;
+
+	uint32 Version = 0;
+	bool bIsValid = false;
+};
@@ -10,6 +10,11 @@
 #include "HAL/FileManager.h"
 #include "GameFramework/Actor.h"
 #include "Engine/World.h"
+#include "NYEngineVersionHelpers.h"
+
+#if NY_ENGINE_VERSION >= 500
+#include "UObject/Reload.h"
+#endif
 
 #if WITH_GAMEPLAY_DEBUGGER
 #include "GameplayDebugger.h"
@@ -23,10 +28,14 @@
 #include "DlgConstants.h"
 #include "DlgManager.h"
 #include "DlgDialogue.h"
+#include "DlgNameIndex.h"
+#include "DlgGUIDRegistry.h"
+#include "DlgMemory.h"
 #include "GameplayDebugger/DlgGameplayDebuggerCategory.h"
 #include "GameplayDebugger/SDlgDataDisplay.h"
 #include "Logging/DlgLogger.h"
 #include "DlgHelper.h"
+#include "NYReflectionHelper.h"
 
 #define LOCTEXT_NAMESPACE "FDlgSystemModule"
 
@@ -43,6 +52,35 @@ void FDlgSystemModule::StartupModule()
 
 	OnPreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddRaw(this, &Self::HandleOnPreLoadMap);
 	OnPostLoadMapWithWorldHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &Self::HandleOnPostLoadMapWithWorld);
+	OnWorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &Self::HandleOnWorldCleanup);
+
+	// The cached properties of the class variables become invalid when the properties of the classes change.
+	// Garbage collected classes are detected by the cache itself, no need to clear it after every garbage collection.
+#if NY_ENGINE_VERSION >= 500
+	OnReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		FNYReflectionHelper::ClearPropertyCache();
+	});
+	OnObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([](const TMap<UObject*, UObject*>&)
+	{
+		FNYReflectionHelper::ClearPropertyCache();
+	});
+#else
+	// Hot reload loads the module again, see OnModulesChanged below
+	OnObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>&)
+	{
+		FNYReflectionHelper::ClearPropertyCache();
+	});
+#endif // NY_ENGINE_VERSION >= 500
+
+	// A loaded module can add new classes to the cached class names
+	OnModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([](FName, EModuleChangeReason Reason)
+	{
+		if (Reason == EModuleChangeReason::ModuleLoaded)
+		{
+			FNYReflectionHelper::ClearPropertyCache();
+		}
+	});
 
 	// Listen for deleted assets
 	// Maybe even check OnAssetRemoved if not loaded into memory?
@@ -53,6 +91,14 @@ void FDlgSystemModule::StartupModule()
 	OnAssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &Self::HandleOnAssetRemoved);
 	OnAssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &Self::HandleOnAssetRenamed);
 
+	// Keep the Dialogue asset index up to date, it is built once all the files are known
+	OnAssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &Self::HandleOnAssetAddedOrUpdated);
+	OnAssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &Self::HandleOnAssetAddedOrUpdated);
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		OnFilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &Self::HandleOnFilesLoaded);
+	}
+
 #if WITH_GAMEPLAY_DEBUGGER
 	// If the gameplay debugger is available, register the category and notify the editor about the changes
 	IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
@@ -128,6 +174,18 @@ void FDlgSystemModule::ShutdownModule()
 		{
 			AssetRegistry.OnAssetRenamed().Remove(OnAssetRenamedHandle);
 		}
+		if (OnAssetAddedHandle.IsValid())
+		{
+			AssetRegistry.OnAssetAdded().Remove(OnAssetAddedHandle);
+		}
+		if (OnAssetUpdatedHandle.IsValid())
+		{
+			AssetRegistry.OnAssetUpdated().Remove(OnAssetUpdatedHandle);
+		}
+		if (OnFilesLoadedHandle.IsValid())
+		{
+			AssetRegistry.OnFilesLoaded().Remove(OnFilesLoadedHandle);
+		}
 	}
 
 	if (OnPreLoadMapHandle.IsValid())
@@ -138,6 +196,30 @@ void FDlgSystemModule::ShutdownModule()
 	{
 		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(OnPostLoadMapWithWorldHandle);
 	}
+	if (OnWorldCleanupHandle.IsValid())
+	{
+		FWorldDelegates::OnWorldCleanup.Remove(OnWorldCleanupHandle);
+	}
+#if NY_ENGINE_VERSION >= 500
+	if (OnReloadCompleteHandle.IsValid())
+	{
+		FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(OnReloadCompleteHandle);
+	}
+	if (OnObjectsReinstancedHandle.IsValid())
+	{
+		FCoreUObjectDelegates::OnObjectsReinstanced.Remove(OnObjectsReinstancedHandle);
+	}
+#else
+	if (OnObjectsReinstancedHandle.IsValid())
+	{
+		FCoreUObjectDelegates::OnObjectsReplaced.Remove(OnObjectsReinstancedHandle);
+	}
+#endif // NY_ENGINE_VERSION >= 500
+	if (OnModulesChangedHandle.IsValid())
+	{
+		FModuleManager::Get().OnModulesChanged().Remove(OnModulesChangedHandle);
+	}
+	FNYReflectionHelper::ClearPropertyCache();
 
 	FDlgLogger::Get().Info(TEXT("DlgSystemModule: ShutdownModule"));
 	FDlgLogger::OnShutdown();
@@ -259,14 +341,28 @@ void FDlgSystemModule::HandleOnInMemoryAssetDeleted(UObject* DeletedObject)
 
 void FDlgSystemModule::HandleOnAssetRemoved(const FAssetData& RemovedAsset)
 {
+	FDlgNameIndex::Get().RemoveAsset(RemovedAsset.ToSoftObjectPath());
 	if (!RemovedAsset.IsAssetLoaded())
 	{
 		return;
 	}
+
+	if (UDlgDialogue* Dialogue = Cast<UDlgDialogue>(RemovedAsset.GetAsset()))
+	{
+		FDlgNameIndex::Get().RemoveDialogue(Dialogue);
+		FDlgGUIDRegistry::Get().Unregister(Dialogue);
+	}
 }
 
 void FDlgSystemModule::HandleOnAssetRenamed(const FAssetData& AssetRenamed, const FString& OldObjectPath)
 {
+	FDlgNameIndex& NameIndex = FDlgNameIndex::Get();
+	NameIndex.RemoveAsset(FSoftObjectPath(OldObjectPath));
+	if (NameIndex.AreAssetsBuilt() && UDlgManager::IsDialogueAsset(AssetRenamed))
+	{
+		NameIndex.UpdateAsset(AssetRenamed);
+	}
+
 	UObject* ObjectRenamed = AssetRenamed.GetAsset();
 	if (UDlgDialogue* Dialogue = Cast<UDlgDialogue>(ObjectRenamed))
 	{
@@ -274,6 +370,21 @@ void FDlgSystemModule::HandleOnAssetRenamed(const FAssetData& AssetRenamed, cons
 	}
 }
 
+void FDlgSystemModule::HandleOnAssetAddedOrUpdated(const FAssetData& AssetData)
+{
+	// Not built yet, the assets are added when it is built
+	FDlgNameIndex& NameIndex = FDlgNameIndex::Get();
+	if (NameIndex.AreAssetsBuilt() && UDlgManager::IsDialogueAsset(AssetData))
+	{
+		NameIndex.UpdateAsset(AssetData);
+	}
+}
+
+void FDlgSystemModule::HandleOnFilesLoaded()
+{
+	UDlgManager::RebuildDialogueAssetIndex();
+}
+
 void FDlgSystemModule::HandleDialogueDeleted(UDlgDialogue* DeletedDialogue)
 {
 	if (!IsValid(DeletedDialogue))
@@ -281,6 +392,8 @@ void FDlgSystemModule::HandleDialogueDeleted(UDlgDialogue* DeletedDialogue)
 		return;
 	}
 
+	FDlgNameIndex::Get().RemoveDialogue(DeletedDialogue);
+	FDlgGUIDRegistry::Get().Unregister(DeletedDialogue);
 	DeletedDialogue->DeleteAllTextFiles();
 }
 
@@ -291,6 +404,10 @@ void FDlgSystemModule::HandleDialogueRenamed(UDlgDialogue* RenamedDialogue, cons
 		return;
 	}
 
+	// The indices are keyed by the object, keep it in sync in case the asset was not indexed yet
+	FDlgNameIndex::Get().UpdateDialogue(*RenamedDialogue);
+	FDlgGUIDRegistry::Get().Register(*RenamedDialogue);
+
 	// Rename text file file to new location
 	const FString OldTextFilePathName = UDlgDialogue::GetTextFilePathNameFromAssetPathName(OldObjectPath);
 	if (OldTextFilePathName.IsEmpty())
@@ -335,6 +452,15 @@ void FDlgSystemModule::HandleOnPreLoadMap(const FString& MapName)
 	}
 }
 
+void FDlgSystemModule::HandleOnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	// The contexts still bound to these stores keep them alive
+	if (World)
+	{
+		FDlgMemory::Get().RemoveStoresIn(World);
+	}
+}
+
 void FDlgSystemModule::HandleOnPostLoadMapWithWorld(UWorld* LoadedWorld)
 {
 	// NOTE: only in NON editor game
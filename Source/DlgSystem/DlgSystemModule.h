@@ -45,6 +45,12 @@ private:
 	// Handle the event for when assets are renamed in the registry
 	void HandleOnAssetRenamed(const FAssetData& AssetRenamed, const FString& OldObjectPath);
 
+	// Handle the event for when assets are added to the registry or their tags changed. Updates the Dialogue asset index.
+	void HandleOnAssetAddedOrUpdated(const FAssetData& AssetData);
+
+	// Handle the event for when the asset registry finished loading the files. Builds the Dialogue asset index.
+	void HandleOnFilesLoaded();
+
 	// Handle the event after the Dialogue was deleted. Deletes the text file(s).
 	void HandleDialogueDeleted(UDlgDialogue* DeletedDialogue);
 
@@ -57,6 +63,9 @@ private:
 	// Handle event when a new map with world is loaded is loaded.
 	void HandleOnPostLoadMapWithWorld(UWorld* LoadedWorld);
 
+	// Handle event when a world is torn down. Removes the history stores of the owners inside it.
+	void HandleOnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
 private:
 	// True if the tab spawners have been registered for this module
 	bool bHasRegisteredTabSpawners = false;
@@ -77,7 +86,14 @@ private:
 	// Handlers
 	FDelegateHandle OnPreLoadMapHandle;
 	FDelegateHandle OnPostLoadMapWithWorldHandle;
+	FDelegateHandle OnWorldCleanupHandle;
 	FDelegateHandle OnInMemoryAssetDeletedHandle;
 	FDelegateHandle OnAssetRemovedHandle;
 	FDelegateHandle OnAssetRenamedHandle;
+	FDelegateHandle OnAssetAddedHandle;
+	FDelegateHandle OnAssetUpdatedHandle;
+	FDelegateHandle OnFilesLoadedHandle;
+	FDelegateHandle OnReloadCompleteHandle;
+	FDelegateHandle OnObjectsReinstancedHandle;
+	FDelegateHandle OnModulesChangedHandle;
 };
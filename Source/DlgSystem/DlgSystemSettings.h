@@ -134,6 +134,17 @@ enum class EDlgNoSatisfiedChildBehavior : uint8
 	ContinueDialogue
 };
 
+// Defines the history store the dialogue contexts use if they do not have a history owner, see FDlgMemory
+UENUM()
+enum class EDlgHistoryScope : uint8
+{
+	// One history shared by all the dialogues contexts
+	Global,
+
+	// Each World has its own history
+	World
+};
+
 // UDeveloperSettings classes are auto discovered https://wiki.unrealengine.com/CustomSettings
 UCLASS(Config = Engine, DefaultConfig, meta = (DisplayName = "Dialogue System Settings"))
 class DLGSYSTEM_API UDlgSystemSettings : public UDeveloperSettings
@@ -261,6 +272,21 @@ public:
 	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
 	EDlgNoSatisfiedChildBehavior NoSatisfiedChildBehavior;
 
+	// The history store used by the dialogue contexts that do not have a history owner set (see UDlgContext::SetHistoryOwner)
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
+	EDlgHistoryScope DefaultHistoryScope = EDlgHistoryScope::Global;
+
+	// If enabled the dialogue contexts started by UDlgManager are reused from a pool of the world (see UDlgContextPool).
+	// Call UDlgManager::ReleaseDialogueContext when you are done with a context to put it back into the pool.
+	// NOTE: only used in standalone games, the pooled contexts are outered to the pool so they can not replicate through
+	// the actor of the participant. The contexts of multiplayer Worlds or replicated participants are never pooled.
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
+	bool bPoolDialogueContexts = false;
+
+	// Maximum number of free contexts kept in the pool of each world
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere, meta = (EditCondition = "bPoolDialogueContexts", ClampMin = "0"))
+	int32 MaxPooledDialogueContexts = 64;
+
 
 	// The dialogue text format used for saving and reloading from text files.
 	UPROPERTY(Category = "Dialogue", Config, EditAnywhere, DisplayName = "Text Format")
@@ -398,6 +424,32 @@ public:
 	UPROPERTY(Category = "Logger", Config, EditAnywhere, AdvancedDisplay)
 	ENYLoggerLogLevel OpenMessageLogLevelsHigherThan = ENYLoggerLogLevel::NoLogging;
 
+	// All the log levels higher than this are not logged at all, the messages of those levels are not even built.
+	// NOTE: Errors are always logged, a value of ENYLoggerLogLevel::NoLogging or Error only keeps the errors
+	UPROPERTY(Category = "Logger", Config, EditAnywhere, AdvancedDisplay)
+	ENYLoggerLogLevel DiscardLogLevelsHigherThan = ENYLoggerLogLevel::Trace;
+
+	// Queue the log messages and output them in batches at the end of the frame instead of right away.
+	// The same message logged over and over (e.g. by a broken dialogue) is then rate limited and collapsed
+	UPROPERTY(Category = "Logger", Config, EditAnywhere)
+	bool bEnableAsyncLogging = false;
+
+	// Maximum number of times the same message is output in a second, 0 means unlimited
+	UPROPERTY(Category = "Logger", Config, EditAnywhere, AdvancedDisplay, meta = (EditCondition = "bEnableAsyncLogging", ClampMin = "0"))
+	int32 AsyncLogMaxSameMessagesPerSecond = 5;
+
+	// Maximum number of messages output at the end of a frame, the rest are output in the next frames. 0 means unlimited
+	UPROPERTY(Category = "Logger", Config, EditAnywhere, AdvancedDisplay, meta = (EditCondition = "bEnableAsyncLogging", ClampMin = "0"))
+	int32 AsyncLogMaxMessagesPerFrame = 100;
+
+	// Maximum number of messages waiting to be output, the new messages are dropped after this. 0 means unlimited
+	UPROPERTY(Category = "Logger", Config, EditAnywhere, AdvancedDisplay, meta = (EditCondition = "bEnableAsyncLogging", ClampMin = "0"))
+	int32 AsyncLogMaxQueuedMessages = 4096;
+
+	// Output the identical messages of a frame only once, with the number of repeats
+	UPROPERTY(Category = "Logger", Config, EditAnywhere, AdvancedDisplay, meta = (EditCondition = "bEnableAsyncLogging"))
+	bool bAsyncLogCollapseDuplicates = true;
+
 
 	// Should we hide the categories in the Dialogue browser that do not have any children?
 	UPROPERTY(Category = "Browser", Config, EditAnywhere)
@@ -17,10 +17,13 @@ FFormatArgumentValue FDlgTextArgument::ConstructFormatArgumentValue(const UDlgCo
 	const UObject* Participant = Context.GetParticipant(ValidParticipantName);
 	if (Participant == nullptr)
 	{
-		FDlgLogger::Get().Errorf(
-			TEXT("FAILED to construct text argument because the PARTICIPANT is INVALID (Supplied Participant = %s). \nContext:\n\t%s, DisplayString = %s, ParticipantName = %s, ArgumentType = %s"),
-			*ValidParticipantName.ToString(), *Context.GetContextString(), *DisplayString, *ParticipantName.ToString(), *ArgumentTypeToString(Type)
-		);
+		FDlgLogger::Get().ErrorLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("FAILED to construct text argument because the PARTICIPANT is INVALID (Supplied Participant = %s). \nContext:\n\t%s, DisplayString = %s, ParticipantName = %s, ArgumentType = %s"),
+				*ValidParticipantName.ToString(), *Context.GetContextString(), *DisplayString, *ParticipantName.ToString(), *ArgumentTypeToString(Type)
+			);
+		});
 		return FFormatArgumentValue(FText::FromString(TEXT("[CustomTextArgument is INVALID. Missing Participant. Check log]")));
 	}
 
@@ -50,10 +53,13 @@ FFormatArgumentValue FDlgTextArgument::ConstructFormatArgumentValue(const UDlgCo
 		case EDlgTextArgumentType::Custom:
 			if (CustomTextArgument == nullptr)
 			{
-				FDlgLogger::Get().Errorf(
-					TEXT("Custom Text Argument is INVALID. Returning Error Text. Context:\n\t%s, Participant = %s"),
-					*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
-				);
+				FDlgLogger::Get().ErrorLazy([&]()
+				{
+					return FString::Printf(
+						TEXT("Custom Text Argument is INVALID. Returning Error Text. Context:\n\t%s, Participant = %s"),
+						*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
+					);
+				});
 				return FFormatArgumentValue(FText::FromString(TEXT("[CustomTextArgument is INVALID. Missing Custom Text Argument. Check log]")));
 			}
 
@@ -65,6 +71,30 @@ FFormatArgumentValue FDlgTextArgument::ConstructFormatArgumentValue(const UDlgCo
 	}
 }
 
+FText FDlgTextArgument::ConstructFormattedText(
+	const FText& Text,
+	const FTextFormat& TextFormat,
+	const TArray<FDlgTextArgument>& Arguments,
+	const UDlgContext& Context,
+	FName NodeOwner
+)
+{
+	FFormatNamedArguments NamedArguments;
+	NamedArguments.Reserve(Arguments.Num());
+	for (const FDlgTextArgument& Argument : Arguments)
+	{
+		NamedArguments.Add(Argument.DisplayString, Argument.ConstructFormatArgumentValue(Context, NodeOwner));
+	}
+
+	// NOTE: the compiled format recompiles itself if the display string of the Text changes (e.g. culture change)
+	if (TextFormat.GetSourceText().IdenticalTo(Text))
+	{
+		return FText::AsCultureInvariant(FText::Format(TextFormat, MoveTemp(NamedArguments)));
+	}
+
+	return FText::AsCultureInvariant(FText::Format(FTextFormat(Text), MoveTemp(NamedArguments)));
+}
+
 void FDlgTextArgument::UpdateTextArgumentArray(const FText& Text, TArray<FDlgTextArgument>& InOutArgumentArray)
 {
 	TArray<FString> NewArgumentParams;
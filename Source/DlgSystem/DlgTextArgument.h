@@ -78,6 +78,22 @@ public:
 	// Helper method to update the array InOutArgumentArray with the new arguments from Text.
 	static void UpdateTextArgumentArray(const FText& Text, TArray<FDlgTextArgument>& InOutArgumentArray);
 
+	// Compiles the format pattern of Text, so that ConstructFormattedText does not have to parse it every time.
+	// Returns an empty format if there are no Arguments.
+	static FTextFormat CompileTextFormat(const FText& Text, const TArray<FDlgTextArgument>& Arguments)
+	{
+		return Arguments.Num() > 0 ? FTextFormat(Text) : FTextFormat();
+	}
+
+	// Formats Text with the Arguments using TextFormat if it was compiled from Text (see CompileTextFormat)
+	static FText ConstructFormattedText(
+		const FText& Text,
+		const FTextFormat& TextFormat,
+		const TArray<FDlgTextArgument>& Arguments,
+		const UDlgContext& Context,
+		FName NodeOwner
+	);
+
 	static FString ArgumentTypeToString(EDlgTextArgumentType Type);
 
 public:
@@ -0,0 +1,89 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgVisitedNodes.h"
+
+#include "DlgDialogue.h"
+#include "Nodes/DlgNode.h"
+
+bool FDlgVisitedNodes::Contains(const UDlgNode* Node) const
+{
+	const int32 NodeIndex = GetNodeIndex(Node);
+	if (NodeIndex == INDEX_NONE)
+	{
+		return NodesWithoutIndex.Contains(Node);
+	}
+
+	return ContainsIndex(NodeIndex);
+}
+
+bool FDlgVisitedNodes::Add(const UDlgNode* Node)
+{
+	const int32 NodeIndex = GetNodeIndex(Node);
+	if (NodeIndex == INDEX_NONE)
+	{
+		if (NodesWithoutIndex.Contains(Node))
+		{
+			return false;
+		}
+
+		NodesWithoutIndex.Add(Node);
+		NodesNum++;
+		return true;
+	}
+
+	return AddIndex(NodeIndex);
+}
+
+bool FDlgVisitedNodes::AddIndex(int32 NodeIndex)
+{
+	check(NodeIndex >= 0);
+	if (NodeIndex >= NodesBits.Num())
+	{
+		NodesBits.Add(false, NodeIndex + 1 - NodesBits.Num());
+	}
+	if (NodesBits[NodeIndex])
+	{
+		return false;
+	}
+
+	NodesBits[NodeIndex] = true;
+	NodesNum++;
+	return true;
+}
+
+void FDlgVisitedNodes::Remove(const UDlgNode* Node)
+{
+	const int32 NodeIndex = GetNodeIndex(Node);
+	if (NodeIndex == INDEX_NONE)
+	{
+		NodesNum -= NodesWithoutIndex.RemoveSingleSwap(Node);
+		return;
+	}
+
+	RemoveIndex(NodeIndex);
+}
+
+void FDlgVisitedNodes::RemoveIndex(int32 NodeIndex)
+{
+	if (NodesBits.IsValidIndex(NodeIndex) && NodesBits[NodeIndex])
+	{
+		NodesBits[NodeIndex] = false;
+		NodesNum--;
+	}
+}
+
+int32 FDlgVisitedNodes::GetNodeIndex(const UDlgNode* Node) const
+{
+	if (!Node || !Dialogue)
+	{
+		return INDEX_NONE;
+	}
+
+	// Make sure the index really belongs to this Node, the GUID can be missing or stale if the Dialogue was not compiled
+	const int32 NodeIndex = Dialogue->GetNodeIndexForGUID(Node->GetGUID());
+	if (Dialogue->GetMutableNodeFromIndex(NodeIndex) != Node)
+	{
+		return INDEX_NONE;
+	}
+
+	return NodeIndex;
+}
@@ -0,0 +1,91 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/BitArray.h"
+
+class UDlgNode;
+class UDlgDialogue;
+
+/**
+ * Set of nodes used to detect loops while evaluating/entering the nodes of a Dialogue in a single step.
+ * Indexed by the index of the node in the Dialogue Nodes array and stored inline, so it does not allocate any memory
+ * for Dialogues with less than InlineNodesNum nodes.
+ *
+ * It is passed by reference through the whole evaluation: each node adds itself when the evaluation enters it and removes
+ * itself when it leaves (see FScope), this way every branch only sees the nodes of its own path.
+ */
+class DLGSYSTEM_API FDlgVisitedNodes
+{
+public:
+	// Adds the Node for the lifetime of the scope, if it was not already added
+	class FScope
+	{
+	public:
+		FScope(FDlgVisitedNodes& InVisitedNodes, const UDlgNode* InNode)
+			: VisitedNodes(InVisitedNodes), Node(InNode), bAdded(InVisitedNodes.Add(InNode)) {}
+		FScope(FDlgVisitedNodes& InVisitedNodes, int32 InNodeIndex)
+			: VisitedNodes(InVisitedNodes), NodeIndex(InNodeIndex), bAdded(InVisitedNodes.AddIndex(InNodeIndex)) {}
+		~FScope()
+		{
+			if (!bAdded)
+			{
+				return;
+			}
+
+			if (Node)
+			{
+				VisitedNodes.Remove(Node);
+			}
+			else
+			{
+				VisitedNodes.RemoveIndex(NodeIndex);
+			}
+		}
+
+	private:
+		FDlgVisitedNodes& VisitedNodes;
+		const UDlgNode* Node = nullptr;
+		int32 NodeIndex = INDEX_NONE;
+		bool bAdded;
+	};
+
+public:
+	explicit FDlgVisitedNodes(const UDlgDialogue* InDialogue) : Dialogue(InDialogue) {}
+
+	// Only one set should exist per evaluation
+	FDlgVisitedNodes(const FDlgVisitedNodes&) = delete;
+	FDlgVisitedNodes& operator=(const FDlgVisitedNodes&) = delete;
+
+	bool Contains(const UDlgNode* Node) const;
+
+	// Returns true if the Node was added, false if the Node was already in the set
+	bool Add(const UDlgNode* Node);
+	void Remove(const UDlgNode* Node);
+
+	// Same as above but with the index of the node in the Dialogue Nodes array, must be a valid index
+	bool ContainsIndex(int32 NodeIndex) const { return NodesBits.IsValidIndex(NodeIndex) && NodesBits[NodeIndex]; }
+	bool AddIndex(int32 NodeIndex);
+	void RemoveIndex(int32 NodeIndex);
+
+	bool IsEmpty() const { return NodesNum == 0; }
+	int32 Num() const { return NodesNum; }
+
+public:
+	static constexpr int32 InlineNodesNum = 512;
+
+private:
+	// Returns INDEX_NONE if the Node does not have a valid index (e.g. the Dialogue was not compiled)
+	int32 GetNodeIndex(const UDlgNode* Node) const;
+
+private:
+	const UDlgDialogue* Dialogue = nullptr;
+
+	// Bit for each node index
+	TBitArray<TInlineAllocator<InlineNodesNum / NumBitsPerDWORD>> NodesBits;
+
+	// Nodes that do not have a valid index, should be rare
+	TArray<const UDlgNode*, TInlineAllocator<4>> NodesWithoutIndex;
+
+	int32 NodesNum = 0;
+};
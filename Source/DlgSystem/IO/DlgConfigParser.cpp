@@ -12,6 +12,36 @@
 
 DEFINE_LOG_CATEGORY(LogDlgConfigParser);
 
+// Null terminated copy of a (short) word for the FCString number conversions, without allocating an FString
+class FDlgConfigNumberBuffer
+{
+public:
+	explicit FDlgConfigNumberBuffer(FStringView Word)
+	{
+		if (Word.Len() < NY_ARRAY_COUNT(Buffer))
+		{
+			FMemory::Memcpy(Buffer, Word.GetData(), Word.Len() * sizeof(TCHAR));
+			Buffer[Word.Len()] = TEXT('\0');
+			Data = Buffer;
+		}
+		else
+		{
+			LongWord = FString(Word.Len(), Word.GetData());
+			Data = *LongWord;
+		}
+	}
+
+	const TCHAR* Get() const { return Data; }
+
+	// Same as FString::IsNumeric
+	bool IsNumeric() const { return *Data != TEXT('\0') && FCString::IsNumeric(Data); }
+
+private:
+	TCHAR Buffer[64];
+	FString LongWord;
+	const TCHAR* Data = nullptr;
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 FDlgConfigParser::FDlgConfigParser(const FString InPreTag) :
 	PreTag(InPreTag)
@@ -33,6 +63,7 @@ void FDlgConfigParser::InitializeParser(const FString& FilePath)
 	From = 0;
 	Len = 0;
 	bHasValidWord = false;
+	ResetLineNumber();
 
 	if (!FFileHelper::LoadFileToString(String, *FilePath))
 	{
@@ -55,6 +86,7 @@ void FDlgConfigParser::InitializeParserFromString(const FString& Text)
 	From = 0;
 	Len = 0;
 	bHasValidWord = false;
+	ResetLineNumber();
 	FindNextWord();
 }
 
@@ -70,6 +102,7 @@ void FDlgConfigParser::ResetParser()
 	From = 0;
 	Len = 0;
 	bHasValidWord = false;
+	ResetLineNumber();
 	FindNextWord();
 }
 
@@ -82,8 +115,9 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 	}
 	check(From < String.Len());
 
-	const FString PropertyName = GetActiveWord();
-	auto* PropertyBase = ReferenceClass->FindPropertyByName(*PropertyName);
+	// Views into String, they stay valid while we advance
+	const FStringView PropertyName = GetWordView();
+	auto* PropertyBase = FindPropertyByNameCached(ReferenceClass, PropertyName);
 	if (PropertyBase != nullptr)
 	{
 		// check primitive types and enums
@@ -107,7 +141,7 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 		}
 	}
 
-	auto* ComplexPropBase = ReferenceClass->FindPropertyByName(*PropertyName);
+	auto* ComplexPropBase = PropertyBase;
 
 	// struct
 	if (auto* StructProperty = FNYReflectionHelper::SmartCastProperty<FStructProperty>(ComplexPropBase))
@@ -120,14 +154,14 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 	}
 
 	// check complex object - type name has to be here as well (dynamic array)
-	const FString TypeName = PreTag + PropertyName;
+	const FString TypeName = PreTag + FString(PropertyName.Len(), PropertyName.GetData());
 	if (!FindNextWord("block name"))
 	{
 		return false;
 	}
 
 	const bool bLoadByRef = IsNextWordString();
-	const FString VariableName = GetActiveWord();
+	const FStringView VariableName = GetWordView();
 
 	// check if it is stored as reference
 	if (bLoadByRef)
@@ -140,9 +174,10 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 
 		auto* ObjectPtrPtr = static_cast<UObject**>(ComplexPropBase->template ContainerPtrToValuePtr<void>(TargetObject));
 		*ObjectPtrPtr = nullptr; // reset first
-		if (!VariableName.TrimStartAndEnd().IsEmpty()) // null reference?
+		const FString Path(VariableName.Len(), VariableName.GetData());
+		if (!Path.TrimStartAndEnd().IsEmpty()) // null reference?
 		{
-			*ObjectPtrPtr = StaticLoadObject(UObject::StaticClass(), DefaultObjectOuter, *VariableName);
+			*ObjectPtrPtr = StaticLoadObject(UObject::StaticClass(), DefaultObjectOuter, *Path);
 		}
 		FindNextWord();
 		return true;
@@ -151,13 +186,9 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 	// UObject is in the format:
 	// - not nullptr - UObjectType PropertyName
 	// - nullptr - PropertyName ""
-	if (bHasNullptr)
+	if (!bHasNullptr)
 	{
-		ComplexPropBase = ReferenceClass->FindPropertyByName(*PropertyName);
-	}
-	else
-	{
-		ComplexPropBase = ReferenceClass->FindPropertyByName(*VariableName);
+		ComplexPropBase = FindPropertyByNameCached(ReferenceClass, VariableName);
 	}
 	if (auto* ObjectProperty = FNYReflectionHelper::SmartCastProperty<FObjectProperty>(ComplexPropBase))
 	{
@@ -166,27 +197,59 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 		{
 			return false;
 		}
-		auto ObjectInitializer = std::bind(&FDlgConfigParser::OnInitObject, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+		auto ObjectInitializer = [this](void* ValuePtr, const UClass* ChildClass, UObject* OuterInit)
+		{
+			return OnInitObject(ValuePtr, ChildClass, OuterInit);
+		};
 		return ReadComplexProperty<FObjectProperty>(TargetObject, ComplexPropBase, Class, ObjectInitializer, DefaultObjectOuter);
 	}
 
 	UE_LOG(LogDlgConfigParser, Warning, TEXT("Invalid token `%s` in script `%s` (line: %d) (Property expected for PropertyName = `%s`)"),
-		   *GetActiveWord(), *FileName, GetActiveLineNumber(), *PropertyName);
+		   *GetActiveWord(), *FileName, GetActiveLineNumber(), *FString(PropertyName.Len(), PropertyName.GetData()));
 	FindNextWord();
 	return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+FProperty* FDlgConfigParser::FindPropertyByNameCached(const UStruct* ReferenceClass, FStringView PropertyName)
+{
+	// Do not pollute the name table with every word of the config
+	const FName Name(PropertyName.Len(), PropertyName.GetData(), FNAME_Find);
+	if (Name.IsNone())
+	{
+		return nullptr;
+	}
+
+	TMap<FName, FProperty*>* Properties = StructPropertiesCache.Find(ReferenceClass);
+	if (Properties == nullptr)
+	{
+		Properties = &StructPropertiesCache.Add(ReferenceClass);
+		for (TFieldIterator<FProperty> It(ReferenceClass); It; ++It)
+		{
+			// Keep the first one like FindPropertyByName
+			if (!Properties->Contains(It->GetFName()))
+			{
+				Properties->Add(It->GetFName(), *It);
+			}
+		}
+	}
+
+	FProperty** PropertyPtr = Properties->Find(Name);
+	return PropertyPtr != nullptr ? *PropertyPtr : nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgConfigParser::ReadPurePropertyBlock(void* TargetObject, const UStruct* ReferenceClass, bool bBlockStartAlreadyRead, UObject* Outer)
 {
-	if (!bBlockStartAlreadyRead && !FindNextWordAndCheckIfBlockStart(ReferenceClass->GetName()))
+	const FString BlockName = ReferenceClass->GetName();
+	if (!bBlockStartAlreadyRead && !FindNextWordAndCheckIfBlockStart(*BlockName))
 	{
 		return false;
 	}
 
 	// parse precondition properties
 	FindNextWord();
-	while (!CheckIfBlockEnd(ReferenceClass->GetName()))
+	while (!CheckIfBlockEnd(*BlockName))
 	{
 		if (!bHasValidWord)
 		{
@@ -208,13 +271,13 @@ bool FDlgConfigParser::GetActiveWordAsFloat(float& FloatValue) const
 		return false;
 	}
 
-	const FString FloatString = String.Mid(From, Len);
-	if (FloatString.Len() == 0 || !FloatString.IsNumeric())
+	const FDlgConfigNumberBuffer FloatString(GetWordView());
+	if (!FloatString.IsNumeric())
 	{
 		return false;
 	}
 
-	FloatValue = FCString::Atof(*FloatString);
+	FloatValue = FCString::Atof(FloatString.Get());
 	return true;
 }
 
@@ -226,13 +289,13 @@ bool FDlgConfigParser::GetActiveWordAsDouble(double& DoubleValue) const
 		return false;
 	}
 
-	const FString DoubleString = String.Mid(From, Len);
-	if (DoubleString.Len() == 0 || !DoubleString.IsNumeric())
+	const FDlgConfigNumberBuffer DoubleString(GetWordView());
+	if (!DoubleString.IsNumeric())
 	{
 		return false;
 	}
 
-	DoubleValue = FCString::Atod(*DoubleString);
+	DoubleValue = FCString::Atod(DoubleString.Get());
 	return true;
 }
 
@@ -378,43 +441,43 @@ bool FDlgConfigParser::FindNextWord(const FString& ExpectedStuff)
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool FDlgConfigParser::FindNextWordAndCheckIfBlockStart(const FString& BlockName)
+bool FDlgConfigParser::FindNextWordAndCheckIfBlockStart(const TCHAR* BlockName)
 {
-	if (!FindNextWord() || !CompareToActiveWord("{"))
+	if (!FindNextWord() || !CompareToActiveWord(TEXT("{")))
 	{
 		UE_LOG(LogDlgConfigParser, Warning, TEXT("Block start signal expected but not found for %s block in script %s (line: %d)"),
-											*BlockName, *FileName, GetActiveLineNumber());
+											BlockName, *FileName, GetActiveLineNumber());
 		return false;
 	}
 	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool FDlgConfigParser::FindNextWordAndCheckIfBlockEnd(const FString& BlockName)
+bool FDlgConfigParser::FindNextWordAndCheckIfBlockEnd(const TCHAR* BlockName)
 {
 	if (!FindNextWord())
 	{
 		UE_LOG(LogDlgConfigParser, Warning, TEXT("End of file found but block %s is not yet closed in script %s (line: %d)"),
-											*BlockName, *FileName, GetActiveLineNumber());
+											BlockName, *FileName, GetActiveLineNumber());
 		return false;
 	}
 	return Len == 1 && String[From] == '}';
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool FDlgConfigParser::CheckIfBlockEnd(const FString& BlockName)
+bool FDlgConfigParser::CheckIfBlockEnd(const TCHAR* BlockName)
 {
 	if (!bHasValidWord)
 	{
 		UE_LOG(LogDlgConfigParser, Warning, TEXT("End of file found but block %s is not yet closed in script %s (line: %d)"),
-											*BlockName, *FileName, GetActiveLineNumber());
+											BlockName, *FileName, GetActiveLineNumber());
 		return false;
 	}
 	return Len == 1 && String[From] == '}';
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool FDlgConfigParser::CompareToActiveWord(const FString& StringToCompare) const
+bool FDlgConfigParser::CompareToActiveWord(FStringView StringToCompare) const
 {
 	// Length differs?
 	if (!bHasValidWord || StringToCompare.Len() != Len)
@@ -443,15 +506,15 @@ int32 FDlgConfigParser::GetActiveLineNumber() const
 		return INDEX_NONE;
 	}
 
-	int32 LineCount = 1;
-	for (int32 i = 0; i < String.Len() && i < From; ++i)
+	// From only moves forward, continue from where the last call stopped
+	for (; LineCountIndex < String.Len() && LineCountIndex < From; ++LineCountIndex)
 	{
-		switch (String[i])
+		switch (String[LineCountIndex])
 		{
 			case '\r':
 				// let's handle '\r\n too
-				if (i + 1 < String.Len() && String[i + 1] == '\n')
-					++i;
+				if (LineCountIndex + 1 < String.Len() && String[LineCountIndex + 1] == '\n')
+					++LineCountIndex;
 			case '\n':
 				++LineCount;
 				break;
@@ -480,35 +543,35 @@ void FDlgConfigParser::ConstructConfigFileInternal(const UStruct* ReferenceType,
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgConfigParser::TryToReadPrimitiveProperty(void* TargetObject, FProperty* PropertyBase)
 {
-	if (ReadPrimitiveProperty<bool, FBoolProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsBool, this), "Bool", false))
+	if (ReadPrimitiveProperty<bool, FBoolProperty>(TargetObject, PropertyBase, [this]() { return GetAsBool(); }, TEXT("Bool"), false))
 	{
 		return true;
 	}
-	if (ReadPrimitiveProperty<float, FFloatProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsFloat, this), "float", false))
+	if (ReadPrimitiveProperty<float, FFloatProperty>(TargetObject, PropertyBase, [this]() { return GetAsFloat(); }, TEXT("float"), false))
 	{
 		return true;
 	}
-	if (ReadPrimitiveProperty<double, FDoubleProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsDouble, this), "double", false))
+	if (ReadPrimitiveProperty<double, FDoubleProperty>(TargetObject, PropertyBase, [this]() { return GetAsDouble(); }, TEXT("double"), false))
 	{
 		return true;
 	}
-	if (ReadPrimitiveProperty<int32, FIntProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsInt32, this), "int32", false))
+	if (ReadPrimitiveProperty<int32, FIntProperty>(TargetObject, PropertyBase, [this]() { return GetAsInt32(); }, TEXT("int32"), false))
 	{
 		return true;
 	}
-	if (ReadPrimitiveProperty<int64, FInt64Property>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsInt64, this), "int64", false))
+	if (ReadPrimitiveProperty<int64, FInt64Property>(TargetObject, PropertyBase, [this]() { return GetAsInt64(); }, TEXT("int64"), false))
 	{
 		return true;
 	}
-	if (ReadPrimitiveProperty<FName, FNameProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsName, this), "FName", false))
+	if (ReadPrimitiveProperty<FName, FNameProperty>(TargetObject, PropertyBase, [this]() { return GetAsName(); }, TEXT("FName"), false))
 	{
 		return true;
 	}
-	if (ReadPrimitiveProperty<FString, FStrProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsString, this), "FString", true))
+	if (ReadPrimitiveProperty<FString, FStrProperty>(TargetObject, PropertyBase, [this]() { return GetAsString(); }, TEXT("FString"), true))
 	{
 		return true;
 	}
-	if (ReadPrimitiveProperty<FText, FTextProperty>(TargetObject, PropertyBase, std::bind(&FDlgConfigParser::GetAsText, this), "FText", true))
+	if (ReadPrimitiveProperty<FText, FTextProperty>(TargetObject, PropertyBase, [this]() { return GetAsText(); }, TEXT("FText"), true))
 	{
 		return true;
 	}
@@ -528,7 +591,8 @@ bool FDlgConfigParser::TryToReadEnum(void* Target, FProperty* PropertyBase)
 		}
 		else
 		{
-			Value = FName(*String.Mid(From, Len));
+			const FStringView Word = GetWordView();
+			Value = FName(Word.Len(), Word.GetData());
 		}
 
 		auto* Prop = FNYReflectionHelper::SmartCastProperty<FEnumProperty>(PropertyBase);
@@ -570,12 +634,12 @@ bool FDlgConfigParser::ReadSet(void* TargetObject, FSetProperty& Property, UObje
 	FScriptSetHelper Helper(&Property, Property.ContainerPtrToValuePtr<uint8>(TargetObject));
 	Helper.EmptyElements();
 
-	if (!FindNextWordAndCheckIfBlockStart("Set block"))
+	if (!FindNextWordAndCheckIfBlockStart(TEXT("Set block")))
 	{
 		return false;
 	}
 
-	while (!FindNextWordAndCheckIfBlockEnd("Set block"))
+	while (!FindNextWordAndCheckIfBlockEnd(TEXT("Set block")))
 	{
 		const int32 Index = Helper.AddDefaultValue_Invalid_NeedsRehash();
 		bool bDone = false;
@@ -608,12 +672,12 @@ bool FDlgConfigParser::ReadMap(void* TargetObject, FMapProperty& Property, UObje
 	FScriptMapHelper Helper(&Property, Property.ContainerPtrToValuePtr<uint8>(TargetObject));
 	Helper.EmptyValues();
 
-	if (!FindNextWordAndCheckIfBlockStart("Map block") || !FindNextWord("map entry"))
+	if (!FindNextWordAndCheckIfBlockStart(TEXT("Map block")) || !FindNextWord("map entry"))
 	{
 		return false;
 	}
 
-	while (!CheckIfBlockEnd("Map block"))
+	while (!CheckIfBlockEnd(TEXT("Map block")))
 	{
 		const int32 Index = Helper.AddDefaultValue_Invalid_NeedsRehash();
 		void* Ptrs[] = { Helper.GetKeyPtr(Index), Helper.GetValuePtr(Index) };
@@ -636,7 +700,7 @@ bool FDlgConfigParser::ReadMap(void* TargetObject, FMapProperty& Property, UObje
 			auto* StructVal = FNYReflectionHelper::CastProperty<FStructProperty>(Props[i]);
 			if (StructVal != nullptr)
 			{
-				if (!CompareToActiveWord("{"))
+				if (!CompareToActiveWord(TEXT("{")))
 				{
 					UE_LOG(LogDlgConfigParser, Warning, TEXT("Syntax error: missing struct block start '{' in script %s(:%d)"),
 							*FileName, GetActiveLineNumber());
@@ -723,9 +787,9 @@ void FDlgConfigParser::OnInvalidValue(const FString& PropType) const
 bool FDlgConfigParser::GetAsBool() const
 {
 	bool bValue = false;
-	if (CompareToActiveWord("True"))
+	if (CompareToActiveWord(TEXT("True")))
 		bValue = true;
-	else if (!CompareToActiveWord("False"))
+	else if (!CompareToActiveWord(TEXT("False")))
 		OnInvalidValue("Bool");
 	return bValue;
 }
@@ -750,11 +814,11 @@ double FDlgConfigParser::GetAsDouble() const
 int32 FDlgConfigParser::GetAsInt32() const
 {
 	int32 Value = 0;
-	const FString IntString = String.Mid(From, Len);
-	if (IntString.Len() == 0 || (!IntString.IsNumeric()))
+	const FDlgConfigNumberBuffer IntString(GetWordView());
+	if (!IntString.IsNumeric())
 		OnInvalidValue("int32");
 	else
-		Value = FCString::Atoi(*IntString);
+		Value = FCString::Atoi(IntString.Get());
 	return Value;
 }
 
@@ -762,11 +826,11 @@ int32 FDlgConfigParser::GetAsInt32() const
 int64 FDlgConfigParser::GetAsInt64() const
 {
 	int64 Value = 0;
-	const FString IntString = String.Mid(From, Len);
-	if (IntString.Len() == 0 || (!IntString.IsNumeric()))
+	const FDlgConfigNumberBuffer IntString(GetWordView());
+	if (!IntString.IsNumeric())
 		OnInvalidValue("int64");
 	else
-		Value = FCString::Atoi64(*IntString);
+		Value = FCString::Atoi64(IntString.Get());
 	return Value;
 }
 
@@ -777,7 +841,10 @@ FName FDlgConfigParser::GetAsName() const
 	if (Len <= 0)
 		OnInvalidValue("FName");
 	else
-		Value = FName(*String.Mid(From, Len));
+	{
+		const FStringView Word = GetWordView();
+		Value = FName(Word.Len(), Word.GetData());
+	}
 	return Value;
 }
 
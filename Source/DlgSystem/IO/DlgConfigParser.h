@@ -1,9 +1,10 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #pragma once
 
-#include <functional>
 #include "CoreTypes.h"
 #include "Logging/LogMacros.h"
+#include "Containers/StringView.h"
+#include "Templates/Function.h"
 
 #include "IDlgParser.h"
 #include "DlgSystem/NYReflectionHelper.h"
@@ -125,21 +126,21 @@ private:
 	 * warning is printed if the word is not "{" or if the end of file is reached
 	 * @return Whether a new word "{" was found
 	 */
-	bool FindNextWordAndCheckIfBlockStart(const FString& BlockName);
+	bool FindNextWordAndCheckIfBlockStart(const TCHAR* BlockName);
 
 	/**
 	 * Jumps to the next word in the parsed config, and checks if it is a block end character ("}")
 	 * Warning is only printed if the end of file is reached
 	 * @return Whether a new word "}" was found
 	 */
-	bool FindNextWordAndCheckIfBlockEnd(const FString& BlockName);
+	bool FindNextWordAndCheckIfBlockEnd(const TCHAR* BlockName);
 
 	/**
 	 * Checks the active word if it is a block end character ("}")
 	 * Warning is only printed if the end of file is reached
 	 * @Return Whether the active word is "}"
 	 */
-	bool CheckIfBlockEnd(const FString& BlockName);
+	bool CheckIfBlockEnd(const TCHAR* BlockName);
 
 	/**
 	 * Compares the input string with the active word
@@ -147,15 +148,22 @@ private:
 	 *
 	 * @return Whether the word and the strings are equal
 	 */
-	bool CompareToActiveWord(const FString& StringToCompare) const;
+	bool CompareToActiveWord(FStringView StringToCompare) const;
 
 	/**
 	 * Calculates the line count for the current word
-	 * TODO: could be counted on the fly
+	 * The lines are counted on the fly from the previous call, the active word only moves forward
 	 * @return Active line index, or INDEX_NONE if there is no valid word
 	 */
 	int32 GetActiveLineNumber() const;
 
+	/** Restarts the line counting of GetActiveLineNumber from the start of the string */
+	void ResetLineNumber()
+	{
+		LineCountIndex = 0;
+		LineCount = 1;
+	}
+
 	// @return false if the file could not be read or if the end of file is reached
 	bool HasValidWord() const { return bHasValidWord; }
 
@@ -165,6 +173,23 @@ private:
 	 */
 	FString GetActiveWord() const { return bHasValidWord ? String.Mid(From, Len) : ""; }
 
+	/**
+	 * The active word without allocating, same range as String.Mid(From, Len) (even if there is no valid word)
+	 * Valid until the parser is initialized again
+	 */
+	FStringView GetWordView() const
+	{
+		const int32 Start = FMath::Clamp(From, 0, String.Len());
+		const int32 Count = FMath::Clamp(Len, 0, String.Len() - Start);
+		return FStringView(*String + Start, Count);
+	}
+
+	/**
+	 * Same as ReferenceClass->FindPropertyByName but the properties of each struct are cached by name
+	 * The name is not added to the name table if it does not exist
+	 */
+	FProperty* FindPropertyByNameCached(const UStruct* ReferenceClass, FStringView PropertyName);
+
 	/**
 	 * @param FloatValue: out float value if the call succeeds
 	 * @return the active word converted, or an empty string if there isn't any
@@ -211,8 +236,8 @@ private:
 	template <typename Type, typename PropertyType>
 	bool ReadPrimitiveProperty(void* Target,
 							   FProperty* PropertyBase,
-							   std::function<Type()> OnGetAsValue,
-							   const FString& TypeName,
+							   TFunctionRef<Type()> OnGetAsValue,
+							   const TCHAR* TypeName,
 							   bool bCanBeEmpty);
 
 
@@ -231,7 +256,7 @@ private:
 	bool ReadComplexProperty(void* Target,
 							 FProperty* Property,
 							 const UStruct* ReferenceType,
-							 std::function<void*(void*, const UClass*, UObject*)> OnInitValue,
+							 TFunctionRef<void*(void*, const UClass*, UObject*)> OnInitValue,
 							 UObject* Outer);
 
 
@@ -272,14 +297,21 @@ private:
 
 	/** used to skip the closing '"' */
 	bool bActiveIsString = false;
+
+	/** GetActiveLineNumber counted the lines of String until this index */
+	mutable int32 LineCountIndex = 0;
+	mutable int32 LineCount = 1;
+
+	/** Key: struct, Value: the properties of the struct by name, see FindPropertyByNameCached */
+	TMap<const UStruct*, TMap<FName, FProperty*>> StructPropertiesCache;
 };
 
 
 template <typename Type, typename PropertyType>
 bool FDlgConfigParser::ReadPrimitiveProperty(void* Target,
 											 FProperty* PropertyBase,
-											 std::function<Type()> OnGetAsValue,
-											 const FString& TypeName,
+											 TFunctionRef<Type()> OnGetAsValue,
+											 const TCHAR* TypeName,
 											 bool bCanBeEmpty)
 {
 	// try to find a member variable with the name
@@ -298,10 +330,11 @@ bool FDlgConfigParser::ReadPrimitiveProperty(void* Target,
 
 		TArray<Type>* Array = ArrayProp->ContainerPtrToValuePtr<TArray<Type>>(Target);
 		Array->Empty();
-		if (FindNextWordAndCheckIfBlockStart(TypeName + "Array"))
+		const FString BlockName = FString(TypeName) + TEXT("Array");
+		if (FindNextWordAndCheckIfBlockStart(*BlockName))
 		{
 			// read values until the block ends
-			while (!FindNextWordAndCheckIfBlockEnd(TypeName + "Array"))
+			while (!FindNextWordAndCheckIfBlockEnd(*BlockName))
 			{
 				if (!bHasValidWord && !bCanBeEmpty)
 				{
@@ -324,7 +357,7 @@ bool FDlgConfigParser::ReadPrimitiveProperty(void* Target,
 		}
 		else
 		{
-			UE_LOG(LogDlgConfigParser, Warning, TEXT("Unexpected end of file while %s value was expected (config %s)"), *TypeName, *FileName)
+			UE_LOG(LogDlgConfigParser, Warning, TEXT("Unexpected end of file while %s value was expected (config %s)"), TypeName, *FileName)
 		}
 	}
 
@@ -337,7 +370,7 @@ template <typename PropertyType>
 bool FDlgConfigParser::ReadComplexProperty(void* Target,
 										   FProperty* Property,
 										   const UStruct* ReferenceType,
-										   std::function<void*(void*, const UClass*, UObject*)> OnInitValue,
+										   TFunctionRef<void*(void*, const UClass*, UObject*)> OnInitValue,
 										   UObject* Outer)
 {
 	PropertyType* ElementProp = FNYReflectionHelper::CastProperty<PropertyType>(Property);
@@ -352,12 +385,13 @@ bool FDlgConfigParser::ReadComplexProperty(void* Target,
 		// Array
 		FScriptArrayHelper Helper(ArrayProp, ArrayProp->ContainerPtrToValuePtr<uint8>(Target));
 		Helper.EmptyValues();
-		if (!FindNextWordAndCheckIfBlockStart(ReferenceType->GetName() + "Array element") || !FindNextWord("{ or }"))
+		const FString BlockName = ReferenceType->GetName() + TEXT("Array element");
+		if (!FindNextWordAndCheckIfBlockStart(*BlockName) || !FindNextWord("{ or }"))
 		{
 			return false;
 		}
 
-		while (!CheckIfBlockEnd(ReferenceType->GetName() + "Array element"))
+		while (!CheckIfBlockEnd(*BlockName))
 		{
 			const UClass* ReferenceClass = Cast<UClass>(ReferenceType);
 			if (ReferenceClass != nullptr)
@@ -386,7 +420,7 @@ bool FDlgConfigParser::ReadComplexProperty(void* Target,
 					return false;
 				}
 			}
-			else if (!CompareToActiveWord("{"))
+			else if (!CompareToActiveWord(TEXT("{")))
 			{
 				if (!bHasValidWord)
 				{
@@ -14,6 +14,7 @@ const TCHAR* FDlgConfigWriter::EOL_LF = TEXT("\n");
 const TCHAR* FDlgConfigWriter::EOL_CRLF = TEXT("\r\n");
 const TCHAR* FDlgConfigWriter::EOL = EOL_LF;
 const FString FDlgConfigWriter::EOL_String{EOL};
+const FString FDlgConfigWriter::Space_String{TEXT(" ")};
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -28,19 +29,37 @@ FDlgConfigWriter::FDlgConfigWriter(const FString InComplexNamePrefix,
 void FDlgConfigWriter::Write(const UStruct* const StructDefinition, const void* const Object)
 {
 	TopLevelObjectPtr = Object;
+	ConfigText.Reserve(ConfigText.Len() + ConfigTextReserveSize);
 	WriteComplexMembersToString(StructDefinition, Object, "", EOL, ConfigText);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void FDlgConfigWriter::WriteComplexMembersToString(const UStruct* StructDefinition,
-												   const void* Object,
-												   const FString& PreString,
-												   const FString& PostString,
-												   FString& Target)
+FDlgConfigWriter::FDlgConfigPropertyWriteInfo FDlgConfigWriter::GetPropertyWriteInfo(const FProperty* Property)
 {
-	if (StructDefinition == nullptr)
+	if (Property == nullptr)
 	{
-		return;
+		return {};
+	}
+
+	if (const FDlgConfigPropertyWriteInfo* WriteInfo = PropertyWriteInfoCache.Find(Property))
+	{
+		return *WriteInfo;
+	}
+
+	FDlgConfigPropertyWriteInfo WriteInfo;
+	WriteInfo.bSkip = CanSkipProperty(Property);
+	WriteInfo.bLinePerItem = CanWriteOneLinePerItem(Property);
+	WriteInfo.bWriteIndex = CanWriteIndex(Property);
+	PropertyWriteInfoCache.Add(Property, WriteInfo);
+	return WriteInfo;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TSharedRef<const FDlgConfigWriter::FDlgConfigWritePlan> FDlgConfigWriter::GetWritePlan(const UStruct* StructDefinition)
+{
+	if (const TSharedRef<const FDlgConfigWritePlan>* WritePlanPtr = WritePlanCache.Find(StructDefinition))
+	{
+		return *WritePlanPtr;
 	}
 
 	// order
@@ -49,34 +68,28 @@ void FDlgConfigWriter::WriteComplexMembersToString(const UStruct* StructDefiniti
 	TArray<const FProperty*> ComplexElements;
 	TArray<const FProperty*> ComplexContainers;
 
-	constexpr int32 PropCategoryNum = 4;
-	TArray<const FProperty*>* PropCategory[PropCategoryNum] = { &Primitives, &PrimitiveContainers, &ComplexElements, &ComplexContainers };
-
-	// Handle UObject inheritance (children of class)
-	if (StructDefinition->IsA<UClass>())
-	{
-		const UObject* UnrealObject = static_cast<const UObject*>(Object);
-		if (!UnrealObject->IsValidLowLevelFast())
-		{
-			return;
-		}
-
-		StructDefinition = UnrealObject->GetClass();
-	}
-	if (!StructDefinition->IsValidLowLevelFast())
-	{
-		return;
-	}
-
 	// Populate categories
+	const TSharedRef<FDlgConfigWritePlan> WritePlan = MakeShared<FDlgConfigWritePlan>();
 	for (TFieldIterator<FProperty> It(StructDefinition); It; ++It)
 	{
 		const auto* Property = *It;
+		const bool bSkip = GetPropertyWriteInfo(Property).bSkip;
 		if (IsPrimitive(Property))
 		{
-			Primitives.Add(Property);
+			if (!bSkip)
+			{
+				Primitives.Add(Property);
+			}
+			continue;
+		}
+
+		WritePlan->NonPrimitiveProperties.Add(Property);
+		if (bSkip)
+		{
+			continue;
 		}
-		else if (IsContainer(Property))
+
+		if (IsContainer(Property))
 		{
 			if (IsPrimitiveContainer(Property))
 			{
@@ -93,15 +106,51 @@ void FDlgConfigWriter::WriteComplexMembersToString(const UStruct* StructDefiniti
 		}
 	}
 
-	constexpr bool bContainerElement = false;
-	for (int32 i = 0; i < PropCategoryNum; ++i)
+	WritePlan->Properties.Reserve(Primitives.Num() + PrimitiveContainers.Num() + ComplexElements.Num() + ComplexContainers.Num());
+	WritePlan->Properties.Append(Primitives);
+	WritePlan->Properties.Append(PrimitiveContainers);
+	WritePlan->Properties.Append(ComplexElements);
+	WritePlan->Properties.Append(ComplexContainers);
+
+	WritePlanCache.Add(StructDefinition, WritePlan);
+	return WritePlan;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgConfigWriter::WriteComplexMembersToString(const UStruct* StructDefinition,
+												   const void* Object,
+												   const FString& PreString,
+												   const FString& PostString,
+												   FString& Target)
+{
+	if (StructDefinition == nullptr)
 	{
-		for (const auto* Prop : *PropCategory[i])
+		return;
+	}
+
+	// Handle UObject inheritance (children of class)
+	if (StructDefinition->IsA<UClass>())
+	{
+		const UObject* UnrealObject = static_cast<const UObject*>(Object);
+		if (!UnrealObject->IsValidLowLevelFast())
 		{
-			WritePropertyToString(Prop, Object, bContainerElement, PreString, PostString, false, Target);
+			return;
 		}
+
+		StructDefinition = UnrealObject->GetClass();
+	}
+	if (!StructDefinition->IsValidLowLevelFast())
+	{
+		return;
 	}
 
+	// The skipped properties are already filtered out, the rest is in the order we write them
+	const TSharedRef<const FDlgConfigWritePlan> WritePlan = GetWritePlan(StructDefinition);
+	constexpr bool bContainerElement = false;
+	for (const FProperty* Prop : WritePlan->Properties)
+	{
+		WritePropertyToString(Prop, Object, bContainerElement, PreString, PostString, false, Target);
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -113,7 +162,7 @@ bool FDlgConfigWriter::WritePropertyToString(const FProperty* Property,
 											 bool bPointerAsRef,
 											 FString& Target)
 {
-	if (CanSkipProperty(Property))
+	if (GetPropertyWriteInfo(Property).bSkip)
 	{
 		return true;
 	}
@@ -166,35 +215,35 @@ bool FDlgConfigWriter::WritePrimitiveElementToString(const FProperty* Property,
 													 FString& Target)
 {
 	// Try every possible primitive type
-	if (WritePrimitiveElementToStringTemplated<FBoolProperty, bool>(Property, Object, bInContainer, BoolToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FBoolProperty, bool>(Property, Object, bInContainer, &AppendBool, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FIntProperty, int32>(Property, Object, bInContainer, IntToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FIntProperty, int32>(Property, Object, bInContainer, &AppendInt, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FInt64Property, int64>(Property, Object, bInContainer, IntToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FInt64Property, int64>(Property, Object, bInContainer, &AppendInt, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FFloatProperty, float>(Property, Object, bInContainer, FloatToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FFloatProperty, float>(Property, Object, bInContainer, &AppendFloat, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FDoubleProperty, double>(Property, Object, bInContainer, DoubleToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FDoubleProperty, double>(Property, Object, bInContainer, &AppendDouble, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FStrProperty, FString>(Property, Object, bInContainer, StringToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FStrProperty, FString>(Property, Object, bInContainer, &AppendString, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FNameProperty, FName>(Property, Object, bInContainer, NameToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FNameProperty, FName>(Property, Object, bInContainer, &AppendName, PreS, PostS, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveElementToStringTemplated<FTextProperty, FText>(Property, Object, bInContainer, TextToString, PreS, PostS, Target))
+	if (WritePrimitiveElementToStringTemplated<FTextProperty, FText>(Property, Object, bInContainer, &AppendText, PreS, PostS, Target))
 	{
 		return true;
 	}
@@ -207,7 +256,11 @@ bool FDlgConfigWriter::WritePrimitiveElementToString(const FProperty* Property,
 		{
 			const void* Value = EnumProp->ContainerPtrToValuePtr<uint8>(Object);
 			const FName EnumName = EnumProp->GetEnum()->GetNameByIndex(EnumProp->GetUnderlyingProperty()->GetSignedIntPropertyValue(Value));
-			Target += PreS + Property->GetName() + " " + NameToString(EnumName) + PostS;
+			Target += PreS;
+			Property->GetFName().AppendString(Target);
+			Target += TEXT(' ');
+			AppendName(EnumName, Target);
+			Target += PostS;
 			return true;
 		}
 	}
@@ -229,35 +282,35 @@ bool FDlgConfigWriter::WritePrimitiveArrayToString(const FProperty* Property,
 	}
 
 	// Try every possible primitive array type
-	if (WritePrimitiveArrayToStringTemplated<FBoolProperty, bool>(ArrayProp, Object, BoolToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FBoolProperty, bool>(ArrayProp, Object, &AppendBool, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FIntProperty, int32>(ArrayProp, Object, IntToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FIntProperty, int32>(ArrayProp, Object, &AppendInt, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FInt64Property, int64>(ArrayProp, Object, IntToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FInt64Property, int64>(ArrayProp, Object, &AppendInt, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FFloatProperty, float>(ArrayProp, Object, FloatToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FFloatProperty, float>(ArrayProp, Object, &AppendFloat, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FDoubleProperty, double>(ArrayProp, Object, DoubleToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FDoubleProperty, double>(ArrayProp, Object, &AppendDouble, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FStrProperty, FString>(ArrayProp, Object, StringToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FStrProperty, FString>(ArrayProp, Object, &AppendString, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FNameProperty, FName>(ArrayProp, Object, NameToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FNameProperty, FName>(ArrayProp, Object, &AppendName, PreString, PostString, Target))
 	{
 		return true;
 	}
-	if (WritePrimitiveArrayToStringTemplated<FTextProperty, FText>(ArrayProp, Object, TextToString, PreString, PostString, Target))
+	if (WritePrimitiveArrayToStringTemplated<FTextProperty, FText>(ArrayProp, Object, &AppendText, PreString, PostString, Target))
 	{
 		return true;
 	}
@@ -306,14 +359,16 @@ bool FDlgConfigWriter::WriteComplexElementToString(const FProperty* Property,
 		const FString Path = *ObjPtrPtr != nullptr ? (*ObjPtrPtr)->GetPathName() : "";
 		auto WritePathName = [&]()
 		{
-			if (bContainerElement)
-			{
-				Target += PreString + "\"" + Path + "\"" + PostString;
-			}
-			else
+			Target += PreString;
+			if (!bContainerElement)
 			{
-				Target += PreString + Property->GetName() + " \"" + Path + "\"" + PostString;
+				Property->GetFName().AppendString(Target);
+				Target += TEXT(' ');
 			}
+			Target += TEXT('"');
+			Target += Path;
+			Target += TEXT('"');
+			Target += PostString;
 		};
 
 		if (CanSaveAsReference(ObjectProperty, *ObjPtrPtr) || bPointerAsRef)
@@ -354,7 +409,7 @@ void FDlgConfigWriter::WriteComplexToString(const UStruct* StructDefinition,
 											bool bWriteType,
 											FString& Target)
 {
-	if (CanSkipProperty(Property) || StructDefinition == nullptr)
+	if (GetPropertyWriteInfo(Property).bSkip || StructDefinition == nullptr)
 	{
 		return;
 	}
@@ -368,34 +423,52 @@ void FDlgConfigWriter::WriteComplexToString(const UStruct* StructDefinition,
 	const bool bLinePerMember = WouldWriteNonPrimitive(StructDefinition, Object);
 
 	// WARNING: bWriteType implicates objectproperty, if that changes this code (cause of the object cast) should be updated accordingly
-	const FString TypeString = bWriteType ? GetNameWithoutPrefix(Property, UnrealObject) + " ": "";
-	if (bContainerElement)
+	Target += PreString;
+	if (bWriteType)
+	{
+		Target += GetNameWithoutPrefix(Property, UnrealObject);
+		Target += TEXT(' ');
+	}
+	if (!bContainerElement)
 	{
-		if (TypeString.Len() > 0)
+		Property->GetFName().AppendString(Target);
+	}
+
+	// TypeName PropertyName {
+	if (bLinePerMember)
+	{
+		// Only a container element without a type starts the block on the same line
+		if (bContainerElement && !bWriteType)
 		{
-			Target += PreString + TypeString + (bLinePerMember ? EOL + PreString + "{" + EOL : "{ ");
+			Target += TEXT('{');
+			Target += EOL;
 		}
 		else
 		{
-			Target += PreString + (bLinePerMember ? "{" + EOL_String : "{ ");
+			Target += EOL;
+			Target += PreString;
+			Target += TEXT('{');
+			Target += EOL;
 		}
 	}
 	else
 	{
-		Target += PreString + TypeString + Property->GetName() + (bLinePerMember ? EOL + PreString + "{" + EOL : " { ");
+		Target += bContainerElement ? TEXT("{ ") : TEXT(" { ");
 	}
 
 	// Write the properties of the Struct/Object
-	WriteComplexMembersToString(StructDefinition, Object, (bLinePerMember ? PreString + "\t" : " "), (bLinePerMember ? EOL_String : ""), Target);
-
 	if (bLinePerMember)
 	{
-		Target += PreString + "}" + PostString;
+		WriteComplexMembersToString(StructDefinition, Object, PreString + TEXT("\t"), EOL_String, Target);
+		Target += PreString;
+		Target += TEXT('}');
 	}
 	else
 	{
-		Target += " }" + PostString;
+		WriteComplexMembersToString(StructDefinition, Object, Space_String, FString(), Target);
+		Target += TEXT(" }");
 	}
+	Target += PostString;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -423,36 +496,49 @@ bool FDlgConfigWriter::WriteComplexArrayToString(const FProperty* Property,
 		return true;
 	}
 
-	const bool bWriteIndex = CanWriteIndex(Property);
-	FString TypeText = "";
+	const bool bWriteIndex = GetPropertyWriteInfo(Property).bWriteIndex;
+	const bool bPointerAsRef = CanSaveAsReference(ArrayProp, nullptr);
+
+	// TypeName ArrayName
+	Target += PreString;
 	auto* ObjProp = FNYReflectionHelper::CastProperty<FObjectProperty>(ArrayProp->Inner);
 	if (ObjProp != nullptr && ObjProp->PropertyClass != nullptr)
 	{
-		TypeText = GetStringWithoutPrefix(ObjProp->PropertyClass->GetName()) + " ";
+		Target += GetStringWithoutPrefix(ObjProp->PropertyClass->GetName());
+		Target += TEXT(' ');
 	}
+	ArrayProp->Inner->GetFName().AppendString(Target);
 
 	if (Helper.Num() == 1 && !WouldWriteNonPrimitive(GetComplexType(ArrayProp->Inner), Helper.GetConstRawPtr(0)))
 	{
-		Target += PreString + TypeText + ArrayProp->Inner->GetName() + " {";
-		for (int32 i = 0; i < Helper.Num(); ++i)
-		{
-			WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(i), true, " ", "", CanSaveAsReference(ArrayProp, nullptr), Target);
-		}
-		Target += " }" + PostString;
+		Target += TEXT(" {");
+		WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(0), true, Space_String, FString(), bPointerAsRef, Target);
+		Target += TEXT(" }");
+		Target += PostString;
 	}
 	else
 	{
-		Target += PreString + TypeText + ArrayProp->Inner->GetName() + EOL;
-		Target += PreString + "{" + EOL;
+		Target += EOL;
+		Target += PreString;
+		Target += TEXT('{');
+		Target += EOL;
+
+		const FString SubPreString = PreString + TEXT("\t");
 		for (int32 i = 0; i < Helper.Num(); ++i)
 		{
 			if (bWriteIndex)
 			{
-				Target += PreString + "\t// " + FString::FromInt(i) + EOL;
+				Target += SubPreString;
+				Target += TEXT("// ");
+				Target.AppendInt(i);
+				Target += EOL;
 			}
-			WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(i), true, PreString + "\t", EOL, CanSaveAsReference(ArrayProp, nullptr), Target);
+			WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(i), true, SubPreString, EOL_String, bPointerAsRef, Target);
 		}
-		Target += PreString + "}" + EOL;
+
+		Target += PreString;
+		Target += TEXT('}');
+		Target += EOL;
 	}
 
 	return true;
@@ -482,7 +568,11 @@ bool FDlgConfigWriter::WriteMapToString(const FProperty* Property,
 	if (IsPrimitive(MapProp->KeyProp) && IsPrimitive(MapProp->ValueProp))
 	{
 		// Both Key and Value are primitives
-		Target += PreString + MapProp->GetName() + " { ";
+		Target += PreString;
+		MapProp->GetFName().AppendString(Target);
+		Target += TEXT(" { ");
+
+		const FString EmptyString;
 
 		// GetMaxIndex() instead of Num() - the container is not contiguous
 		// elements are in [0, GetMaxIndex[, some of them are invalid (Num() returns with the valid element num)
@@ -493,16 +583,24 @@ bool FDlgConfigWriter::WriteMapToString(const FProperty* Property,
 				continue;
 			}
 
-			WritePrimitiveElementToString(MapProp->KeyProp, Helper.GetPairPtr(i), true, "", " ", Target);
-			WritePrimitiveElementToString(MapProp->ValueProp, Helper.GetPairPtr(i), true, "", " ", Target);
+			WritePrimitiveElementToString(MapProp->KeyProp, Helper.GetPairPtr(i), true, EmptyString, Space_String, Target);
+			WritePrimitiveElementToString(MapProp->ValueProp, Helper.GetPairPtr(i), true, EmptyString, Space_String, Target);
 		}
-		Target += "}" + PostString;
+		Target += TEXT('}');
+		Target += PostString;
 	}
 	else
 	{
 		// Either Key or Value is not a primitive
-		Target += PreString + MapProp->GetName() + EOL;
-		Target += PreString + "{" + EOL;
+		Target += PreString;
+		MapProp->GetFName().AppendString(Target);
+		Target += EOL;
+		Target += PreString;
+		Target += TEXT('{');
+		Target += EOL;
+
+		const FString SubPreString = PreString + TEXT("\t");
+		const bool bPointerAsRef = CanSaveAsReference(MapProp, nullptr);
 
 		// GetMaxIndex() instead of Num() - the container is not contiguous
 		// elements are in [0, GetMaxIndex[, some of them are invalid (Num() returns with the valid element num)
@@ -513,10 +611,12 @@ bool FDlgConfigWriter::WriteMapToString(const FProperty* Property,
 				continue;
 			}
 
-			WritePropertyToString(MapProp->KeyProp, Helper.GetPairPtr(i), true, PreString + "\t", EOL, CanSaveAsReference(MapProp, nullptr), Target);
-			WritePropertyToString(MapProp->ValueProp, Helper.GetPairPtr(i), true, PreString + "\t", EOL, CanSaveAsReference(MapProp, nullptr), Target);
+			WritePropertyToString(MapProp->KeyProp, Helper.GetPairPtr(i), true, SubPreString, EOL_String, bPointerAsRef, Target);
+			WritePropertyToString(MapProp->ValueProp, Helper.GetPairPtr(i), true, SubPreString, EOL_String, bPointerAsRef, Target);
 		}
-		Target += PreString + "}" + EOL;
+		Target += PreString;
+		Target += TEXT('}');
+		Target += EOL;
 	}
 
 	return true;
@@ -545,21 +645,19 @@ bool FDlgConfigWriter::WriteSetToString(const FProperty* Property,
 	// Only write primitive set elements
 	if (IsPrimitive(SetProp->ElementProp))
 	{
-		const bool bLinePerItem = CanWriteOneLinePerItem(SetProp);
+		const bool bLinePerItem = GetPropertyWriteInfo(SetProp).bLinePerItem;
 
-		// Add space indentation
-		FString SubPreString = PreString;
-		for (int32 i = 0; i < SetProp->GetName().Len() + 3; ++i)
-		{
-			SubPreString += " ";
-		}
+		// Add space indentation, the new line is part of it
+		const FString ItemPreString = bLinePerItem ? EOL + PreString + FString::ChrN(SetProp->GetName().Len() + 3, TEXT(' ')) : FString();
 
 		// SetName {
-		Target += PreString + SetProp->GetName() + " {";
+		Target += PreString;
+		SetProp->GetFName().AppendString(Target);
+		Target += TEXT(" {");
 		if (!bLinePerItem)
 		{
 			// Add space because there is no new line
-			Target += " ";
+			Target += TEXT(' ');
 		}
 
 		// Set content
@@ -573,16 +671,17 @@ bool FDlgConfigWriter::WriteSetToString(const FProperty* Property,
 
 			if (bLinePerItem)
 			{
-				WritePrimitiveElementToString(SetProp->ElementProp, Helper.GetElementPtr(i), true, EOL + SubPreString, "", Target);
+				WritePrimitiveElementToString(SetProp->ElementProp, Helper.GetElementPtr(i), true, ItemPreString, FString(), Target);
 			}
 			else
 			{
-				WritePrimitiveElementToString(SetProp->ElementProp, Helper.GetElementPtr(i), true, "", " ", Target);
+				WritePrimitiveElementToString(SetProp->ElementProp, Helper.GetElementPtr(i), true, FString(), Space_String, Target);
 			}
 		}
 
 		// }
-		Target += (bLinePerItem ? " " : "") + FString("}") + PostString;
+		Target += bLinePerItem ? TEXT(" }") : TEXT("}");
+		Target += PostString;
 	}
 	else
 	{
@@ -662,16 +761,10 @@ bool FDlgConfigWriter::WouldWriteNonPrimitive(const UStruct* StructDefinition, c
 		return false;
 	}
 
-	for (TFieldIterator<const FProperty> It(StructDefinition); It; ++It)
+	// Primitives are already ignored
+	const TSharedRef<const FDlgConfigWritePlan> WritePlan = GetWritePlan(StructDefinition);
+	for (const FProperty* Property : WritePlan->NonPrimitiveProperties)
 	{
-		const auto* Property = *It;
-
-		// Ignore primitives
-		if (IsPrimitive(Property))
-		{
-			continue;
-		}
-
 		if (IsContainer(Property))
 		{
 			// Map
@@ -758,3 +851,54 @@ FString FDlgConfigWriter::GetStringWithoutPrefix(const FString& String)
 
 	return String.Right(Count);
 }
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgConfigWriter::AppendBool(const bool& bBool, FString& Target)
+{
+	Target += bBool ? TEXT("True") : TEXT("False");
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgConfigWriter::AppendInt(const int64& IntVal, FString& Target)
+{
+	TCHAR Buffer[32];
+	FCString::Sprintf(Buffer, TEXT("%lld"), IntVal);
+	Target += Buffer;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgConfigWriter::AppendFloat(const float& FloatVal, FString& Target)
+{
+	Target += FString::SanitizeFloat(FloatVal);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgConfigWriter::AppendDouble(const double& DoubleVal, FString& Target)
+{
+	Target += FString::SanitizeFloat(DoubleVal);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgConfigWriter::AppendString(const FString& String, FString& Target)
+{
+	// Same as NormalizeEndlines but appends the parts between the \r\n directly
+	Target += TEXT('"');
+	const TCHAR* Chars = *String;
+	const int32 Num = String.Len();
+	int32 Start = 0;
+	for (int32 i = 0; i + 1 < Num; ++i)
+	{
+		if (Chars[i] == TEXT('\r') && Chars[i + 1] == TEXT('\n'))
+		{
+			Target.AppendChars(Chars + Start, i - Start);
+			Start = i + 1;
+		}
+	}
+	Target.AppendChars(Chars + Start, Num - Start);
+	Target += TEXT('"');
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgConfigWriter::AppendName(const FName& Name, FString& Target)
+{
+	AppendString(Name.ToString(), Target);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgConfigWriter::AppendText(const FText& Text, FString& Target)
+{
+	AppendString(Text.ToString(), Target);
+}
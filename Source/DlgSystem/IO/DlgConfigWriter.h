@@ -1,7 +1,6 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #pragma once
 
-#include <functional>
 #include "Logging/LogMacros.h"
 #include "UObject/UnrealType.h"
 #include "Misc/FileHelper.h"
@@ -62,6 +61,33 @@ public:
 
 protected:
 
+	/** The metadata specifiers of a property, evaluated once per property, see GetPropertyWriteInfo */
+	struct FDlgConfigPropertyWriteInfo
+	{
+		// CanSkipProperty
+		bool bSkip = true;
+
+		// CanWriteOneLinePerItem
+		bool bLinePerItem = false;
+
+		// CanWriteIndex
+		bool bWriteIndex = false;
+	};
+
+	/** How the members of a struct are written, computed once per struct, see GetWritePlan */
+	struct FDlgConfigWritePlan
+	{
+		// The not skipped properties in the order they are written:
+		// primitives, primitive containers, complex elements then complex containers
+		TArray<const FProperty*> Properties;
+
+		// All the non primitive properties (even the skipped ones), see WouldWriteNonPrimitive
+		TArray<const FProperty*> NonPrimitiveProperties;
+	};
+
+	FDlgConfigPropertyWriteInfo GetPropertyWriteInfo(const FProperty* Property);
+	TSharedRef<const FDlgConfigWritePlan> GetWritePlan(const UStruct* StructDefinition);
+
 	void WriteComplexToString(const UStruct* StructDefinition,
 							  const FProperty* Property,
 							  const void* Object,
@@ -140,11 +166,11 @@ protected:
 
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	template <typename PropertyType, typename VariableType>
+	template <typename PropertyType, typename VariableType, typename AppendFunctionType>
 	bool WritePrimitiveElementToStringTemplated(const FProperty* Property,
 												const void* Object,
 												bool bContainerElement,
-												std::function<FString(const VariableType&)> GetAsString,
+												AppendFunctionType AppendAsString,
 												const FString& PreString,
 												const FString& PostString,
 												FString& Target)
@@ -152,10 +178,14 @@ protected:
 		const PropertyType* CastedProperty = FNYReflectionHelper::CastProperty<PropertyType>(Property);
 		if (CastedProperty != nullptr)
 		{
-			Target += PreString +
-					  (bContainerElement ? "" : (CastedProperty->GetName() + " ")) +
-					  GetAsString(CastedProperty->GetPropertyValue_InContainer(Object, 0)) +
-					  PostString;
+			Target += PreString;
+			if (!bContainerElement)
+			{
+				CastedProperty->GetFName().AppendString(Target);
+				Target += TEXT(' ');
+			}
+			AppendAsString(CastedProperty->GetPropertyValue(CastedProperty->template ContainerPtrToValuePtr<void>(Object, 0)), Target);
+			Target += PostString;
 			return true;
 		}
 
@@ -163,10 +193,10 @@ protected:
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	template <typename PropertyType, typename VariableType>
+	template <typename PropertyType, typename VariableType, typename AppendFunctionType>
 	bool WritePrimitiveArrayToStringTemplated(const FArrayProperty* ArrayProp,
 											  const void* Object,
-											  std::function<FString(const VariableType&)> ToString,
+											  AppendFunctionType AppendAsString,
 											  const FString& PreString,
 											  const FString& PostString,
 											  FString& Target)
@@ -181,50 +211,59 @@ protected:
 		{
 			return false;
 		}
-		const bool bLinePerItem = CanWriteOneLinePerItem(ArrayProp);
+		const bool bLinePerItem = GetPropertyWriteInfo(ArrayProp).bLinePerItem;
 
 		// Empty array
-		const TArray<VariableType> Array = *ArrayPtr;
+		const TArray<VariableType>& Array = *ArrayPtr;
 		if (Array.Num() == 0 && bDontWriteEmptyContainer)
 		{
 			return true;
 		}
 
-		// Establish indentation to be the same as the ArrayName.len + 3 spaces
-		FString SubPreString = PreString;
-		for (int32 i = 0; i < ArrayProp->GetName().Len() + 3; ++i)
-		{
-			SubPreString += " ";
-		}
-
 		// ArrayName {
-		Target += PreString + ArrayProp->GetName() + " {" + (bLinePerItem ? EOL_String : " ");
+		Target += PreString;
+		ArrayProp->GetFName().AppendString(Target);
+		Target += TEXT(" {");
+		Target += bLinePerItem ? EOL : TEXT(" ");
 
 		// Array content
-		for (int32 i = 0; i < Array.Num(); ++i)
+		if (bLinePerItem)
 		{
-			if (bLinePerItem)
+			// Establish indentation to be the same as the ArrayName.len + 3 spaces
+			const FString SubPreString = PreString + FString::ChrN(ArrayProp->GetName().Len() + 3, TEXT(' '));
+			for (const VariableType& Value : Array)
 			{
-				Target += SubPreString + ToString(Array[i]) + EOL;
+				Target += SubPreString;
+				AppendAsString(Value, Target);
+				Target += EOL;
 			}
-			else
+		}
+		else
+		{
+			for (const VariableType& Value : Array)
 			{
-				Target += ToString(Array[i]) + " ";
+				AppendAsString(Value, Target);
+				Target += TEXT(' ');
 			}
 		}
 
 		// }
-		Target += (bLinePerItem ? PreString : "") + "}" + PostString;
+		if (bLinePerItem)
+		{
+			Target += PreString;
+		}
+		Target += TEXT('}');
+		Target += PostString;
 
 		return true;
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	template <typename PropertyType, typename VariableType>
+	template <typename PropertyType, typename VariableType, typename AppendFunctionType>
 	bool WritePrimitiveToStringTemplated(const FProperty* Property,
 										 const void* Object,
 										 bool bContainerElement,
-										 std::function<FString(const VariableType&)> GetAsString,
+										 AppendFunctionType AppendAsString,
 										 const FString& PreString,
 										 const FString& PostString,
 										 FString& Target)
@@ -232,10 +271,14 @@ protected:
 		const PropertyType* CastedProperty = FNYReflectionHelper::CastProperty<PropertyType>(Property);
 		if (CastedProperty != nullptr)
 		{
-			Target += PreString +
-					  (bContainerElement ? "" : (CastedProperty->GetName() + " ")) +
-					  GetAsString(*((VariableType*)(Object))) +
-					  PostString;
+			Target += PreString;
+			if (!bContainerElement)
+			{
+				CastedProperty->GetFName().AppendString(Target);
+				Target += TEXT(' ');
+			}
+			AppendAsString(*((VariableType*)(Object)), Target);
+			Target += PostString;
 			return true;
 		}
 
@@ -248,6 +291,15 @@ protected:
 		return Original.Replace(EOL_CRLF, EOL_LF, ESearchCase::IgnoreCase);
 	}
 
+	// Append the value to the Target in the config format, see WritePrimitiveElementToStringTemplated
+	static void AppendBool(const bool& bBool, FString& Target);
+	static void AppendInt(const int64& IntVal, FString& Target);
+	static void AppendFloat(const float& FloatVal, FString& Target);
+	static void AppendDouble(const double& DoubleVal, FString& Target);
+	static void AppendString(const FString& String, FString& Target);
+	static void AppendName(const FName& Name, FString& Target);
+	static void AppendText(const FText& Text, FString& Target);
+
 private:
 	// End of line
 	static const TCHAR* EOL_LF;
@@ -256,6 +308,7 @@ private:
 
 	// Helper strings
 	static const FString EOL_String;
+	static const FString Space_String;
 
 	FString ConfigText = "";
 
@@ -263,39 +316,10 @@ private:
 	const FString ComplexNamePrefix;
 	const bool bDontWriteEmptyContainer;
 
-	// Conversion to string functions
-	const std::function<FString(const bool&)> BoolToString = [](const bool& bBool) -> FString
-	{
-		return bBool ? "True" : "False";
-	};
-
-	const std::function<FString(const int64&)> IntToString = [](const int64& IntVal) -> FString
-	{
-		return FString::Printf(TEXT("%lld"), IntVal);
-	};
-
-	const std::function<FString(const float&)> FloatToString = [](const float& FloatVal) -> FString
-	{
-		return FString::SanitizeFloat(FloatVal);
-	};
-
-	const std::function<FString(const double&)> DoubleToString = [](const double& DoubleVal) -> FString
-	{
-		return FString::SanitizeFloat(DoubleVal);
-	};
-
-	const std::function<FString(const FString&)> StringToString = [](const FString& String) -> FString
-	{
-		return FString("\"") + NormalizeEndlines(String) + "\"";
-	};
+	// Reserved for the output of Write, the config text grows linearly from here
+	static constexpr int32 ConfigTextReserveSize = 16 * 1024;
 
-	const std::function<FString(const FName&)> NameToString = [](const FName& Name) -> FString
-	{
-		return FString("\"") + NormalizeEndlines(Name.ToString()) + "\"";
-	};
-
-	const std::function<FString(const FText&)> TextToString = [](const FText& Text) -> FString
-	{
-		return FString("\"") + NormalizeEndlines(Text.ToString()) + "\"";
-	};
+	// Caches, see GetPropertyWriteInfo and GetWritePlan
+	TMap<const FProperty*, FDlgConfigPropertyWriteInfo> PropertyWriteInfoCache;
+	TMap<const UStruct*, TSharedRef<const FDlgConfigWritePlan>> WritePlanCache;
 };
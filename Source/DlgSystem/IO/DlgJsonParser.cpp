@@ -101,7 +101,7 @@ void FDlgJsonParser::ReadAllProperty( const UStruct* ReferenceClass, void* Targe
 
 	// TODO use DefaultObjectOuter;
 	DefaultObjectOuter = InDefaultObjectOuter;
-	bIsValidFile = JsonObjectStringToUStruct(ReferenceClass, TargetObject);
+	bIsValidFile = bUseStreamingReader ? StreamJsonStringToUStruct(ReferenceClass, TargetObject) : JsonObjectStringToUStruct(ReferenceClass, TargetObject);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -239,7 +239,7 @@ bool FDlgJsonParser::ConvertScalarJsonValueToProperty(const TSharedPtr<FJsonValu
 		}
 		else if (JsonValue->Type == EJson::Object)
 		{
-			const TSharedPtr<FJsonObject> Obj = JsonValue->AsObject();
+			const TSharedPtr<FJsonObject>& Obj = JsonValue->AsObject();
 			check(Obj.IsValid()); // should not fail if Type == EJson::Object
 
 			// import the subvalue as a culture invariant string
@@ -275,7 +275,7 @@ bool FDlgJsonParser::ConvertScalarJsonValueToProperty(const TSharedPtr<FJsonValu
 	{
 		if (JsonValue->Type == EJson::Array)
 		{
-			const TArray<TSharedPtr<FJsonValue>> ArrayValue = JsonValue->AsArray();
+			const TArray<TSharedPtr<FJsonValue>>& ArrayValue = JsonValue->AsArray();
 			const int32 ArrayNum = ArrayValue.Num();
 
 			// make the output array size match
@@ -318,7 +318,7 @@ bool FDlgJsonParser::ConvertScalarJsonValueToProperty(const TSharedPtr<FJsonValu
 	{
 		if (JsonValue->Type == EJson::Array)
 		{
-			const TArray<TSharedPtr<FJsonValue>> ArrayValue = JsonValue->AsArray();
+			const TArray<TSharedPtr<FJsonValue>>& ArrayValue = JsonValue->AsArray();
 			const int32 ArrayNum = ArrayValue.Num();
 
 			FScriptSetHelper Helper(SetProperty, ValuePtr);
@@ -364,7 +364,7 @@ bool FDlgJsonParser::ConvertScalarJsonValueToProperty(const TSharedPtr<FJsonValu
 	{
 		if (JsonValue->Type == EJson::Object)
 		{
-			const TSharedPtr<FJsonObject> ObjectValue = JsonValue->AsObject();
+			const TSharedPtr<FJsonObject>& ObjectValue = JsonValue->AsObject();
 			FScriptMapHelper Helper(MapProperty, ValuePtr);
 			Helper.EmptyValues();
 
@@ -419,7 +419,7 @@ bool FDlgJsonParser::ConvertScalarJsonValueToProperty(const TSharedPtr<FJsonValu
 		// Default struct export
 		if (JsonValue->Type == EJson::Object)
 		{
-			const TSharedPtr<FJsonObject> Obj = JsonValue->AsObject();
+			const TSharedPtr<FJsonObject>& Obj = JsonValue->AsObject();
 			check(Obj.IsValid()); // should not fail if Type == EJson::Object
 			if (!JsonObjectToUStruct(Obj.ToSharedRef(), StructProperty->Struct, ValuePtr))
 			{
@@ -534,28 +534,12 @@ bool FDlgJsonParser::ConvertScalarJsonValueToProperty(const TSharedPtr<FJsonValu
 	// UObject
 	if (auto* ObjectProperty = FNYReflectionHelper::CastProperty<FObjectProperty>(Property))
 	{
-		// NOTE: The Value here should be a pointer to a pointer
-		// Because the UObjects are pointers, we must deference it. So instead of it being a void** we want it to be a void*
-		auto* ObjectPtrPtr = static_cast<UObject**>(ObjectProperty->ContainerPtrToValuePtr<void>(ValuePtr, 0));
+		UObject** ObjectPtrPtr = ResetObjectPropertyValue(ObjectProperty, ContainerPtr, ValuePtr);
 		if (ObjectPtrPtr == nullptr)
 		{
-			UE_LOG(
-				LogDlgJsonParser,
-				Error,
-				TEXT("PropertyName = `%s` Is a FObjectProperty but can't get non null ContainerPtrToValuePtr from it's StructObject"),
-				*Property->GetNameCPP()
-			);
 			return false;
 		}
 
-		// NOTE: We must check one level up to check if it is a nullptr or not
-		// Reset first, if non nullptr
-		const UObject* ContainerObjectPtr = ObjectProperty->GetObjectPropertyValue_InContainer(ContainerPtr);
-		if (ContainerObjectPtr != nullptr)
-		{
-			*ObjectPtrPtr = nullptr;
-		}
-
 		// Nothing else to do
 		if (JsonValue->IsNull())
 		{
@@ -578,7 +562,7 @@ bool FDlgJsonParser::ConvertScalarJsonValueToProperty(const TSharedPtr<FJsonValu
 		// Load the Normal JSON object
 		// Must have the type inside the Json Object
 		check(JsonValue->Type == EJson::Object);
-		const TSharedPtr<FJsonObject> JsonObject = JsonValue->AsObject();
+		const TSharedPtr<FJsonObject>& JsonObject = JsonValue->AsObject();
 		check(JsonObject.IsValid()); // should not fail if Type == EJson::Object
 
 		const FString SpecialKeyType = TEXT("__type__");
@@ -607,28 +591,9 @@ bool FDlgJsonParser::ConvertScalarJsonValueToProperty(const TSharedPtr<FJsonValu
 			return false;
 		}
 
-		const UClass* ChildClass = GetChildClassFromName(ObjectClass, JsonObjectType);
-		if (ChildClass == nullptr)
+		*ObjectPtrPtr = CreateObjectPropertyValue(ObjectProperty, JsonObjectType);
+		if (*ObjectPtrPtr == nullptr)
 		{
-			UE_LOG(
-				LogDlgJsonParser,
-				Error,
-				TEXT("ConvertScalarJsonValueToProperty - Trying to load by string reference. Could not find class `%s` for FObjectProperty = `%s`. Ignored."),
-				*JsonObjectType, *Property->GetNameCPP()
-			);
-			return false;
-		}
-		*ObjectPtrPtr = CreateNewUObject(ChildClass, DefaultObjectOuter);
-
-		// Something is wrong
-		if (*ObjectPtrPtr == nullptr || !(*ObjectPtrPtr)->IsValidLowLevelFast())
-		{
-			UE_LOG(
-				LogDlgJsonParser,
-				Error,
-				TEXT("JsonValueToProperty - PropertyName = `%s` Is a FObjectProperty but could not build any valid UObject"),
-				*Property->GetNameCPP()
-			);
 			return false;
 		}
 
@@ -801,13 +766,11 @@ bool FDlgJsonParser::JsonAttributesToUStruct(const TMap<FString, TSharedPtr<FJso
 	}
 
 	// iterate over the struct properties
-	for (TFieldIterator<FProperty> PropIt(StructDefinition); PropIt; ++PropIt)
+	const TSharedRef<const TArray<FNYNamedProperty>> StructProperties = FNYReflectionHelper::GetStructPropertiesCached(StructDefinition);
+	for (const FNYNamedProperty& NamedProperty : *StructProperties)
 	{
-		auto* Property = *PropIt;
-		if (!ensure(Property))
-			continue;
-
-		const FString PropertyName = Property->GetName();
+		FProperty* Property = NamedProperty.Property;
+		const FString& PropertyName = NamedProperty.Name;
 
 		// Check to see if we should ignore this property
 		if (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags))
@@ -817,22 +780,15 @@ bool FDlgJsonParser::JsonAttributesToUStruct(const TMap<FString, TSharedPtr<FJso
 		// TODO skip property
 
 		// Find a JSON value matching this property name
-		TSharedPtr<FJsonValue> JsonValue;
-		for (auto& Elem : JsonAttributes)
-		{
-			// use case insensitive search since FName may change case strangely on us
-			// TODO does this break on struct/classes with properties of similar name?
-			if (PropertyName.Equals(Elem.Key, ESearchCase::IgnoreCase))
-			{
-				JsonValue = Elem.Value;
-				break;
-			}
-		}
-		if (!JsonValue.IsValid())
+		// The FString keys are hashed and compared case insensitive, which we want since FName may change case strangely on us
+		// TODO does this break on struct/classes with properties of similar name?
+		const TSharedPtr<FJsonValue>* JsonValuePtr = JsonAttributes.Find(PropertyName);
+		if (JsonValuePtr == nullptr || !JsonValuePtr->IsValid())
 		{
 			// we allow values to not be found since this mirrors the typical UObject mantra that all the fields are optional when deserializing
 			continue;
 		}
+		const TSharedPtr<FJsonValue>& JsonValue = *JsonValuePtr;
 
 		void* ValuePtr = nullptr;
 		if (Property->IsA<FObjectProperty>())
@@ -879,3 +835,640 @@ bool FDlgJsonParser::JsonObjectStringToUStruct(const UStruct* StructDefinition,
 	}
 	return true;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+UObject** FDlgJsonParser::ResetObjectPropertyValue(const FObjectProperty* ObjectProperty, void* ContainerPtr, void* ValuePtr)
+{
+	// NOTE: The Value here should be a pointer to a pointer
+	// Because the UObjects are pointers, we must deference it. So instead of it being a void** we want it to be a void*
+	auto* ObjectPtrPtr = static_cast<UObject**>(ObjectProperty->ContainerPtrToValuePtr<void>(ValuePtr, 0));
+	if (ObjectPtrPtr == nullptr)
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("PropertyName = `%s` Is a FObjectProperty but can't get non null ContainerPtrToValuePtr from it's StructObject"),
+			*ObjectProperty->GetNameCPP()
+		);
+		return nullptr;
+	}
+
+	// NOTE: We must check one level up to check if it is a nullptr or not
+	// Reset first, if non nullptr
+	const UObject* ContainerObjectPtr = ObjectProperty->GetObjectPropertyValue_InContainer(ContainerPtr);
+	if (ContainerObjectPtr != nullptr)
+	{
+		*ObjectPtrPtr = nullptr;
+	}
+
+	return ObjectPtrPtr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+UObject* FDlgJsonParser::CreateObjectPropertyValue(const FObjectProperty* ObjectProperty, const FString& JsonObjectType)
+{
+	const UClass* ChildClass = GetChildClassFromName(ObjectProperty->PropertyClass, JsonObjectType);
+	if (ChildClass == nullptr)
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("ConvertScalarJsonValueToProperty - Trying to load by string reference. Could not find class `%s` for FObjectProperty = `%s`. Ignored."),
+			*JsonObjectType, *ObjectProperty->GetNameCPP()
+		);
+		return nullptr;
+	}
+
+	// Something is wrong
+	UObject* CreatedObject = CreateNewUObject(ChildClass, DefaultObjectOuter);
+	if (CreatedObject == nullptr || !CreatedObject->IsValidLowLevelFast())
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("JsonValueToProperty - PropertyName = `%s` Is a FObjectProperty but could not build any valid UObject"),
+			*ObjectProperty->GetNameCPP()
+		);
+		return nullptr;
+	}
+
+	return CreatedObject;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// JSON tokens helpers, used by the streaming reader
+
+// Returns false if the reader failed or reached the end
+static bool ReadNextToken(TJsonReader<>& Reader, EJsonNotation& OutNotation)
+{
+	return Reader.ReadNext(OutNotation) && OutNotation != EJsonNotation::Error;
+}
+
+static bool HasReaderError(const TJsonReader<>& Reader)
+{
+	return !Reader.GetErrorMessage().IsEmpty();
+}
+
+static bool IsScalarNotation(EJsonNotation Notation)
+{
+	return Notation == EJsonNotation::String || Notation == EJsonNotation::Number ||
+		   Notation == EJsonNotation::Boolean || Notation == EJsonNotation::Null;
+}
+
+// Value of the current scalar token, same types as FJsonSerializer::Deserialize creates
+static TSharedPtr<FJsonValue> MakeScalarJsonValue(const TJsonReader<>& Reader, EJsonNotation Notation)
+{
+	switch (Notation)
+	{
+		case EJsonNotation::String:
+			return MakeShared<FJsonValueString>(Reader.GetValueAsString());
+		case EJsonNotation::Number:
+			return MakeShared<FJsonValueNumber>(Reader.GetValueAsNumber());
+		case EJsonNotation::Boolean:
+			return MakeShared<FJsonValueBoolean>(Reader.GetValueAsBoolean());
+		case EJsonNotation::Null:
+			return MakeShared<FJsonValueNull>();
+		default:
+			return nullptr;
+	}
+}
+
+// Reads the tokens until the end of the current object or array (the start token was already read)
+static bool SkipJsonContainer(TJsonReader<>& Reader)
+{
+	int32 Depth = 1;
+	EJsonNotation Notation;
+	while (Depth > 0)
+	{
+		if (!ReadNextToken(Reader, Notation))
+		{
+			return false;
+		}
+
+		if (Notation == EJsonNotation::ObjectStart || Notation == EJsonNotation::ArrayStart)
+		{
+			Depth++;
+		}
+		else if (Notation == EJsonNotation::ObjectEnd || Notation == EJsonNotation::ArrayEnd)
+		{
+			Depth--;
+		}
+	}
+
+	return true;
+}
+
+// Skips the value that starts with the Notation token
+static bool SkipJsonValue(TJsonReader<>& Reader, EJsonNotation Notation)
+{
+	if (Notation == EJsonNotation::ObjectStart || Notation == EJsonNotation::ArrayStart)
+	{
+		return SkipJsonContainer(Reader);
+	}
+
+	return IsScalarNotation(Notation);
+}
+
+static bool ReadJsonObjectFields(TJsonReader<>& Reader, FJsonObject& OutJsonObject);
+
+// Reads the value that starts with the Notation token into a DOM value, used only for the values the streaming reader can't handle
+static TSharedPtr<FJsonValue> ReadJsonValue(TJsonReader<>& Reader, EJsonNotation Notation)
+{
+	if (IsScalarNotation(Notation))
+	{
+		return MakeScalarJsonValue(Reader, Notation);
+	}
+
+	if (Notation == EJsonNotation::ArrayStart)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		EJsonNotation ElementNotation;
+		while (ReadNextToken(Reader, ElementNotation))
+		{
+			if (ElementNotation == EJsonNotation::ArrayEnd)
+			{
+				return MakeShared<FJsonValueArray>(Values);
+			}
+
+			TSharedPtr<FJsonValue> Value = ReadJsonValue(Reader, ElementNotation);
+			if (!Value.IsValid())
+			{
+				return nullptr;
+			}
+			Values.Add(Value);
+		}
+
+		return nullptr;
+	}
+
+	if (Notation == EJsonNotation::ObjectStart)
+	{
+		TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		if (!ReadJsonObjectFields(Reader, *JsonObject))
+		{
+			return nullptr;
+		}
+
+		return MakeShared<FJsonValueObject>(JsonObject);
+	}
+
+	return nullptr;
+}
+
+// Reads the fields until the end of the current object (the start token was already read)
+static bool ReadJsonObjectFields(TJsonReader<>& Reader, FJsonObject& OutJsonObject)
+{
+	EJsonNotation Notation;
+	while (ReadNextToken(Reader, Notation))
+	{
+		if (Notation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		// Copy, the identifier changes while reading the value
+		const FString Key = Reader.GetIdentifier();
+		TSharedPtr<FJsonValue> Value = ReadJsonValue(Reader, Notation);
+		if (!Value.IsValid())
+		{
+			return false;
+		}
+		OutJsonObject.Values.Add(Key, Value);
+	}
+
+	return false;
+}
+
+// Finds the property with the Name (case insensitive, like the FString keys of the FJsonObject)
+// The search starts at InOutNextIndex because the keys are usually in the order of the properties (see FDlgJsonWriter)
+static const FNYNamedProperty* FindNamedProperty(const TArray<FNYNamedProperty>& Properties, const FString& Name, int32& InOutNextIndex)
+{
+	const int32 Num = Properties.Num();
+	for (int32 Offset = 0; Offset < Num; Offset++)
+	{
+		const int32 Index = (InOutNextIndex + Offset) % Num;
+		if (Properties[Index].Name.Equals(Name, ESearchCase::IgnoreCase))
+		{
+			InOutNextIndex = Index + 1;
+			return &Properties[Index];
+		}
+	}
+
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::StreamJsonStringToUStruct(const UStruct* StructDefinition, void* ContainerPtr)
+{
+	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+	EJsonNotation Notation;
+	if (!ReadNextToken(*JsonReader, Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("StreamJsonStringToUStruct - Unable to parse file = `%s`, the root is not a JSON object. Error = `%s`"),
+			*FileName, *JsonReader->GetErrorMessage()
+		);
+		return false;
+	}
+
+	const bool bSuccess = StreamObjectToUStruct(*JsonReader, StructDefinition, ContainerPtr);
+	if (HasReaderError(*JsonReader))
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("StreamJsonStringToUStruct - Unable to parse file = `%s`. Error = `%s` at Line = %d, Character = %d"),
+			*FileName, *JsonReader->GetErrorMessage(), JsonReader->GetLineNumber(), JsonReader->GetCharacterNumber()
+		);
+		return false;
+	}
+	if (!bSuccess)
+	{
+		UE_LOG(LogDlgJsonParser, Error, TEXT("StreamJsonStringToUStruct - Unable to deserialize file = `%s`"), *FileName);
+		return false;
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::StreamObjectToUStruct(TJsonReader<>& Reader, const UStruct* StructDefinition, void* ContainerPtr)
+{
+	check(StructDefinition);
+	check(ContainerPtr);
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgJsonParser, Verbose, TEXT("StreamObjectToUStruct, StructDefinition = `%s`"), *StructDefinition->GetPathName());
+	}
+
+	// Json Wrapper, needs the Object
+	if (StructDefinition == FJsonObjectWrapper::StaticStruct())
+	{
+		FJsonObject JsonObject;
+		if (!ReadJsonObjectFields(Reader, JsonObject))
+		{
+			return false;
+		}
+
+		return JsonAttributesToUStruct(JsonObject.Values, StructDefinition, ContainerPtr);
+	}
+
+	// Handle UObject inheritance (children of class)
+	if (StructDefinition->IsA<UClass>())
+	{
+		// Structure points to the child
+		const UObject* UnrealObject = static_cast<const UObject*>(ContainerPtr);
+		if (!UnrealObject->IsValidLowLevelFast())
+		{
+			UE_LOG(
+				LogDlgJsonParser,
+				Error,
+				TEXT("StreamObjectToUStruct: StructDefinition = `%s` is a UClass and expected ContainerPtr to be an UObject. Memory corruption?"),
+				*StructDefinition->GetPathName()
+			);
+			SkipJsonContainer(Reader);
+			return false;
+		}
+		StructDefinition = UnrealObject->GetClass();
+	}
+	if (!StructDefinition->IsValidLowLevelFast())
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("StreamObjectToUStruct: StructDefinition = `%s` is a UClass and expected ContainerPtr.Class to be valid. Memory corruption?"),
+			*StructDefinition->GetPathName()
+		);
+		SkipJsonContainer(Reader);
+		return false;
+	}
+
+	// iterate over the JSON keys
+	const TSharedRef<const TArray<FNYNamedProperty>> StructProperties = FNYReflectionHelper::GetStructPropertiesCached(StructDefinition);
+	int32 NextPropertyIndex = 0;
+	EJsonNotation Notation;
+	while (ReadNextToken(Reader, Notation))
+	{
+		if (Notation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		// Unknown key or property we should ignore
+		// we allow values to not be found since this mirrors the typical UObject mantra that all the fields are optional when deserializing
+		const FNYNamedProperty* NamedProperty = FindNamedProperty(*StructProperties, Reader.GetIdentifier(), NextPropertyIndex);
+		if (NamedProperty == nullptr || (CheckFlags != 0 && !NamedProperty->Property->HasAnyPropertyFlags(CheckFlags)))
+		{
+			if (!SkipJsonValue(Reader, Notation))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		FProperty* Property = NamedProperty->Property;
+		void* ValuePtr = nullptr;
+		if (Property->IsA<FObjectProperty>())
+		{
+			// Handle pointers, only allowed to be UObjects (are already pointers to the Value)
+			ValuePtr = ContainerPtr;
+		}
+		else
+		{
+			// Normal non pointer property
+			ValuePtr = Property->ContainerPtrToValuePtr<void>(ContainerPtr, 0);
+		}
+
+		// Convert the JSON value to the Property
+		if (!StreamValueToProperty(Reader, Notation, Property, ContainerPtr, ValuePtr))
+		{
+			if (HasReaderError(Reader))
+			{
+				return false;
+			}
+
+			UE_LOG(
+				LogDlgJsonParser,
+				Error,
+				TEXT("StreamObjectToUStruct - Unable to parse %s.%s from JSON"),
+				*StructDefinition->GetName(), *NamedProperty->Name
+			);
+		}
+	}
+
+	// Reader failed before the end of the object
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::StreamValueToProperty(TJsonReader<>& Reader, EJsonNotation Notation, FProperty* Property, void* ContainerPtr, void* ValuePtr)
+{
+	check(Property);
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgJsonParser, Verbose, TEXT("StreamValueToProperty, Property = `%s`"), *Property->GetPathName());
+	}
+
+	const bool bArrayProperty = Property->IsA<FArrayProperty>();
+	const bool bSetProperty = Property->IsA<FSetProperty>();
+
+	// Scalar only one property
+	if (Notation != EJsonNotation::ArrayStart)
+	{
+		if (bArrayProperty || bSetProperty)
+		{
+			UE_LOG(
+				LogDlgJsonParser,
+				Error,
+				TEXT("StreamValueToProperty - Attempted to import %s from non-array JSON for property = `%s`"),
+				bArrayProperty ? TEXT("TArray") : TEXT("TSet"), *Property->GetNameCPP()
+			);
+			SkipJsonValue(Reader, Notation);
+			return false;
+		}
+
+		if (Property->ArrayDim != 1)
+		{
+			UE_LOG(LogDlgJsonParser, Warning, TEXT("[Property->ArrayDim != 1] Ignoring excess properties when deserializing %s"), *Property->GetNameCPP());
+		}
+
+		return StreamScalarValueToProperty(Reader, Notation, Property, ContainerPtr, ValuePtr);
+	}
+
+	// In practice, the ArrayDim == 1 check ought to be redundant, since nested arrays of UPropertys are not supported
+	if ((bArrayProperty || bSetProperty) && Property->ArrayDim == 1)
+	{
+		// Read into TArray/TSet
+		return StreamScalarValueToProperty(Reader, Notation, Property, ContainerPtr, ValuePtr);
+	}
+
+	// Array
+	// We're deserializing a JSON array into a static array
+#if NY_ENGINE_VERSION >= 505
+	const int32 ElementSize = Property->GetElementSize();
+#else
+	const int32 ElementSize = Property->ElementSize;
+#endif
+	auto* ValueIntPtr = static_cast<uint8*>(ValuePtr);
+	bool bReturnStatus = true;
+	int32 Index = 0;
+	EJsonNotation ElementNotation;
+	while (ReadNextToken(Reader, ElementNotation))
+	{
+		if (ElementNotation == EJsonNotation::ArrayEnd)
+		{
+			return bReturnStatus;
+		}
+
+		if (Index < Property->ArrayDim)
+		{
+			bReturnStatus &= StreamScalarValueToProperty(Reader, ElementNotation, Property, ContainerPtr, ValueIntPtr + Index * ElementSize);
+		}
+		else
+		{
+			if (Index == Property->ArrayDim)
+			{
+				UE_LOG(LogDlgJsonParser, Warning, TEXT("[Property->ArrayDim < ArrayValue.Num()] Ignoring excess properties when deserializing %s"), *Property->GetNameCPP());
+			}
+			if (!SkipJsonValue(Reader, ElementNotation))
+			{
+				return false;
+			}
+		}
+		Index++;
+	}
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::StreamScalarValueToProperty(TJsonReader<>& Reader, EJsonNotation Notation, FProperty* Property, void* ContainerPtr, void* ValuePtr)
+{
+	check(Property);
+	if (ValuePtr == nullptr)
+	{
+		// Nothing else to do
+		return SkipJsonValue(Reader, Notation);
+	}
+
+	// Only one value, reuse the DOM conversion
+	if (IsScalarNotation(Notation))
+	{
+		return ConvertScalarJsonValueToProperty(MakeScalarJsonValue(Reader, Notation), Property, ContainerPtr, ValuePtr);
+	}
+
+	if (Notation == EJsonNotation::ArrayStart)
+	{
+		// TArray
+		if (auto* ArrayProperty = FNYReflectionHelper::CastProperty<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+			Helper.EmptyValues();
+
+			bool bReturnStatus = true;
+			EJsonNotation ElementNotation;
+			while (ReadNextToken(Reader, ElementNotation))
+			{
+				if (ElementNotation == EJsonNotation::ArrayEnd)
+				{
+					return bReturnStatus;
+				}
+
+				const int32 Index = Helper.AddValue();
+				if (!StreamValueToProperty(Reader, ElementNotation, ArrayProperty->Inner, ContainerPtr, Helper.GetRawPtr(Index)))
+				{
+					if (HasReaderError(Reader))
+					{
+						return false;
+					}
+
+					bReturnStatus = false;
+					UE_LOG(
+						LogDlgJsonParser,
+						Error,
+						TEXT("StreamScalarValueToProperty - Unable to deserialize array element [%d] for property %s"),
+						Index, *Property->GetNameCPP()
+					);
+				}
+			}
+
+			return false;
+		}
+
+		// TSet
+		if (auto* SetProperty = FNYReflectionHelper::CastProperty<FSetProperty>(Property))
+		{
+			FScriptSetHelper Helper(SetProperty, ValuePtr);
+			Helper.EmptyElements();
+
+			bool bReturnStatus = true;
+			int32 Index = 0;
+			EJsonNotation ElementNotation;
+			while (ReadNextToken(Reader, ElementNotation))
+			{
+				if (ElementNotation == EJsonNotation::ArrayEnd)
+				{
+					Helper.Rehash();
+					return bReturnStatus;
+				}
+
+				const int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+				if (!StreamValueToProperty(Reader, ElementNotation, SetProperty->ElementProp, ContainerPtr, Helper.GetElementPtr(NewIndex)))
+				{
+					if (HasReaderError(Reader))
+					{
+						Helper.Rehash();
+						return false;
+					}
+
+					bReturnStatus = false;
+					UE_LOG(
+						LogDlgJsonParser,
+						Error,
+						TEXT("StreamScalarValueToProperty - Unable to deserialize set element [%d] for property %s"),
+						Index, *Property->GetNameCPP()
+					);
+				}
+				Index++;
+			}
+
+			Helper.Rehash();
+			return false;
+		}
+	}
+	else if (Notation == EJsonNotation::ObjectStart)
+	{
+		// UStruct
+		auto* StructProperty = FNYReflectionHelper::CastProperty<FStructProperty>(Property);
+		if (StructProperty && StructProperty->Struct != FJsonObjectWrapper::StaticStruct())
+		{
+			if (!StreamObjectToUStruct(Reader, StructProperty->Struct, ValuePtr))
+			{
+				UE_LOG(
+					LogDlgJsonParser,
+					Error,
+					TEXT("StreamScalarValueToProperty - StreamObjectToUStruct failed for property %s"),
+					*Property->GetNameCPP()
+				);
+				return false;
+			}
+
+			return true;
+		}
+
+		// UObject
+		if (auto* ObjectProperty = FNYReflectionHelper::CastProperty<FObjectProperty>(Property))
+		{
+			return StreamObjectToObjectProperty(Reader, ObjectProperty, ContainerPtr, ValuePtr);
+		}
+	}
+
+	// Everything else (TMap, FText from a culture object, ...) is small, read it into a DOM value and reuse the DOM conversion
+	const TSharedPtr<FJsonValue> JsonValue = ReadJsonValue(Reader, Notation);
+	if (!JsonValue.IsValid())
+	{
+		return false;
+	}
+
+	return ConvertScalarJsonValueToProperty(JsonValue, Property, ContainerPtr, ValuePtr);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::StreamObjectToObjectProperty(TJsonReader<>& Reader, FObjectProperty* ObjectProperty, void* ContainerPtr, void* ValuePtr)
+{
+	static const FString SpecialKeyType = TEXT("__type__");
+
+	// The type must be known before creating the Object, FDlgJsonWriter always writes it first
+	EJsonNotation Notation;
+	if (!ReadNextToken(Reader, Notation))
+	{
+		return false;
+	}
+	if (Notation != EJsonNotation::String || Reader.GetIdentifier() != SpecialKeyType)
+	{
+		// Not written by us, read the rest of the object and use the DOM conversion
+		TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		if (Notation != EJsonNotation::ObjectEnd)
+		{
+			const FString Key = Reader.GetIdentifier();
+			TSharedPtr<FJsonValue> Value = ReadJsonValue(Reader, Notation);
+			if (!Value.IsValid() || !ReadJsonObjectFields(Reader, *JsonObject))
+			{
+				return false;
+			}
+			JsonObject->Values.Add(Key, Value);
+		}
+
+		return ConvertScalarJsonValueToProperty(MakeShared<FJsonValueObject>(JsonObject), ObjectProperty, ContainerPtr, ValuePtr);
+	}
+
+	//  Create the new Object
+	UObject** ObjectPtrPtr = ResetObjectPropertyValue(ObjectProperty, ContainerPtr, ValuePtr);
+	if (ObjectPtrPtr == nullptr)
+	{
+		SkipJsonContainer(Reader);
+		return false;
+	}
+	*ObjectPtrPtr = CreateObjectPropertyValue(ObjectProperty, Reader.GetValueAsString());
+	if (*ObjectPtrPtr == nullptr)
+	{
+		SkipJsonContainer(Reader);
+		return false;
+	}
+
+	// Write the rest of the json object
+	if (!StreamObjectToUStruct(Reader, ObjectProperty->PropertyClass, *ObjectPtrPtr))
+	{
+		UE_LOG(
+			LogDlgJsonParser,
+			Error,
+			TEXT("StreamObjectToObjectProperty - StreamObjectToUStruct failed for property %s"),
+			*ObjectProperty->GetNameCPP()
+		);
+		return false;
+	}
+
+	return true;
+}
@@ -4,6 +4,7 @@
 #include "Logging/LogMacros.h"
 #include "Dom/JsonValue.h"
 #include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
 
 #include "IDlgParser.h"
 #include "DlgSystem/NYEngineVersionHelpers.h"
@@ -19,7 +20,18 @@ class DLGSYSTEM_API FDlgJsonParser : public IDlgParser
 {
 	/**
 	 * Call Order and possible calls:
-	 *  - DlgJsonParser
+	 *  - DlgJsonParser (streaming reader, default)
+	 *		- InitializeParser
+	 *			- StreamJsonStringToUStruct
+	 *				- StreamObjectToUStruct
+	 *					- StreamValueToProperty
+	 *						- StreamScalarValueToProperty
+	 *							- StreamValueToProperty
+	 *							- StreamObjectToUStruct
+	 *							- StreamObjectToObjectProperty
+	 *							- ConvertScalarJsonValueToProperty (scalars and the rarely used types, e.g. TMap)
+	 *
+	 *  - DlgJsonParser (DOM reader, see SetUseStreamingReader)
 	 *		- InitializeParser
 	 *			- JsonObjectStringToUStruct
 	 *				- JsonObjectToUStruct
@@ -44,6 +56,10 @@ public:
 	bool IsValidFile() const override { return bIsValidFile; }
 	void ReadAllProperty(const UStruct* ReferenceClass, void* TargetObject, UObject* DefaultObjectOuter = nullptr) override;
 
+	// bUseStreamingReader:
+	bool IsUsingStreamingReader() const { return bUseStreamingReader; }
+	void SetUseStreamingReader(bool bValue) { bUseStreamingReader = bValue; }
+
 
 private: // JSON -> UStruct
 
@@ -100,11 +116,38 @@ private: // JSON -> UStruct
 	 */
 	bool JsonObjectStringToUStruct(const UStruct* StructDefinition, void* ContainerPtr);
 
+	// Resets the value of the ObjectProperty, returns the pointer to the UObject pointer of the value or nullptr on failure
+	UObject** ResetObjectPropertyValue(const FObjectProperty* ObjectProperty, void* ContainerPtr, void* ValuePtr);
+
+	// Creates the Object of the ObjectProperty from the __type__ special property
+	UObject* CreateObjectPropertyValue(const FObjectProperty* ObjectProperty, const FString& JsonObjectType);
+
+private: // JSON tokens -> UStruct
+
+	/**
+	 * Same as the JSON -> UStruct functions but reads the JSON tokens directly into the properties, without building the
+	 * FJsonObject of the whole file. Only the scalar values and the rarely used types (TMap, FText culture objects, FJsonObjectWrapper)
+	 * are converted to a FJsonValue, to reuse ConvertScalarJsonValueToProperty.
+	 *
+	 * The Notation is the token that was already read and starts the value, the functions read the tokens until the end of the value.
+	 * On a reader error (malformed JSON) they stop and return false, the error is in Reader.GetErrorMessage().
+	 */
+	bool StreamJsonStringToUStruct(const UStruct* StructDefinition, void* ContainerPtr);
+	bool StreamObjectToUStruct(TJsonReader<>& Reader, const UStruct* StructDefinition, void* ContainerPtr);
+	bool StreamValueToProperty(TJsonReader<>& Reader, EJsonNotation Notation, FProperty* Property, void* ContainerPtr, void* ValuePtr);
+	bool StreamScalarValueToProperty(TJsonReader<>& Reader, EJsonNotation Notation, FProperty* Property, void* ContainerPtr, void* ValuePtr);
+
+	// The __type__ special property must be the first key (as FDlgJsonWriter writes it), otherwise the object is read into a FJsonObject
+	bool StreamObjectToObjectProperty(TJsonReader<>& Reader, FObjectProperty* ObjectProperty, void* ContainerPtr, void* ValuePtr);
+
 private:
 	FString JsonString;
 	FString FileName;
 	bool bIsValidFile = false;
 
+	// Read the JSON tokens directly into the properties instead of building the FJsonObject of the whole file first
+	bool bUseStreamingReader = true;
+
 	/** The default object outer used when creating new objects when using NewObject.  */
 	UObject* DefaultObjectOuter = nullptr;
 
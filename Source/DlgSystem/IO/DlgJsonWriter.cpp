@@ -4,6 +4,9 @@
 #include "JsonObjectConverter.h"
 #include "JsonObjectWrapper.h"
 #include "Policies/CondensedJsonPrintPolicy.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "HAL/FileManager.h"
+#include "Templates/UniquePtr.h"
 #include "UObject/UnrealType.h"
 #include "UObject/EnumProperty.h"
 #include "UObject/TextProperty.h"
@@ -14,13 +17,182 @@
 
 DEFINE_LOG_CATEGORY(LogDlgJsonWriter);
 
+/**
+ * Archive between the TJsonWriter and the target archive. The TJsonWriter serializes TCHARs, they are converted to UTF-8
+ * here, so the bytes are the same as FFileHelper::SaveStringToFile with ForceUTF8WithoutBOM (see FDlgJsonWriter::ExportToFile).
+ * The small writes of the TJsonWriter (mostly a single character) are buffered.
+ */
+class FDlgJsonUTF8ArchiveProxy : public FArchive
+{
+public:
+	FDlgJsonUTF8ArchiveProxy(FArchive& InInnerArchive) : InnerArchive(InInnerArchive)
+	{
+		SetIsSaving(true);
+		Buffer.Reserve(BufferSize);
+	}
+	~FDlgJsonUTF8ArchiveProxy() { FlushBuffer(true); }
+
+	void Serialize(void* Data, int64 Num) override
+	{
+		check(Num % sizeof(TCHAR) == 0);
+		Buffer.Append(static_cast<const TCHAR*>(Data), static_cast<int32>(Num / sizeof(TCHAR)));
+		if (Buffer.Num() >= BufferSize)
+		{
+			FlushBuffer(false);
+		}
+	}
+
+	void Flush() override
+	{
+		FlushBuffer(true);
+		InnerArchive.Flush();
+	}
+
+	FString GetArchiveName() const override { return TEXT("FDlgJsonUTF8ArchiveProxy"); }
+
+private:
+	void FlushBuffer(bool bAll)
+	{
+		int32 Num = Buffer.Num();
+
+		// Keep the first half of a surrogate pair until the second half arrives, they are converted together
+		if (!bAll && sizeof(TCHAR) == 2 && Num > 0)
+		{
+			const uint32 LastChar = static_cast<uint32>(Buffer.Last());
+			if (LastChar >= 0xD800 && LastChar <= 0xDBFF)
+			{
+				Num--;
+			}
+		}
+		if (Num == 0)
+		{
+			return;
+		}
+
+		const FTCHARToUTF8 Converted(Buffer.GetData(), Num);
+		InnerArchive.Serialize(const_cast<void*>(static_cast<const void*>(Converted.Get())), Converted.Length());
+
+		const bool bKeepLast = Num < Buffer.Num();
+		const TCHAR LastChar = bKeepLast ? Buffer.Last() : 0;
+		Buffer.Reset();
+		if (bKeepLast)
+		{
+			Buffer.Add(LastChar);
+		}
+	}
+
+private:
+	static constexpr int32 BufferSize = 16 * 1024;
+
+	FArchive& InnerArchive;
+	TArray<TCHAR> Buffer;
+};
+
+// Enums are exported as strings
+static FString GetEnumValueString(const UEnum* EnumDefinition, const FNumericProperty* NumericProperty, const void* ValuePtr)
+{
+	return EnumDefinition->GetNameByIndex(NumericProperty->GetSignedIntPropertyValue(ValuePtr)).ToString();
+}
+
+// Map keys must be strings in JSON
+static FString GetMapKeyString(const FMapProperty* MapProperty, const uint8* MapKeyPtr, const TSharedPtr<FJsonValue>& KeyElement, int32 Index)
+{
+	FString KeyString;
+	if (auto* KeyStructProperty = FNYReflectionHelper::CastProperty<FStructProperty>(MapProperty->KeyProp))
+	{
+		// Key is a struct
+#if NY_ENGINE_VERSION >= 501
+		MapProperty->KeyProp->ExportTextItem_Direct(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
+#else
+		MapProperty->KeyProp->ExportTextItem(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
+#endif
+	}
+	else
+	{
+		// Default to key string
+		KeyString = KeyElement->AsString();
+	}
+
+	// Fallback for anything else, what could this be :O
+	if (KeyString.IsEmpty())
+	{
+
+#if NY_ENGINE_VERSION >= 501
+		MapProperty->KeyProp->ExportTextItem_Direct(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
+#else
+		MapProperty->KeyProp->ExportTextItem(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
+#endif
+
+		if (KeyString.IsEmpty())
+		{
+			UE_LOG(LogDlgJsonWriter, Error, TEXT("Unable to convert key to string for property `%s`."), *MapProperty->GetNameCPP())
+			KeyString = FString::Printf(TEXT("Unparsed Key %d"), Index);
+		}
+	}
+
+	return KeyString;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void FDlgJsonWriter::Write(const UStruct* StructDefinition, const void* ContainerPtr)
 {
 	DlgJsonWriterOptions WriterOptions;
 	WriterOptions.bPrettyPrint = true;
 	WriterOptions.InitialIndent = 0;
-	UStructToJsonString(StructDefinition, ContainerPtr, WriterOptions, JsonString);
+	if (bUseStreamingWriter)
+	{
+		StreamUStructToJsonString(StructDefinition, ContainerPtr, WriterOptions, JsonString);
+	}
+	else
+	{
+		UStructToJsonString(StructDefinition, ContainerPtr, WriterOptions, JsonString);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonWriter::WriteToArchive(const UStruct* StructDefinition, const void* ContainerPtr, FArchive& Archive)
+{
+	DlgJsonWriterOptions WriterOptions;
+	WriterOptions.bPrettyPrint = true;
+	WriterOptions.InitialIndent = 0;
+
+	FDlgJsonUTF8ArchiveProxy ArchiveProxy(Archive);
+	const bool bSuccess = StreamUStructToJsonArchive(StructDefinition, ContainerPtr, WriterOptions, ArchiveProxy);
+	ArchiveProxy.Flush();
+	return bSuccess && !Archive.IsError();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonWriter::WriteToFile(const UStruct* StructDefinition, const void* ContainerPtr, const FString& FileName)
+{
+	// Write into a temporary file first, so that a failed write does not leave a truncated target file behind
+	IFileManager& FileManager = IFileManager::Get();
+	const FString TempFileName = FileName + TEXT(".tmp");
+	TUniquePtr<FArchive> FileWriter(FileManager.CreateFileWriter(*TempFileName));
+	if (!FileWriter)
+	{
+		UE_LOG(LogDlgJsonWriter, Error, TEXT("WriteToFile - Unable to open file = `%s` for writing"), *TempFileName);
+		return false;
+	}
+
+	const bool bWritten = WriteToArchive(StructDefinition, ContainerPtr, *FileWriter);
+	const bool bClosed = FileWriter->Close();
+	FileWriter.Reset();
+	if (!bWritten || !bClosed)
+	{
+		UE_LOG(LogDlgJsonWriter, Error, TEXT("WriteToFile - Failed to write file = `%s`"), *TempFileName);
+		FileManager.Delete(*TempFileName, false, true, true);
+		return false;
+	}
+
+	if (!FileManager.Move(*FileName, *TempFileName, true, true))
+	{
+		UE_LOG(LogDlgJsonWriter, Error, TEXT("WriteToFile - Unable to move file = `%s` to `%s`"), *TempFileName, *FileName);
+		FileManager.Delete(*TempFileName, false, true, true);
+		return false;
+	}
+
+	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -47,8 +219,7 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FP
 	// Get Json String for Enum definition
 	auto GetJsonStringForEnum = [&ValuePtr](const UEnum* EnumDefinition, const FNumericProperty* NumericProperty) -> TSharedPtr<FJsonValue>
 	{
-		const FString StringValue = EnumDefinition->GetNameByIndex(NumericProperty->GetSignedIntPropertyValue(ValuePtr)).ToString();
-		return MakeShared<FJsonValueString>(StringValue);
+		return MakeShared<FJsonValueString>(GetEnumValueString(EnumDefinition, NumericProperty, ValuePtr));
 	};
 
 	// Add Index Metadata to JsonObject
@@ -212,39 +383,7 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FP
 			{
 				check(MapKeyPtr);
 
-				FString KeyString;
-				if (auto* KeyStructProperty = FNYReflectionHelper::CastProperty<FStructProperty>(MapProperty->KeyProp))
-				{
-					// Key is a struct
-#if NY_ENGINE_VERSION >= 501
-					MapProperty->KeyProp->ExportTextItem_Direct(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
-#else
-					MapProperty->KeyProp->ExportTextItem(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
-#endif
-				}
-				else
-				{
-					// Default to key string
-					KeyString = KeyElement->AsString();
-				}
-
-				// Fallback for anything else, what could this be :O
-				if (KeyString.IsEmpty())
-				{
-
-#if NY_ENGINE_VERSION >= 501
-					MapProperty->KeyProp->ExportTextItem_Direct(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
-#else
-					MapProperty->KeyProp->ExportTextItem(KeyString, MapKeyPtr, MapKeyPtr, nullptr, PPF_None);
-#endif
-
-					if (KeyString.IsEmpty())
-					{
-						UE_LOG(LogDlgJsonWriter, Error, TEXT("Unable to convert key to string for property `%s`."), *MapProperty->GetNameCPP())
-						KeyString = FString::Printf(TEXT("Unparsed Key %d"), Index);
-					}
-				}
-
+				const FString KeyString = GetMapKeyString(MapProperty, MapKeyPtr, KeyElement, Index);
 				OutObject->SetField(KeyString, ValueElement);
 			}
 		}
@@ -356,6 +495,34 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::ConvertScalarPropertyToJsonValue(const FP
 	return MakeShared<FJsonValueString>(ValueString);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgJsonWriter::LogUnhandledProperty(const FProperty* Property) const
+{
+	const auto* PropertyClass = Property->GetClass();
+	if (Property->IsA<FObjectProperty>())
+	{
+		// Object property, can be nullptr
+		if (bLogVerbose)
+		{
+			UE_LOG(
+				LogDlgJsonWriter,
+				Verbose,
+				TEXT("UStructToJsonObject - Unhandled property type Class = '%s', Name = `%s`. (NOTE: UObjects can be nullptrs)"),
+				*PropertyClass->GetName(), *Property->GetPathName()
+			);
+		}
+	}
+	else
+	{
+		UE_LOG(
+			LogDlgJsonWriter,
+			Error,
+			TEXT("UStructToJsonObject - Unhandled property type Class = '%s', Name = `%s`"),
+			*PropertyClass->GetName(), *Property->GetNameCPP()
+		);
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TSharedPtr<FJsonValue> FDlgJsonWriter::PropertyToJsonValue(const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr)
 {
@@ -367,30 +534,7 @@ TSharedPtr<FJsonValue> FDlgJsonWriter::PropertyToJsonValue(const FProperty* Prop
 
 	if (ContainerPtr == nullptr || ValuePtr == nullptr)
 	{
-		const auto* PropertyClass = Property->GetClass();
-		if (Property->IsA<FObjectProperty>())
-		{
-			// Object property, can be nullptr
-			if (bLogVerbose)
-			{
-				UE_LOG(
-					LogDlgJsonWriter,
-					Verbose,
-					TEXT("UStructToJsonObject - Unhandled property type Class = '%s', Name = `%s`. (NOTE: UObjects can be nullptrs)"),
-					*PropertyClass->GetName(), *Property->GetPathName()
-				);
-			}
-		}
-		else
-		{
-			UE_LOG(
-				LogDlgJsonWriter,
-				Error,
-				TEXT("UStructToJsonObject - Unhandled property type Class = '%s', Name = `%s`"),
-				*PropertyClass->GetName(), *Property->GetNameCPP()
-			);
-		}
-
+		LogUnhandledProperty(Property);
 		return MakeShared<FJsonValueNull>();
 	}
 
@@ -600,3 +744,636 @@ bool FDlgJsonWriter::UStructToJsonString(const UStruct* StructDefinition, const
 	UE_LOG(LogDlgJsonWriter, Error, TEXT("UStructToJsonObjectString - Unable to write out json"));
 	return false;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// TJsonWriter helpers, used by the streaming writer. The Identifier is nullptr for the values inside arrays
+template <class PrintPolicy>
+static void WriteJsonObjectStart(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier)
+{
+	if (Identifier)
+	{
+		Writer.WriteObjectStart(*Identifier);
+	}
+	else
+	{
+		Writer.WriteObjectStart();
+	}
+}
+
+template <class PrintPolicy>
+static void WriteJsonArrayStart(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier)
+{
+	if (Identifier)
+	{
+		Writer.WriteArrayStart(*Identifier);
+	}
+	else
+	{
+		Writer.WriteArrayStart();
+	}
+}
+
+// NOTE: numbers must be written as double, like FJsonSerializer writes the FJsonValueNumber
+template <class PrintPolicy, typename ValueType>
+static void WriteJsonScalar(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier, const ValueType& Value)
+{
+	if (Identifier)
+	{
+		Writer.WriteValue(*Identifier, Value);
+	}
+	else
+	{
+		Writer.WriteValue(Value);
+	}
+}
+
+template <class PrintPolicy>
+static void WriteJsonNull(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier)
+{
+	if (Identifier)
+	{
+		Writer.WriteNull(*Identifier);
+	}
+	else
+	{
+		Writer.WriteNull();
+	}
+}
+
+// Writes the JsonValue the same way as FJsonSerializer::Serialize
+template <class PrintPolicy>
+static void WriteJsonDOMValue(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier, const TSharedPtr<FJsonValue>& JsonValue)
+{
+	if (!JsonValue.IsValid())
+	{
+		WriteJsonNull(Writer, Identifier);
+		return;
+	}
+
+	switch (JsonValue->Type)
+	{
+		case EJson::String:
+			WriteJsonScalar(Writer, Identifier, JsonValue->AsString());
+			break;
+
+		case EJson::Number:
+			WriteJsonScalar(Writer, Identifier, JsonValue->AsNumber());
+			break;
+
+		case EJson::Boolean:
+			WriteJsonScalar(Writer, Identifier, JsonValue->AsBool());
+			break;
+
+		case EJson::Array:
+			WriteJsonArrayStart(Writer, Identifier);
+			for (const TSharedPtr<FJsonValue>& Element : JsonValue->AsArray())
+			{
+				WriteJsonDOMValue(Writer, nullptr, Element);
+			}
+			Writer.WriteArrayEnd();
+			break;
+
+		case EJson::Object:
+			WriteJsonObjectStart(Writer, Identifier);
+			for (const auto& Pair : JsonValue->AsObject()->Values)
+			{
+				WriteJsonDOMValue(Writer, &Pair.Key, Pair.Value);
+			}
+			Writer.WriteObjectEnd();
+			break;
+
+		default:
+			WriteJsonNull(Writer, Identifier);
+			break;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <class PrintPolicy>
+void FDlgJsonWriter::StreamScalarPropertyToJson(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier,
+	const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr)
+{
+	check(Property);
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgJsonWriter, Verbose, TEXT("StreamScalarPropertyToJson, Property = `%s`"), *Property->GetPathName());
+	}
+	if (ValuePtr == nullptr)
+	{
+		// Invalid
+		WriteJsonNull(Writer, Identifier);
+		return;
+	}
+
+	// Enum, export enums as strings
+	if (const auto* EnumProperty = FNYReflectionHelper::CastProperty<FEnumProperty>(Property))
+	{
+		WriteJsonScalar(Writer, Identifier, GetEnumValueString(EnumProperty->GetEnum(), EnumProperty->GetUnderlyingProperty(), ValuePtr));
+		return;
+	}
+
+	// Numeric, int, float, possible enum
+	if (const auto* NumericProperty = FNYReflectionHelper::CastProperty<FNumericProperty>(Property))
+	{
+		// See if it's an enum Numeric property
+		if (const UEnum* EnumDef = NumericProperty->GetIntPropertyEnum())
+		{
+			WriteJsonScalar(Writer, Identifier, GetEnumValueString(EnumDef, NumericProperty, ValuePtr));
+		}
+		else if (NumericProperty->IsInteger())
+		{
+			// Map keys are written as strings, see ConvertScalarPropertyToJsonValue
+			if (bIsPropertyMapKey)
+			{
+				WriteJsonScalar(Writer, Identifier, FString::Printf(TEXT("%lld"), NumericProperty->GetSignedIntPropertyValue(ValuePtr)));
+			}
+			else
+			{
+				WriteJsonScalar(Writer, Identifier, static_cast<double>(NumericProperty->GetSignedIntPropertyValue(ValuePtr)));
+			}
+		}
+		else if (NumericProperty->IsFloatingPoint())
+		{
+			WriteJsonScalar(Writer, Identifier, static_cast<double>(NumericProperty->GetFloatingPointPropertyValue(ValuePtr)));
+		}
+		else
+		{
+			// Invalid
+			WriteJsonNull(Writer, Identifier);
+		}
+		return;
+	}
+
+	// Bool, Export bools as JSON bools
+	if (const auto* BoolProperty = FNYReflectionHelper::CastProperty<FBoolProperty>(Property))
+	{
+		WriteJsonScalar(Writer, Identifier, static_cast<bool>(BoolProperty->GetOptionalPropertyValue(ValuePtr)));
+		return;
+	}
+
+	// FString
+	if (const auto* StringProperty = FNYReflectionHelper::CastProperty<FStrProperty>(Property))
+	{
+		WriteJsonScalar(Writer, Identifier, StringProperty->GetOptionalPropertyValue(ValuePtr));
+		return;
+	}
+
+	// FName
+	if (const auto* NameProperty = FNYReflectionHelper::CastProperty<FNameProperty>(Property))
+	{
+		const auto* NamePtr = static_cast<const FName*>(ValuePtr);
+		if (!NamePtr->IsValidIndexFast() || !NamePtr->IsValid())
+		{
+			UE_LOG(LogDlgJsonWriter, Error, TEXT("Got Property = `%s` of type FName but it is not valid :("), *NameProperty->GetNameCPP())
+			WriteJsonNull(Writer, Identifier);
+			return;
+		}
+
+		WriteJsonScalar(Writer, Identifier, NamePtr->ToString());
+		return;
+	}
+
+	// FText
+	if (const auto* TextProperty = FNYReflectionHelper::CastProperty<FTextProperty>(Property))
+	{
+		WriteJsonScalar(Writer, Identifier, TextProperty->GetOptionalPropertyValue(ValuePtr).ToString());
+		return;
+	}
+
+	// TArray
+	if (const auto* ArrayProperty = FNYReflectionHelper::CastProperty<FArrayProperty>(Property))
+	{
+		WriteJsonArrayStart(Writer, Identifier);
+		const FDlgConstScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+		for (int32 Index = 0, Num = Helper.Num(); Index < Num; Index++)
+		{
+			IndexInArray = Index;
+			StreamPropertyToJson(Writer, nullptr, ArrayProperty->Inner, ContainerPtr, Helper.GetConstRawPtr(Index));
+		}
+		Writer.WriteArrayEnd();
+
+		ResetState();
+		return;
+	}
+
+	// TSet
+	if (const auto* SetProperty = FNYReflectionHelper::CastProperty<FSetProperty>(Property))
+	{
+		WriteJsonArrayStart(Writer, Identifier);
+		const FScriptSetHelper Helper(SetProperty, ValuePtr);
+
+		// GetMaxIndex() instead of Num() - the container is not contiguous
+		for (int32 Index = 0; Index < Helper.GetMaxIndex(); Index++)
+		{
+			if (!Helper.IsValidIndex(Index))
+			{
+				continue;
+			}
+
+			IndexInArray = Index;
+			StreamPropertyToJson(Writer, nullptr, SetProperty->ElementProp, ContainerPtr, Helper.GetElementPtr(Index));
+		}
+		Writer.WriteArrayEnd();
+
+		ResetState();
+		return;
+	}
+
+	// TMap
+	if (const auto* MapProperty = FNYReflectionHelper::CastProperty<FMapProperty>(Property))
+	{
+		StreamMapToJson(Writer, Identifier, MapProperty, ContainerPtr, ValuePtr);
+		return;
+	}
+
+	// UStruct
+	if (const auto* StructProperty = FNYReflectionHelper::CastProperty<FStructProperty>(Property))
+	{
+		// Intentionally exclude the JSON Object wrapper, which specifically needs to export JSON in an object representation instead of a string
+		UScriptStruct::ICppStructOps* TheCppStructOps = StructProperty->Struct->GetCppStructOps();
+		if (StructProperty->Struct != FJsonObjectWrapper::StaticStruct() && TheCppStructOps && TheCppStructOps->HasExportTextItem())
+		{
+			// Export to native text
+			FString OutValueStr;
+			TheCppStructOps->ExportTextItem(OutValueStr, ValuePtr, ValuePtr, nullptr, PPF_None, nullptr);
+			WriteJsonScalar(Writer, Identifier, OutValueStr);
+			return;
+		}
+
+		// Handle Struct
+		StreamUStructToJson(Writer, Identifier, StructProperty->Struct, ValuePtr, IndexInArray != INDEX_NONE && CanWriteIndex(Property));
+		return;
+	}
+
+	// UObject
+	if (const auto* ObjectProperty = FNYReflectionHelper::CastProperty<FObjectProperty>(Property))
+	{
+		// NOTE: The ValuePtr here should be a pointer to a pointer, see ConvertScalarPropertyToJsonValue
+		const UObject* ObjectPtr = ObjectProperty->GetObjectPropertyValue_InContainer(ValuePtr);
+		const UObject* ContainerObjectPtr = ObjectProperty->GetObjectPropertyValue_InContainer(ContainerPtr);
+		auto WriteNullObject = [this, &Writer, Identifier, ObjectProperty]()
+		{
+			// Save reference as empty string
+			if (CanSaveAsReference(ObjectProperty, nullptr))
+			{
+				WriteJsonScalar(Writer, Identifier, FString());
+			}
+			else
+			{
+				WriteJsonNull(Writer, Identifier);
+			}
+		};
+		if (ObjectPtr == nullptr || ContainerObjectPtr == nullptr)
+		{
+			// We can have nullptrs
+			WriteNullObject();
+			return;
+		}
+		if (!ObjectPtr->IsValidLowLevelFast())
+		{
+			// Memory corruption?
+			UE_LOG(
+				LogDlgJsonWriter,
+				Error,
+				TEXT("ObjectPtr.IsValidLowLevelFast is false for Property = `%s`. Memory corruption for UObjects?"),
+				*Property->GetPathName()
+			);
+			WriteNullObject();
+			return;
+		}
+
+		// Special case were we want just to save a reference to the object location
+		if (CanSaveAsReference(ObjectProperty, ObjectPtr))
+		{
+			WriteJsonScalar(Writer, Identifier, ObjectPtr->GetPathName());
+			return;
+		}
+
+		// Save as normal JSON Object
+		StreamUStructToJson(Writer, Identifier, ObjectProperty->PropertyClass, ObjectPtr, IndexInArray != INDEX_NONE && CanWriteIndex(Property));
+		return;
+	}
+
+	// Default, convert to string
+	FString ValueString;
+#if NY_ENGINE_VERSION >= 501
+	Property->ExportTextItem_Direct(ValueString, ValuePtr, ValuePtr, nullptr, PPF_None);
+#else
+	Property->ExportTextItem(ValueString, ValuePtr, ValuePtr, nullptr, PPF_None);
+#endif
+	WriteJsonScalar(Writer, Identifier, ValueString);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <class PrintPolicy>
+void FDlgJsonWriter::StreamPropertyToJson(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier,
+	const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr)
+{
+	check(Property);
+	if (ContainerPtr == nullptr || ValuePtr == nullptr)
+	{
+		LogUnhandledProperty(Property);
+		WriteJsonNull(Writer, Identifier);
+		return;
+	}
+
+	// Scalar Only one property
+	if (Property->ArrayDim == 1)
+	{
+		StreamScalarPropertyToJson(Writer, Identifier, Property, ContainerPtr, ValuePtr);
+		return;
+	}
+
+	// Array
+#if NY_ENGINE_VERSION >= 505
+	const int32 ElementSize = Property->GetElementSize();
+#else
+	const int32 ElementSize = Property->ElementSize;
+#endif
+	WriteJsonArrayStart(Writer, Identifier);
+	auto* ValueIntPtr = static_cast<const uint8*>(ValuePtr);
+	for (int Index = 0; Index < Property->ArrayDim; Index++)
+	{
+		IndexInArray = Index;
+		StreamScalarPropertyToJson(Writer, nullptr, Property, ContainerPtr, ValueIntPtr + Index * ElementSize);
+	}
+	Writer.WriteArrayEnd();
+
+	ResetState();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <class PrintPolicy>
+void FDlgJsonWriter::StreamMapToJson(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier,
+	const FMapProperty* MapProperty, const void* const ContainerPtr, const void* const ValuePtr)
+{
+	struct FMapEntry
+	{
+		int32 Index = INDEX_NONE;
+
+		// IndexInArray after the key was converted, the value is converted with it
+		int32 IndexInArray = INDEX_NONE;
+
+		FString KeyString;
+	};
+
+	// The keys are needed first: the FJsonObject only keeps the last value of the same (case insensitive) keys
+	const FDlgConstScriptMapHelper Helper(MapProperty, ValuePtr);
+	TArray<FMapEntry> Entries;
+	TSet<FString> KeyStrings;
+	bool bHasSameKeys = false;
+	for (int32 Index = 0; Index < Helper.GetMaxIndex(); Index++)
+	{
+		if (!Helper.IsValidIndex(Index))
+		{
+			continue;
+		}
+		IndexInArray = Index;
+
+		// The keys are small, this is the same conversion as the DOM
+		bIsPropertyMapKey = true;
+		const uint8* MapKeyPtr = Helper.GetConstKeyPtr(Index);
+		const TSharedPtr<FJsonValue> KeyElement = PropertyToJsonValue(Helper.GetKeyProperty(), ContainerPtr, MapKeyPtr);
+		bIsPropertyMapKey = false;
+
+		FMapEntry Entry;
+		Entry.Index = Index;
+		Entry.IndexInArray = IndexInArray;
+		Entry.KeyString = GetMapKeyString(MapProperty, MapKeyPtr, KeyElement, Index);
+
+		bool bIsAlreadyInSet = false;
+		KeyStrings.Add(Entry.KeyString, &bIsAlreadyInSet);
+		bHasSameKeys |= bIsAlreadyInSet;
+		Entries.Add(MoveTemp(Entry));
+	}
+
+	// Rare, let the FJsonObject decide which values are kept
+	if (bHasSameKeys)
+	{
+		WriteJsonDOMValue(Writer, Identifier, ConvertScalarPropertyToJsonValue(MapProperty, ContainerPtr, ValuePtr));
+		return;
+	}
+
+	WriteJsonObjectStart(Writer, Identifier);
+	for (const FMapEntry& Entry : Entries)
+	{
+		IndexInArray = Entry.IndexInArray;
+		StreamPropertyToJson(Writer, &Entry.KeyString, Helper.GetValueProperty(), ContainerPtr, Helper.GetConstValuePtr(Entry.Index));
+	}
+	Writer.WriteObjectEnd();
+
+	ResetState();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const UStruct* FDlgJsonWriter::GetStructDefinitionToWrite(const UStruct* StructDefinition, const void* const ContainerPtr, const UObject*& OutObject)
+{
+	OutObject = nullptr;
+	if (StructDefinition == nullptr || ContainerPtr == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Handle UObject inheritance (children of class)
+	if (StructDefinition->IsA<UClass>())
+	{
+		const UObject* UnrealObject = static_cast<const UObject*>(ContainerPtr);
+		if (!UnrealObject->IsValidLowLevelFast())
+		{
+			UE_LOG(
+				LogDlgJsonWriter,
+				Error,
+				TEXT("UStructToJsonObject: StructDefinition = `%s` is a UClass and expected ContainerPtr to be an UObject. Memory corruption?"),
+				*StructDefinition->GetPathName()
+			);
+			return nullptr;
+		}
+
+		// Structure points to the child
+		OutObject = UnrealObject;
+		StructDefinition = UnrealObject->GetClass();
+	}
+	if (!StructDefinition->IsValidLowLevelFast())
+	{
+		UE_LOG(
+			LogDlgJsonWriter,
+			Error,
+			TEXT("UStructToJsonObject: StructDefinition = `%s` is a UClass and expected ContainerPtr.Class to be valid. Memory corruption?"),
+			*StructDefinition->GetPathName()
+		);
+		return nullptr;
+	}
+
+	return StructDefinition;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <class PrintPolicy>
+bool FDlgJsonWriter::StreamUStructToJson(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier,
+	const UStruct* StructDefinition, const void* const ContainerPtr, bool bWriteIndex)
+{
+	if (StructDefinition == nullptr || ContainerPtr == nullptr)
+	{
+		WriteJsonNull(Writer, Identifier);
+		return false;
+	}
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgJsonWriter, Verbose, TEXT("StreamUStructToJson, StructDefinition = `%s`"), *StructDefinition->GetPathName());
+	}
+
+	// Json Wrapper, already have an Object. NOTE: the index metadata is not written, same as UStructToJsonAttributes
+	if (StructDefinition == FJsonObjectWrapper::StaticStruct())
+	{
+		const FJsonObjectWrapper* ProxyObject = static_cast<const FJsonObjectWrapper*>(ContainerPtr);
+		WriteJsonObjectStart(Writer, Identifier);
+		if (ProxyObject->JsonObject.IsValid())
+		{
+			for (const auto& Pair : ProxyObject->JsonObject->Values)
+			{
+				WriteJsonDOMValue(Writer, &Pair.Key, Pair.Value);
+			}
+		}
+		Writer.WriteObjectEnd();
+		return true;
+	}
+
+	// Invalid, nothing is written before we know it
+	const UObject* UnrealObject = nullptr;
+	StructDefinition = GetStructDefinitionToWrite(StructDefinition, ContainerPtr, UnrealObject);
+	if (StructDefinition == nullptr)
+	{
+		WriteJsonNull(Writer, Identifier);
+		return false;
+	}
+
+	static const FString IndexKey(TEXT("__index__"));
+	static const FString TypeKey(TEXT("__type__"));
+
+	// Same order as the keys of the FJsonObject
+	WriteJsonObjectStart(Writer, Identifier);
+	if (bWriteIndex)
+	{
+		WriteJsonScalar(Writer, &IndexKey, static_cast<double>(IndexInArray));
+	}
+	if (UnrealObject)
+	{
+		// Write type, Objects because they can have inheritance
+		WriteJsonScalar(Writer, &TypeKey, UnrealObject->GetClass()->GetName());
+	}
+
+	// Iterate over all the properties of the struct
+	for (TFieldIterator<const FProperty> It(StructDefinition); It; ++It)
+	{
+		const auto* Property = *It;
+		if (!ensure(Property))
+			continue;
+
+		// Check to see if we should ignore this property
+		if (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags))
+		{
+			continue;
+		}
+		if (CanSkipProperty(Property))
+		{
+			continue;
+		}
+
+		// Get the Pointer to the Value
+		const void* ValuePtr = nullptr;
+		if (Property->IsA<FObjectProperty>())
+		{
+			// Handle pointers, only allowed to be UObjects (are already pointers to the Value)
+			ValuePtr = ContainerPtr;
+		}
+		else
+		{
+			// Normal non pointer property
+			ValuePtr = Property->ContainerPtrToValuePtr<void>(ContainerPtr, 0);
+		}
+
+		// NOTE default JSON writer makes the first letter to be lowercase, we do not want that ;) FJsonObjectConverter::StandardizeCase
+		const FString VariableName = Property->GetName();
+		StreamPropertyToJson(Writer, &VariableName, Property, ContainerPtr, ValuePtr);
+	}
+
+	Writer.WriteObjectEnd();
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <class PrintPolicy>
+bool FDlgJsonWriter::StreamUStructToJsonWriter(TJsonWriter<TCHAR, PrintPolicy>& Writer, const UStruct* StructDefinition, const void* const ContainerPtr)
+{
+	const bool bSuccess = StreamUStructToJson(Writer, nullptr, StructDefinition, ContainerPtr, false);
+	return Writer.Close() && bSuccess;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonWriter::CanStreamUStruct(const UStruct* StructDefinition, const void* const ContainerPtr)
+{
+	if (StructDefinition == FJsonObjectWrapper::StaticStruct())
+	{
+		return ContainerPtr != nullptr;
+	}
+
+	const UObject* UnrealObject = nullptr;
+	return GetStructDefinitionToWrite(StructDefinition, ContainerPtr, UnrealObject) != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonWriter::StreamUStructToJsonString(const UStruct* StructDefinition, const void* const ContainerPtr,
+	const DlgJsonWriterOptions& Options, FString& OutJsonString)
+{
+	// Same as UStructToJsonString, the string is not modified if the struct is not valid
+	if (CanStreamUStruct(StructDefinition, ContainerPtr))
+	{
+		bool bSuccess;
+		if (Options.bPrettyPrint)
+		{
+			auto JsonWriter = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&OutJsonString, Options.InitialIndent);
+			bSuccess = StreamUStructToJsonWriter(*JsonWriter, StructDefinition, ContainerPtr);
+		}
+		else
+		{
+			auto JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJsonString, Options.InitialIndent);
+			bSuccess = StreamUStructToJsonWriter(*JsonWriter, StructDefinition, ContainerPtr);
+		}
+
+		if (bSuccess)
+		{
+			return true;
+		}
+	}
+
+	UE_LOG(LogDlgJsonWriter, Error, TEXT("StreamUStructToJsonString - Unable to write out json"));
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonWriter::StreamUStructToJsonArchive(const UStruct* StructDefinition, const void* const ContainerPtr,
+	const DlgJsonWriterOptions& Options, FArchive& Archive)
+{
+	if (CanStreamUStruct(StructDefinition, ContainerPtr))
+	{
+		bool bSuccess;
+		if (Options.bPrettyPrint)
+		{
+			auto JsonWriter = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Archive, Options.InitialIndent);
+			bSuccess = StreamUStructToJsonWriter(*JsonWriter, StructDefinition, ContainerPtr);
+		}
+		else
+		{
+			auto JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Archive, Options.InitialIndent);
+			bSuccess = StreamUStructToJsonWriter(*JsonWriter, StructDefinition, ContainerPtr);
+		}
+
+		if (bSuccess)
+		{
+			return true;
+		}
+	}
+
+	UE_LOG(LogDlgJsonWriter, Error, TEXT("StreamUStructToJsonArchive - Unable to write out json"));
+	return false;
+}
@@ -6,6 +6,7 @@
 #include "Misc/FileHelper.h"
 #include "Dom/JsonValue.h"
 #include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
 
 #include "IDlgWriter.h"
 
@@ -34,6 +35,15 @@ class DLGSYSTEM_API FDlgJsonWriter : public IDlgWriter
 	 *						- ConvertScalarPropertyToJsonValue
 	 *							- PropertyToJsonValue
 	 *							- UStructToJsonObject
+	 *
+	 *  - DlgJsonWriter (streaming, default, see SetUseStreamingWriter)
+	 *		- StreamUStructToJsonString / StreamUStructToJsonArchive
+	 *			- StreamUStructToJson
+	 *				- StreamPropertyToJson
+	 *					- StreamScalarPropertyToJson
+	 *						- StreamPropertyToJson
+	 *						- StreamMapToJson
+	 *						- StreamUStructToJson
 	 */
 public:
 
@@ -57,6 +67,25 @@ public:
 		return JsonString;
 	}
 
+	/**
+	 * Writes the JSON directly to the Archive as UTF-8, the bytes are the same as Write + ExportToFile.
+	 * Neither the FJsonObject nor the string of the whole file is built.
+	 * @return	False on failure to write
+	 */
+	bool WriteToArchive(const UStruct* StructDefinition, const void* ContainerPtr, FArchive& Archive);
+
+	/**
+	 * Same as WriteToArchive but to the file, the file is written while the properties are converted.
+	 * Writes into FileName + ".tmp" and only replaces FileName if everything was written.
+	 * @param FileName: Full path + file name + extension
+	 * @return	False on failure to write
+	 */
+	bool WriteToFile(const UStruct* StructDefinition, const void* ContainerPtr, const FString& FileName);
+
+	// bUseStreamingWriter:
+	bool IsUsingStreamingWriter() const { return bUseStreamingWriter; }
+	void SetUseStreamingWriter(bool bValue) { bUseStreamingWriter = bValue; }
+
 private: // UStruct -> JSON
 	/**
 	 * Convert property to JSON, assuming either the property is not an array or the value is an individual array element
@@ -112,6 +141,49 @@ private: // UStruct -> JSON
 	bool UStructToJsonString(const UStruct* StructDefinition, const void* const ContainerPtr, const DlgJsonWriterOptions& Options,
 							 FString& OutJsonString);
 
+	// Logs the property that does not have a value
+	void LogUnhandledProperty(const FProperty* Property) const;
+
+private: // UStruct -> JSON, streaming
+
+	/**
+	 * Same as the UStruct -> JSON functions but the values are written directly to the TJsonWriter, in the same order
+	 * as the FJsonObject keys, so the output is the same without building the FJsonObject.
+	 * Only the map keys and the FJsonObjectWrapper values are FJsonValues.
+	 * The Identifier is nullptr for the values inside arrays.
+	 */
+	template <class PrintPolicy>
+	void StreamScalarPropertyToJson(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier,
+									const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr);
+
+	template <class PrintPolicy>
+	void StreamPropertyToJson(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier,
+							  const FProperty* Property, const void* const ContainerPtr, const void* const ValuePtr);
+
+	// If the map has the same (case insensitive) key strings it is converted to a FJsonObject, which keeps only the last value
+	template <class PrintPolicy>
+	void StreamMapToJson(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier,
+						 const FMapProperty* MapProperty, const void* const ContainerPtr, const void* const ValuePtr);
+
+	// Writes null if the struct is not valid, bWriteIndex adds the __index__ metadata (see CanWriteIndex)
+	template <class PrintPolicy>
+	bool StreamUStructToJson(TJsonWriter<TCHAR, PrintPolicy>& Writer, const FString* Identifier,
+							 const UStruct* StructDefinition, const void* const ContainerPtr, bool bWriteIndex);
+
+	template <class PrintPolicy>
+	bool StreamUStructToJsonWriter(TJsonWriter<TCHAR, PrintPolicy>& Writer, const UStruct* StructDefinition, const void* const ContainerPtr);
+
+	// Returns the struct that is written for the ContainerPtr (the class of the object for UClasses) or nullptr if it is not valid
+	const UStruct* GetStructDefinitionToWrite(const UStruct* StructDefinition, const void* const ContainerPtr, const UObject*& OutObject);
+	bool CanStreamUStruct(const UStruct* StructDefinition, const void* const ContainerPtr);
+
+	bool StreamUStructToJsonString(const UStruct* StructDefinition, const void* const ContainerPtr, const DlgJsonWriterOptions& Options,
+								   FString& OutJsonString);
+
+	// The Archive gets TCHARs, see FDlgJsonUTF8ArchiveProxy
+	bool StreamUStructToJsonArchive(const UStruct* StructDefinition, const void* const ContainerPtr, const DlgJsonWriterOptions& Options,
+									FArchive& Archive);
+
 	void ResetState()
 	{
 		IndexInArray = INDEX_NONE;
@@ -122,6 +194,9 @@ private:
 	// Final output string
 	FString JsonString;
 
+	// Write the values directly with the TJsonWriter instead of building the FJsonObject of the whole struct first
+	bool bUseStreamingWriter = true;
+
 	/** Only properties that have these flags will be written. */
 	static constexpr int64 CheckFlags = ~CPF_ParmFlags; // all properties except those who have these flags? TODO is this ok?
 
@@ -1,10 +1,11 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #pragma once
 
-#include "UObject/UObjectIterator.h"
 #include "Containers/Array.h"
 #include "UObject/Object.h"
 
+#include "DlgSystem/NYReflectionHelper.h"
+
 class DLGSYSTEM_API IDlgParser
 {
 public:
@@ -35,6 +36,7 @@ public:
 protected:
 	/**
 	 * Searches the proper not abstract class
+	 * The classes are looked up in the index shared by all the parsers, see FNYReflectionHelper::FindChildClassCached
 	 *
 	 * @param ParentClass: the class we are looking for has to inherit from this class
 	 * @param Name: the name of the class we are looking for (without engine pretags, e.g. Actor for AActor)
@@ -43,24 +45,7 @@ protected:
 	 */
 	const UClass* GetChildClassFromName(const UClass* ParentClass, const FString& Name)
 	{
-		for (UClass* Class : StructCache)
-		{
-			if (Class->IsChildOf(ParentClass) && Class->GetName() == Name)
-			{
-				return Class;
-			}
-		}
-
-		for (TObjectIterator<UClass> It; It; ++It)
-		{
-			if (It->IsChildOf(ParentClass) && !It->HasAnyClassFlags(CLASS_Abstract) && (*It)->GetName() == Name)
-			{
-				StructCache.Add(*It);
-				return *It;
-			}
-		}
-
-		return nullptr;
+		return FNYReflectionHelper::FindChildClassCached(ParentClass, Name);
 	}
 
 	/**
@@ -73,9 +58,6 @@ protected:
 	}
 
 protected:
-	/** each time a class is read it also cached here, so next time when it has to be found based on name it can be found faster */
-	TArray<UClass*> StructCache;
-
 	// Should this class verbose log?
 	bool bLogVerbose = false;
 };
@@ -0,0 +1,192 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgAsyncLogSink.h"
+
+#include "HAL/PlatformTime.h"
+
+FString FDlgAsyncLogSinkStats::ToString() const
+{
+	return FString::Printf(
+		TEXT("Enqueued = %lld, Dispatched = %lld, Dropped = %lld, RateLimited = %lld, Collapsed = %lld"),
+		Enqueued, Dispatched, Dropped, RateLimited, Collapsed
+	);
+}
+
+bool FDlgAsyncLogSink::Enqueue(ENYLoggerLogLevel Level, const FString& Message)
+{
+	// The counter can go a bit over the limit with concurrent producers, that is fine
+	const int32 MaxQueued = MaxQueuedNum.GetValue();
+	if (MaxQueued > 0 && QueuedNum.GetValue() >= MaxQueued)
+	{
+		DroppedNum.Increment();
+		return false;
+	}
+
+	QueuedNum.Increment();
+	EnqueuedNum.Increment();
+	Queue.Enqueue(FQueuedMessage{Level, Message});
+	return true;
+}
+
+void FDlgAsyncLogSink::Flush(FDispatchFunction Dispatch, bool bAll)
+{
+	check(IsInGameThread());
+	if (Queue.IsEmpty())
+	{
+		if (SuppressedEntriesNum > 0)
+		{
+			FlushSuppressed(Dispatch, FPlatformTime::Seconds(), bAll);
+		}
+		return;
+	}
+
+	const double NowSeconds = FPlatformTime::Seconds();
+	const int32 MaxMessages = bAll || Options.MaxMessagesPerFlush <= 0 ? MAX_int32 : Options.MaxMessagesPerFlush;
+
+	// Gather the batch, keeping the order of the first occurrence of each message
+	struct FBatchMessage
+	{
+		FQueuedMessage Queued;
+		uint32 Key = 0;
+		int32 RepeatNum = 1;
+	};
+	TArray<FBatchMessage> Batch;
+	TMap<uint32, int32> BatchIndexByKey;
+
+	FQueuedMessage Queued;
+	int32 DequeuedNum = 0;
+	while (DequeuedNum < MaxMessages && Queue.Dequeue(Queued))
+	{
+		DequeuedNum++;
+		QueuedNum.Decrement();
+
+		const uint32 Key = GetMessageKey(Queued.Level, Queued.Message);
+		if (Options.bCollapseDuplicates)
+		{
+			if (const int32* BatchIndex = BatchIndexByKey.Find(Key))
+			{
+				// Hash collisions are possible, only collapse the same text
+				FBatchMessage& Existing = Batch[*BatchIndex];
+				if (Existing.Queued.Level == Queued.Level && Existing.Queued.Message == Queued.Message)
+				{
+					Existing.RepeatNum++;
+					FlushStats.Collapsed++;
+					continue;
+				}
+			}
+			BatchIndexByKey.Add(Key, Batch.Num());
+		}
+
+		FBatchMessage& Message = Batch.AddDefaulted_GetRef();
+		Message.Queued = MoveTemp(Queued);
+		Message.Key = Key;
+	}
+
+	for (FBatchMessage& Message : Batch)
+	{
+		int32 SuppressedNum = 0;
+		if (!PassesRateLimit(Message.Queued, Message.Key, NowSeconds, SuppressedNum))
+		{
+			FlushStats.RateLimited += Message.RepeatNum;
+			continue;
+		}
+
+		FString& Text = Message.Queued.Message;
+		if (Message.RepeatNum > 1)
+		{
+			Text += FString::Printf(TEXT(" [Repeated %d times]"), Message.RepeatNum);
+		}
+		if (SuppressedNum > 0)
+		{
+			Text = GetSuppressedText(Text, SuppressedNum);
+		}
+
+		Dispatch(Message.Queued.Level, Text);
+		FlushStats.Dispatched++;
+	}
+
+	FlushSuppressed(Dispatch, NowSeconds, bAll);
+}
+
+void FDlgAsyncLogSink::FlushSuppressed(FDispatchFunction Dispatch, double NowSeconds, bool bAll)
+{
+	// Only iterate over all the windows if something has to be reported or from time to time, so that the map does not grow forever
+	const bool bCleanup = NowSeconds - LastRateLimitsCleanupSeconds > 10.0;
+	if (!bAll && !bCleanup && SuppressedEntriesNum == 0)
+	{
+		return;
+	}
+	if (bCleanup)
+	{
+		LastRateLimitsCleanupSeconds = NowSeconds;
+	}
+
+	for (auto It = RateLimits.CreateIterator(); It; ++It)
+	{
+		FRateLimitEntry& Entry = It.Value();
+		if (!bAll && NowSeconds - Entry.WindowStartSeconds < 1.0)
+		{
+			continue;
+		}
+
+		// The same message was not output again after the window, report the suppressed ones now
+		if (Entry.SuppressedNum > 0)
+		{
+			Dispatch(Entry.Suppressed.Level, GetSuppressedText(Entry.Suppressed.Message, Entry.SuppressedNum));
+			FlushStats.Dispatched++;
+			SuppressedEntriesNum--;
+		}
+		It.RemoveCurrent();
+	}
+}
+
+bool FDlgAsyncLogSink::PassesRateLimit(const FQueuedMessage& Message, uint32 MessageKey, double NowSeconds, int32& OutSuppressedNum)
+{
+	OutSuppressedNum = 0;
+	if (Options.MaxSameMessagesPerSecond <= 0)
+	{
+		return true;
+	}
+
+	FRateLimitEntry& Entry = RateLimits.FindOrAdd(MessageKey);
+	if (NowSeconds - Entry.WindowStartSeconds >= 1.0)
+	{
+		Entry.WindowStartSeconds = NowSeconds;
+		Entry.OutputNum = 0;
+	}
+
+	if (Entry.OutputNum >= Options.MaxSameMessagesPerSecond)
+	{
+		if (Entry.SuppressedNum == 0)
+		{
+			Entry.Suppressed = Message;
+			SuppressedEntriesNum++;
+		}
+		Entry.SuppressedNum++;
+		return false;
+	}
+
+	Entry.OutputNum++;
+	OutSuppressedNum = Entry.SuppressedNum;
+	if (Entry.SuppressedNum > 0)
+	{
+		Entry.SuppressedNum = 0;
+		Entry.Suppressed = FQueuedMessage();
+		SuppressedEntriesNum--;
+	}
+	return true;
+}
+
+FDlgAsyncLogSinkStats FDlgAsyncLogSink::GetStats() const
+{
+	FDlgAsyncLogSinkStats Stats = FlushStats;
+	Stats.Enqueued = EnqueuedNum.GetValue();
+	Stats.Dropped = DroppedNum.GetValue();
+	return Stats;
+}
+
+void FDlgAsyncLogSink::ResetStats()
+{
+	FlushStats = FDlgAsyncLogSinkStats();
+	EnqueuedNum.Reset();
+	DroppedNum.Reset();
+}
@@ -0,0 +1,139 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+#include "INYLogger.h"
+
+// Configuration of the FDlgAsyncLogSink, see UDlgSystemSettings
+struct DLGSYSTEM_API FDlgAsyncLogSinkOptions
+{
+	// Maximum number of times the same message (same level and text) is output in a second, 0 means unlimited
+	int32 MaxSameMessagesPerSecond = 5;
+
+	// Maximum number of messages output by a single Flush, the rest are kept for the next Flush. 0 means unlimited
+	int32 MaxMessagesPerFlush = 100;
+
+	// Maximum number of messages waiting in the queue, new messages are dropped after this. 0 means unlimited
+	int32 MaxQueuedMessages = 4096;
+
+	// Output the identical messages of a Flush only once, with the number of repeats
+	bool bCollapseDuplicates = true;
+};
+
+// Counters of a FDlgAsyncLogSink
+struct DLGSYSTEM_API FDlgAsyncLogSinkStats
+{
+	int64 Enqueued = 0;
+	int64 Dispatched = 0;
+
+	// Dropped because the queue was full
+	int64 Dropped = 0;
+
+	// Not output because of MaxSameMessagesPerSecond
+	int64 RateLimited = 0;
+
+	// Collapsed into another message because of bCollapseDuplicates
+	int64 Collapsed = 0;
+
+	FString ToString() const;
+};
+
+/**
+ * Queue of log messages that are dispatched later to the logger outputs (message log, on screen, ...) in batches.
+ * Any thread can enqueue (lock free multiple producers), Flush must be called from the game thread
+ * because the outputs are not thread safe. FDlgLogger flushes it at the end of every frame.
+ *
+ * Because the messages are batched, the same message logged in a loop is only output a few times,
+ * with the number of suppressed/collapsed messages appended to it. The suppressed messages that are not followed by the same
+ * message are reported by the first Flush after their rate limit window ends.
+ */
+class DLGSYSTEM_API FDlgAsyncLogSink
+{
+public:
+	using FDispatchFunction = TFunctionRef<void(ENYLoggerLogLevel Level, const FString& Message)>;
+
+	// Game thread only, the producers only read MaxQueuedMessages (see MaxQueuedNum)
+	void SetOptions(const FDlgAsyncLogSinkOptions& InOptions)
+	{
+		check(IsInGameThread());
+		Options = InOptions;
+		MaxQueuedNum.Set(InOptions.MaxQueuedMessages);
+	}
+	const FDlgAsyncLogSinkOptions& GetOptions() const { return Options; }
+
+	// Thread safe. Returns false if the message was dropped because the queue is full
+	bool Enqueue(ENYLoggerLogLevel Level, const FString& Message);
+
+	// Game thread only. Outputs at most MaxMessagesPerFlush messages with Dispatch
+	// If bAll is true, all the queued messages and the suppressed messages summaries are output (e.g. on shutdown)
+	void Flush(FDispatchFunction Dispatch, bool bAll = false);
+
+	bool IsEmpty() const { return QueuedNum.GetValue() == 0; }
+	int32 GetQueuedNum() const { return QueuedNum.GetValue(); }
+
+	// Game thread only
+	FDlgAsyncLogSinkStats GetStats() const;
+	void ResetStats();
+
+protected:
+	struct FQueuedMessage
+	{
+		ENYLoggerLogLevel Level = ENYLoggerLogLevel::NoLogging;
+		FString Message;
+	};
+
+	// Rate limit window of the same message
+	struct FRateLimitEntry
+	{
+		double WindowStartSeconds = 0.0;
+		int32 OutputNum = 0;
+
+		// Reported with the next message that is output, or when the window ends (see FlushSuppressed)
+		int32 SuppressedNum = 0;
+
+		// The suppressed message, only set if SuppressedNum > 0
+		FQueuedMessage Suppressed;
+	};
+
+	// Returns false if the message should not be output because of MaxSameMessagesPerSecond
+	bool PassesRateLimit(const FQueuedMessage& Message, uint32 MessageKey, double NowSeconds, int32& OutSuppressedNum);
+
+	// Outputs the summary of the suppressed messages whose window ended (all of them if bAll) and forgets the old windows
+	void FlushSuppressed(FDispatchFunction Dispatch, double NowSeconds, bool bAll);
+
+	static FString GetSuppressedText(const FString& Message, int32 SuppressedNum)
+	{
+		return FString::Printf(TEXT("%s [%d identical messages suppressed]"), *Message, SuppressedNum);
+	}
+
+	static uint32 GetMessageKey(ENYLoggerLogLevel Level, const FString& Message)
+	{
+		return HashCombine(GetTypeHash(Message), ::GetTypeHash(static_cast<uint8>(Level)));
+	}
+
+protected:
+	// Game thread only
+	FDlgAsyncLogSinkOptions Options;
+
+	// Options.MaxQueuedMessages for the producers
+	FThreadSafeCounter MaxQueuedNum{FDlgAsyncLogSinkOptions().MaxQueuedMessages};
+
+	TQueue<FQueuedMessage, EQueueMode::Mpsc> Queue;
+	FThreadSafeCounter QueuedNum;
+
+	// Written by the producers
+	FThreadSafeCounter64 EnqueuedNum;
+	FThreadSafeCounter64 DroppedNum;
+
+	// Game thread only
+	TMap<uint32, FRateLimitEntry> RateLimits;
+	FDlgAsyncLogSinkStats FlushStats;
+	double LastRateLimitsCleanupSeconds = 0.0;
+
+	// Number of the RateLimits entries with SuppressedNum > 0
+	int32 SuppressedEntriesNum = 0;
+};
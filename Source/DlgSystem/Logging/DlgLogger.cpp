@@ -1,13 +1,17 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #include "DlgLogger.h"
+
+#include "Misc/CoreDelegates.h"
+
 #include "DlgSystem/DlgSystemModule.h"
 #include "DlgSystem/DlgSystemSettings.h"
 
 #define LOCTEXT_NAMESPACE "DlgLogger"
 
 static const FName MESSAGE_LOG_NAME{TEXT("Dialogue Plugin")};
+static FDelegateHandle OnEndFrameHandle;
 
-FDlgLogger::FDlgLogger() : Super()
+FDlgLogger::FDlgLogger() : Super(), AsyncSink(MakeShared<FDlgAsyncLogSink, ESPMode::ThreadSafe>())
 {
 	static constexpr bool bOwnMessageLogMirrorToOutputLog = true;
 	EnableMessageLog(bOwnMessageLogMirrorToOutputLog);
@@ -36,17 +40,93 @@ FDlgLogger& FDlgLogger::SyncWithSettings()
 	SetOpenMessageLogLevelsHigherThan(Settings->OpenMessageLogLevelsHigherThan);
 	SetMessageLogOpenOnNewMessage(Settings->bMessageLogOpen);
 
+	// Errors are always logged
+	SetDiscardLogLevelsHigherThan(FMath::Max(Settings->DiscardLogLevelsHigherThan, ENYLoggerLogLevel::Error));
+
+	if (Settings->bEnableAsyncLogging)
+	{
+		FDlgAsyncLogSinkOptions Options;
+		Options.MaxSameMessagesPerSecond = Settings->AsyncLogMaxSameMessagesPerSecond;
+		Options.MaxMessagesPerFlush = Settings->AsyncLogMaxMessagesPerFrame;
+		Options.MaxQueuedMessages = Settings->AsyncLogMaxQueuedMessages;
+		Options.bCollapseDuplicates = Settings->bAsyncLogCollapseDuplicates;
+		EnableAsyncSink(Options);
+	}
+	else
+	{
+		DisableAsyncSink();
+	}
+
 	return *this;
 }
 
+bool FDlgLogger::IsOutputLogLevelEnabled(ENYLoggerLogLevel Level) const
+{
+#if NO_LOGGING
+	return false;
+#else
+	return !LogDlgSystem.IsSuppressed(GetUnrealLogTypeForLogLevel(Level));
+#endif // NO_LOGGING
+}
+
+FDlgLogger& FDlgLogger::EnableAsyncSink(const FDlgAsyncLogSinkOptions& Options)
+{
+	AsyncSink->SetOptions(Options);
+	bAsyncSinkEnabled = true;
+	return *this;
+}
+
+FDlgLogger& FDlgLogger::DisableAsyncSink()
+{
+	if (bAsyncSinkEnabled)
+	{
+		// Do not lose the queued messages. A producer can still enqueue after this, those are output by the next FlushAsyncSink
+		bAsyncSinkEnabled = false;
+		FlushAsyncSink(true);
+	}
+	return *this;
+}
+
+void FDlgLogger::FlushAsyncSink(bool bAll)
+{
+	AsyncSink->Flush([this](ENYLoggerLogLevel Level, const FString& Message)
+	{
+		DispatchLog(Level, Message);
+	}, bAll);
+}
+
+bool FDlgLogger::EnqueueLog(ENYLoggerLogLevel Level, const FString& Message)
+{
+	if (!bAsyncSinkEnabled)
+	{
+		return false;
+	}
+
+	// Dropped messages are counted by the sink
+	AsyncSink->Enqueue(Level, Message);
+	return true;
+}
+
+void FDlgLogger::HandleOnEndFrame()
+{
+	Get().FlushAsyncSink();
+}
+
 void FDlgLogger::OnStart()
 {
 	MessageLogRegisterLogName(MESSAGE_LOG_NAME, LOCTEXT("dlg_key", "Dialogue System Plugin"));
 	Get().SyncWithSettings();
+	OnEndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&Self::HandleOnEndFrame);
 }
 
 void FDlgLogger::OnShutdown()
 {
+	if (OnEndFrameHandle.IsValid())
+	{
+		FCoreDelegates::OnEndFrame.Remove(OnEndFrameHandle);
+		OnEndFrameHandle.Reset();
+	}
+	Get().DisableAsyncSink();
 	MessageLogUnregisterLogName(MESSAGE_LOG_NAME);
 }
 
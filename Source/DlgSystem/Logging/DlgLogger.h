@@ -2,7 +2,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
 #include "INYLogger.h"
+#include "DlgAsyncLogSink.h"
 
 
 class DLGSYSTEM_API FDlgLogger : public INYLogger
@@ -29,4 +31,32 @@ public:
 
 	static void OnStart();
 	static void OnShutdown();
+
+	//
+	// Async sink
+	//
+
+	// Queue the messages and output them at the end of the frame, see FDlgAsyncLogSink
+	// NOTE: Configure it from the game thread, disabling it outputs all the queued messages
+	Self& EnableAsyncSink(const FDlgAsyncLogSinkOptions& Options = {});
+	Self& DisableAsyncSink();
+
+	bool IsAsyncSinkEnabled() const { return bAsyncSinkEnabled; }
+	const FDlgAsyncLogSink& GetAsyncSink() const { return *AsyncSink; }
+
+	// Outputs the queued messages (also after the sink was disabled), game thread only
+	void FlushAsyncSink(bool bAll = false);
+
+protected:
+	// Respect the verbosity of LogDlgSystem (e.g. log LogDlgSystem Warning)
+	bool IsOutputLogLevelEnabled(ENYLoggerLogLevel Level) const override;
+
+	bool EnqueueLog(ENYLoggerLogLevel Level, const FString& Message) override;
+
+	static void HandleOnEndFrame();
+
+protected:
+	// Created once and never replaced, the producers only check bAsyncSinkEnabled so that enabling/disabling it is thread safe
+	TSharedRef<FDlgAsyncLogSink, ESPMode::ThreadSafe> AsyncSink;
+	FThreadSafeBool bAsyncSinkEnabled;
 };
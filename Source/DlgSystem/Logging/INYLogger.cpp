@@ -211,6 +211,34 @@ void INYLogger::LogfImplementation(ENYLoggerLogLevel Level, const TCHAR* Fmt, ..
 // #endif // NO_LOGGING
 // }
 
+bool INYLogger::IsLevelEnabled(ENYLoggerLogLevel Level) const
+{
+#if NO_LOGGING
+	return false;
+#else
+	if (Level == ENYLoggerLogLevel::NoLogging || Level > DiscardLogLevelsHigherThan)
+	{
+		return false;
+	}
+	if (IsClientConsoleEnabled() || IsOnScreenEnabled())
+	{
+		return true;
+	}
+	if (IsMessageLogEnabled() && !IsMessageLogLevelRedirected(Level))
+	{
+		return true;
+	}
+
+	// Only the output log is left, directly or redirected from the message log
+	if (IsOutputLogEnabled() || IsMessageLogEnabled())
+	{
+		return IsOutputLogLevelEnabled(Level);
+	}
+
+	return false;
+#endif // NO_LOGGING
+}
+
 void INYLogger::Log(ENYLoggerLogLevel Level, const FString& Message)
 {
 	// Should not happen but just in case redirect to the fatal function
@@ -221,6 +249,24 @@ void INYLogger::Log(ENYLoggerLogLevel Level, const FString& Message)
 	// }
 
 	// No logging, abort
+#if !NO_LOGGING
+	if (Level == ENYLoggerLogLevel::NoLogging || Level > DiscardLogLevelsHigherThan)
+	{
+		return;
+	}
+
+	// Output later
+	if (EnqueueLog(Level, Message))
+	{
+		return;
+	}
+
+	DispatchLog(Level, Message);
+#endif // !NO_LOGGING
+}
+
+void INYLogger::DispatchLog(ENYLoggerLogLevel Level, const FString& Message)
+{
 #if !NO_LOGGING
 	if (IsClientConsoleEnabled())
 	{
@@ -280,8 +326,7 @@ void INYLogger::LogClientConsole(ENYLoggerLogLevel Level, const FString& Message
 void INYLogger::LogMessageLog(ENYLoggerLogLevel Level, const FString& Message)
 {
 	// Should we be redirecting this message log because
-	if (RedirectMessageLogLevelsHigherThan != ENYLoggerLogLevel::NoLogging &&
-		Level > RedirectMessageLogLevelsHigherThan)
+	if (IsMessageLogLevelRedirected(Level))
 	{
 		// Redirect to the output log if not enabled
 		if (!IsOutputLogEnabled())
@@ -259,6 +259,18 @@ public:
 		return *this;
 	}
 
+	//
+	// Filter
+	//
+
+	// All the log levels higher than this are discarded by all the outputs
+	// NOTE: A value of ENYLoggerLogLevel::Trace means no log level is discarded
+	Self& SetDiscardLogLevelsHigherThan(ENYLoggerLogLevel AfterLevel)
+	{
+		DiscardLogLevelsHigherThan = AfterLevel;
+		return *this;
+	}
+
 	static bool IsMessageLogNameRegistered(FName LogName);
 	static bool MessageLogUnregisterLogName(FName LogName);
 	static void MessageLogRegisterLogName(FName LogName, const FText& LogLabel, const FNYMessageLogInitializationOptions& InitOptions = {});
@@ -293,6 +305,10 @@ public:
 	FORCEINLINE bool IsOutputLogEnabled() const { return bOutputLog; }
 	FORCEINLINE bool IsMessageLogEnabled() const { return bMessageLog; }
 
+	// Would a message of this Level be output by any of the enabled outputs?
+	// Used to not build messages that are discarded anyway, see LogLazy
+	bool IsLevelEnabled(ENYLoggerLogLevel Level) const;
+
 	template <typename FmtType, typename... Types>
 	void Logf(ENYLoggerLogLevel Level, const FmtType& Fmt, Types... Args)
 	{
@@ -302,7 +318,10 @@ public:
 		static_assert(TIsArrayOrRefOfType<FmtType, TCHAR>::Value, "Formatting string must be a TCHAR array.");
 #endif
 		static_assert(TAnd<TIsValidVariadicFunctionArg<Types>...>::Value, "Invalid argument(s) passed to INYLogger::Logf");
-		LogfImplementation(Level, Fmt, Args...);
+		if (IsLevelEnabled(Level))
+		{
+			LogfImplementation(Level, Fmt, Args...);
+		}
 	}
 
 	template <typename FmtType, typename... Types>
@@ -332,9 +351,42 @@ public:
 	FORCEINLINE void Debug(const FString& Message) { Log(ENYLoggerLogLevel::Debug, Message); }
 	FORCEINLINE void Trace(const FString& Message) { Log(ENYLoggerLogLevel::Trace, Message); }
 
+	// Deferred formatting, MessageBuilder returns the FString message and it is only called if the Level is enabled.
+	// Use it when building the message is expensive (e.g. UDlgContext::GetContextString), the arguments should be
+	// captured by the lambda instead of being formatted at the call site.
+	template <typename BuilderType>
+	void LogLazy(ENYLoggerLogLevel Level, BuilderType&& MessageBuilder)
+	{
+		if (IsLevelEnabled(Level))
+		{
+			Log(Level, MessageBuilder());
+		}
+	}
+
+	template <typename BuilderType>
+	void ErrorLazy(BuilderType&& MessageBuilder) { LogLazy(ENYLoggerLogLevel::Error, Forward<BuilderType>(MessageBuilder)); }
+
+	template <typename BuilderType>
+	void WarningLazy(BuilderType&& MessageBuilder) { LogLazy(ENYLoggerLogLevel::Warning, Forward<BuilderType>(MessageBuilder)); }
+
+	template <typename BuilderType>
+	void InfoLazy(BuilderType&& MessageBuilder) { LogLazy(ENYLoggerLogLevel::Info, Forward<BuilderType>(MessageBuilder)); }
+
+	template <typename BuilderType>
+	void DebugLazy(BuilderType&& MessageBuilder) { LogLazy(ENYLoggerLogLevel::Debug, Forward<BuilderType>(MessageBuilder)); }
+
+	template <typename BuilderType>
+	void TraceLazy(BuilderType&& MessageBuilder) { LogLazy(ENYLoggerLogLevel::Trace, Forward<BuilderType>(MessageBuilder)); }
+
 protected:
 	void VARARGS LogfImplementation(ENYLoggerLogLevel Level, const TCHAR* Fmt, ...);
 
+	// Outputs the message to all the enabled outputs right now
+	void DispatchLog(ENYLoggerLogLevel Level, const FString& Message);
+
+	// Return true if the message was queued to be dispatched later (see DispatchLog), false to dispatch it right now
+	virtual bool EnqueueLog(ENYLoggerLogLevel Level, const FString& Message) { return false; }
+
 #if WITH_UNREAL_DEVELOPER_TOOLS
 	static FMessageLogModule* GetMessageLogModule();
 #endif // WITH_UNREAL_DEVELOPER_TOOLS
@@ -344,6 +396,15 @@ protected:
 	virtual void LogMessageLog(ENYLoggerLogLevel Level, const FString& Message);
 	virtual void LogClientConsole(ENYLoggerLogLevel Level, const FString& Message);
 
+	// Is the Level not suppressed by the output log category, only asked if the output log is the only output of the Level
+	virtual bool IsOutputLogLevelEnabled(ENYLoggerLogLevel Level) const { return true; }
+
+	// Is the Level sent to the output log instead of the message log, see RedirectMessageLogLevelsHigherThan
+	bool IsMessageLogLevelRedirected(ENYLoggerLogLevel Level) const
+	{
+		return RedirectMessageLogLevelsHigherThan != ENYLoggerLogLevel::NoLogging && Level > RedirectMessageLogLevelsHigherThan;
+	}
+
 	static ELogVerbosity::Type GetUnrealLogTypeForLogLevel(ENYLoggerLogLevel Level)
 	{
 	 	switch (Level)
@@ -471,6 +532,13 @@ protected:
 	// NOTE: A value of  ENYLoggerLogLevel::NoLogging means all log levels will be opened if bMessageLogOpen is true
 	ENYLoggerLogLevel OpenMessageLogLevelsHigherThan = ENYLoggerLogLevel::NoLogging;
 
+	//
+	// Filter
+	//
+
+	// All the log levels higher than this are discarded by all the outputs
+	ENYLoggerLogLevel DiscardLogLevelsHigherThan = ENYLoggerLogLevel::Trace;
+
 	//
 	// Client console
 	//
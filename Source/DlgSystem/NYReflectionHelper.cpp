@@ -0,0 +1,301 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "NYReflectionHelper.h"
+
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+namespace
+{
+	struct FNYPropertyCacheKey
+	{
+		const UClass* Class = nullptr;
+		FName VariableName;
+		const FFieldClass* PropertyClass = nullptr;
+
+		bool operator==(const FNYPropertyCacheKey& Other) const
+		{
+			return Class == Other.Class && VariableName == Other.VariableName && PropertyClass == Other.PropertyClass;
+		}
+
+		friend uint32 GetTypeHash(const FNYPropertyCacheKey& Key)
+		{
+			return HashCombine(HashCombine(PointerHash(Key.Class), GetTypeHash(Key.VariableName)), PointerHash(Key.PropertyClass));
+		}
+	};
+
+	// A cached value with the struct it was computed from. The caches are keyed by raw pointers, if the struct is garbage
+	// collected (and its address reused) the weak pointer is no longer valid for it and the value is computed again.
+	// This way the caches do not have to be cleared after every garbage collection.
+	template <typename ValueType>
+	struct TNYCachedValue
+	{
+		bool IsValidFor(const UStruct* InStruct) const { return Struct.Get() == InStruct; }
+
+		TWeakObjectPtr<const UStruct> Struct;
+		ValueType Value;
+	};
+
+	// Maps to nullptr if the property does not exist
+	TMap<FNYPropertyCacheKey, TNYCachedValue<FProperty*>> PropertyCache;
+	TMap<const UStruct*, TNYCachedValue<TSharedRef<const TArray<FNYNamedProperty>>>> StructPropertiesCache;
+	TMap<TPair<const UClass*, FName>, TNYCachedValue<FNYFunctionBinding>> FunctionCache;
+	// Not abstract child classes of a parent class by name
+	struct FNYChildClassIndex
+	{
+		TMap<FName, TWeakObjectPtr<UClass>> Classes;
+
+		// Names that were not found with the sweep over all the classes, only checked with FindClassByName after that
+		TSet<FName> MissingNames;
+	};
+
+	// Key: parent class
+	TMap<const UClass*, TNYCachedValue<TSharedRef<const FNYChildClassIndex>>> ChildClassesCache;
+	FRWLock PropertyCacheLock;
+
+	// Finds a loaded class by name with the name hash of the objects, without iterating over all the classes
+	UClass* FindClassByName(FName Name)
+	{
+#if NY_ENGINE_VERSION >= 501
+		return FindFirstObject<UClass>(*Name.ToString(), EFindFirstObjectOptions::None);
+#else
+		return FindObject<UClass>(ANY_PACKAGE, *Name.ToString());
+#endif
+	}
+}
+
+FProperty* FNYReflectionHelper::FindPropertyCached(const UClass* Class, FName VariableName, const FFieldClass* PropertyClass)
+{
+	if (!Class || !PropertyClass)
+	{
+		return nullptr;
+	}
+
+	const FNYPropertyCacheKey Key{ Class, VariableName, PropertyClass };
+	{
+		FReadScopeLock ReadLock(PropertyCacheLock);
+		const TNYCachedValue<FProperty*>* CachedProperty = PropertyCache.Find(Key);
+		if (CachedProperty && CachedProperty->IsValidFor(Class))
+		{
+			return CachedProperty->Value;
+		}
+	}
+
+	FProperty* FoundProperty = nullptr;
+	for (FProperty* Property = Class->PropertyLink; Property != nullptr; Property = Property->PropertyLinkNext)
+	{
+		if (Property->IsA(PropertyClass) && Property->GetFName() == VariableName)
+		{
+			FoundProperty = Property;
+			break;
+		}
+	}
+
+	FWriteScopeLock WriteLock(PropertyCacheLock);
+	PropertyCache.Add(Key, { Class, FoundProperty });
+	return FoundProperty;
+}
+
+TSharedRef<const TArray<FNYNamedProperty>> FNYReflectionHelper::GetStructPropertiesCached(const UStruct* Struct)
+{
+	check(Struct);
+	{
+		FReadScopeLock ReadLock(PropertyCacheLock);
+		const TNYCachedValue<TSharedRef<const TArray<FNYNamedProperty>>>* CachedProperties = StructPropertiesCache.Find(Struct);
+		if (CachedProperties && CachedProperties->IsValidFor(Struct))
+		{
+			return CachedProperties->Value;
+		}
+	}
+
+	TSharedRef<TArray<FNYNamedProperty>> Properties = MakeShared<TArray<FNYNamedProperty>>();
+	for (TFieldIterator<FProperty> PropIt(Struct); PropIt; ++PropIt)
+	{
+		if (FProperty* Property = *PropIt)
+		{
+			Properties->Add({ Property, Property->GetName() });
+		}
+	}
+
+	FWriteScopeLock WriteLock(PropertyCacheLock);
+	StructPropertiesCache.Add(Struct, { Struct, Properties });
+	return Properties;
+}
+
+FNYFunctionBinding FNYReflectionHelper::FindFunctionCached(const UClass* Class, FName FunctionName)
+{
+	if (!Class)
+	{
+		return {};
+	}
+
+	const TPair<const UClass*, FName> Key(Class, FunctionName);
+	{
+		FReadScopeLock ReadLock(PropertyCacheLock);
+		const TNYCachedValue<FNYFunctionBinding>* CachedBinding = FunctionCache.Find(Key);
+		if (CachedBinding && CachedBinding->IsValidFor(Class))
+		{
+			return CachedBinding->Value;
+		}
+	}
+
+	FNYFunctionBinding Binding;
+	Binding.Function = Class->FindFunctionByName(FunctionName);
+	if (Binding.Function)
+	{
+		Binding.ParmsSize = Binding.Function->ParmsSize;
+		for (TFieldIterator<FProperty> It(Binding.Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			if (!It->HasAnyPropertyFlags(CPF_OutParm | CPF_ReturnParm))
+			{
+				Binding.InputParamsNum++;
+			}
+		}
+
+		// Reported each time the binding is found (the first call for each class, again after the cache is invalidated), the call still happens
+		if (Binding.InputParamsNum > 0)
+		{
+			UE_LOG(
+				LogDlgSystemReflectionHelper,
+				Warning,
+				TEXT("Function %s of Class %s has %d input parameters, it is called with the default values"),
+				*FunctionName.ToString(), *Class->GetName(), Binding.InputParamsNum
+			);
+		}
+	}
+
+	FWriteScopeLock WriteLock(PropertyCacheLock);
+	FunctionCache.Add(Key, { Class, Binding });
+	return Binding;
+}
+
+void FNYReflectionHelper::CallFunction(UObject* Object, const FNYFunctionBinding& Binding)
+{
+	check(Object && Binding.IsValid());
+	if (Binding.ParmsSize == 0)
+	{
+		Object->ProcessEvent(Binding.Function, nullptr);
+		return;
+	}
+
+	// ProcessEvent reads and writes the parameters, give it a valid buffer
+	// NOTE: only the parameters fit into ParmsSize, InitializeStruct/DestroyStruct would also touch the locals of the function
+	// (PropertiesSize), same as UObject::CallFunctionByNameWithArguments
+	uint8* Parms = static_cast<uint8*>(FMemory_Alloca_Aligned(Binding.ParmsSize, Binding.Function->GetMinAlignment()));
+	FMemory::Memzero(Parms, Binding.ParmsSize);
+	for (TFieldIterator<FProperty> It(Binding.Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		It->InitializeValue_InContainer(Parms);
+	}
+
+	Object->ProcessEvent(Binding.Function, Parms);
+
+	for (TFieldIterator<FProperty> It(Binding.Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		It->DestroyValue_InContainer(Parms);
+	}
+}
+
+const UClass* FNYReflectionHelper::FindChildClassCached(const UClass* ParentClass, const FString& ClassName)
+{
+	if (!ParentClass)
+	{
+		return nullptr;
+	}
+
+	// Every class name is already in the name table, do not add the unknown ones
+	const FName Name(*ClassName, FNAME_Find);
+	if (Name.IsNone())
+	{
+		return nullptr;
+	}
+
+	auto IsMatchingClass = [ParentClass](const UClass* Class)
+	{
+		return Class->IsChildOf(ParentClass) && !Class->HasAnyClassFlags(CLASS_Abstract);
+	};
+
+	TSharedPtr<const FNYChildClassIndex> ChildClasses;
+	{
+		FReadScopeLock ReadLock(PropertyCacheLock);
+		const TNYCachedValue<TSharedRef<const FNYChildClassIndex>>* CachedChildClasses = ChildClassesCache.Find(ParentClass);
+		if (CachedChildClasses && CachedChildClasses->IsValidFor(ParentClass))
+		{
+			ChildClasses = CachedChildClasses->Value;
+		}
+	}
+
+	if (!ChildClasses.IsValid())
+	{
+		// One sweep for all the children, keep the first one for each name like the sweep before the cache did
+		TSharedRef<FNYChildClassIndex> NewChildClasses = MakeShared<FNYChildClassIndex>();
+		for (TObjectIterator<UClass> It; It; ++It)
+		{
+			if (IsMatchingClass(*It) && !NewChildClasses->Classes.Contains(It->GetFName()))
+			{
+				NewChildClasses->Classes.Add(It->GetFName(), *It);
+			}
+		}
+
+		FWriteScopeLock WriteLock(PropertyCacheLock);
+		ChildClassesCache.Add(ParentClass, { ParentClass, NewChildClasses });
+		ChildClasses = NewChildClasses;
+	}
+
+	// The child class could have been garbage collected since then
+	const TWeakObjectPtr<UClass>* CachedClass = ChildClasses->Classes.Find(Name);
+	if (CachedClass && CachedClass->IsValid())
+	{
+		return CachedClass->Get();
+	}
+
+	// The class could have been loaded since the index was built (e.g. a blueprint class)
+	UClass* FoundClass = nullptr;
+	if (ChildClasses->MissingNames.Contains(Name))
+	{
+		// Already swept for it, only check the classes loaded since then
+		UClass* Class = FindClassByName(Name);
+		if (!Class || !IsMatchingClass(Class))
+		{
+			return nullptr;
+		}
+		FoundClass = Class;
+	}
+	else
+	{
+		for (TObjectIterator<UClass> It; It; ++It)
+		{
+			if (It->GetFName() == Name && IsMatchingClass(*It))
+			{
+				FoundClass = *It;
+				break;
+			}
+		}
+	}
+
+	// The shared index is immutable, the readers could still use it
+	TSharedRef<FNYChildClassIndex> UpdatedChildClasses = MakeShared<FNYChildClassIndex>(*ChildClasses);
+	if (FoundClass)
+	{
+		UpdatedChildClasses->Classes.Add(Name, FoundClass);
+		UpdatedChildClasses->MissingNames.Remove(Name);
+	}
+	else
+	{
+		UpdatedChildClasses->Classes.Remove(Name);
+		UpdatedChildClasses->MissingNames.Add(Name);
+	}
+
+	FWriteScopeLock WriteLock(PropertyCacheLock);
+	ChildClassesCache.Add(ParentClass, { ParentClass, UpdatedChildClasses });
+	return FoundClass;
+}
+
+void FNYReflectionHelper::ClearPropertyCache()
+{
+	FWriteScopeLock WriteLock(PropertyCacheLock);
+	PropertyCache.Reset();
+	StructPropertiesCache.Reset();
+	FunctionCache.Reset();
+	ChildClassesCache.Reset();
+}
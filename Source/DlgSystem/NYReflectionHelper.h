@@ -13,6 +13,27 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogDlgSystemReflectionHelper, All, All)
 
+// Property with its name, see FNYReflectionHelper::GetStructPropertiesCached
+struct FNYNamedProperty
+{
+	FProperty* Property = nullptr;
+	FString Name;
+};
+
+// Function with its parameter layout, see FNYReflectionHelper::FindFunctionCached
+struct FNYFunctionBinding
+{
+	bool IsValid() const { return Function != nullptr; }
+
+	UFunction* Function = nullptr;
+
+	// Size of the parameters buffer ProcessEvent expects, 0 if the function does not have any parameters (or return value)
+	int32 ParmsSize = 0;
+
+	// Number of parameters that are not outputs, they are passed with their default values
+	int32 InputParamsNum = 0;
+};
+
 class DLGSYSTEM_API FNYReflectionHelper
 {
 public:
@@ -88,6 +109,38 @@ public:
 	}
 #endif // NY_ENGINE_VERSION >= 425
 
+	// Finds the property VariableName that is a PropertyClass in Class. Returns nullptr if it does not exist.
+	// The result (also the missing ones) is cached per (Class, VariableName, PropertyClass), see ClearPropertyCache.
+	static FProperty* FindPropertyCached(const UClass* Class, FName VariableName, const FFieldClass* PropertyClass);
+
+	template <typename PropertyType>
+	static const PropertyType* FindProperty(const UClass* Class, FName VariableName)
+	{
+		return static_cast<const PropertyType*>(FindPropertyCached(Class, VariableName, PropertyType::StaticClass()));
+	}
+
+	// Gets all the properties of Struct (including the inherited ones, same order as TFieldIterator) with their names.
+	// The result is cached per Struct, see ClearPropertyCache.
+	static TSharedRef<const TArray<FNYNamedProperty>> GetStructPropertiesCached(const UStruct* Struct);
+
+	// Finds the function FunctionName (also the inherited ones) of Class and validates its parameters. Invalid if it does not exist.
+	// The result (also the missing ones) is cached per (Class, FunctionName), see ClearPropertyCache.
+	static FNYFunctionBinding FindFunctionCached(const UClass* Class, FName FunctionName);
+
+	// Calls the function on Object with default values for all the parameters, the parameters buffer is on the stack
+	static void CallFunction(UObject* Object, const FNYFunctionBinding& Binding);
+
+	// Finds the not abstract class called ClassName (without engine pretags, e.g. Actor for AActor) that is a child of ParentClass.
+	// Returns nullptr if it does not exist. The children of ParentClass are indexed by name with one sweep over all the classes,
+	// the index is shared by all the parsers, see ClearPropertyCache. The missing names are also cached, after the first miss
+	// a name only costs a lookup by name (for the classes loaded since then) instead of another sweep.
+	static const UClass* FindChildClassCached(const UClass* ParentClass, const FString& ClassName);
+
+	// Clears the cache of FindPropertyCached, GetStructPropertiesCached, FindFunctionCached and FindChildClassCached. Must be called when the properties of the classes could have changed
+	// (hot reload, reinstancing, blueprint compile, module load). Garbage collected classes do not need it, every cached entry
+	// keeps a weak pointer to its class and is computed again if the class is no longer alive.
+	static void ClearPropertyCache();
+
 	// Attempts to get the property VariableName from Object
 	template <typename PropertyType, typename VariableType>
 	static VariableType GetVariable(const UObject* Object, FName VariableName)
@@ -103,13 +156,9 @@ public:
 			return VariableType{};
 		}
 
-		for (auto* Property = Object->GetClass()->PropertyLink; Property != nullptr; Property = Property->PropertyLinkNext)
+		if (const PropertyType* CastedProperty = FindProperty<PropertyType>(Object->GetClass(), VariableName))
 		{
-			const PropertyType* CastedProperty = CastProperty<PropertyType>(Property);
-			if (CastedProperty != nullptr && CastedProperty->GetFName() == VariableName)
-			{
-				return CastedProperty->GetPropertyValue_InContainer(Object, 0);
-			}
+			return CastedProperty->GetPropertyValue_InContainer(Object, 0);
 		}
 
 		UE_LOG(
@@ -144,15 +193,11 @@ public:
 		}
 
 		// Modify the current variable
-		for (auto* Property = Object->GetClass()->PropertyLink; Property != nullptr; Property = Property->PropertyLinkNext)
+		if (const PropertyType* CastedProperty = FindProperty<PropertyType>(Object->GetClass(), VariableName))
 		{
-			const PropertyType* CastedProperty = CastProperty<PropertyType>(Property);
-			if (CastedProperty != nullptr && CastedProperty->GetFName() == VariableName)
-			{
-				const VariableType OldValue = CastedProperty->GetPropertyValue_InContainer(Object, 0);
-				CastedProperty->SetPropertyValue_InContainer(Object, OldValue + Value);
-				return;
-			}
+			const VariableType OldValue = CastedProperty->GetPropertyValue_InContainer(Object, 0);
+			CastedProperty->SetPropertyValue_InContainer(Object, OldValue + Value);
+			return;
 		}
 
 		UE_LOG(
@@ -179,14 +224,10 @@ public:
 			return;
 		}
 
-		for (auto* Property = Object->GetClass()->PropertyLink; Property != nullptr; Property = Property->PropertyLinkNext)
+		if (const PropertyType* CastedProperty = FindProperty<PropertyType>(Object->GetClass(), VariableName))
 		{
-			const PropertyType* CastedProperty = CastProperty<PropertyType>(Property);
-			if (CastedProperty != nullptr && CastedProperty->GetFName() == VariableName)
-			{
-				CastedProperty->SetPropertyValue_InContainer(Object, NewValue);
-				return;
-			}
+			CastedProperty->SetPropertyValue_InContainer(Object, NewValue);
+			return;
 		}
 
 		UE_LOG(
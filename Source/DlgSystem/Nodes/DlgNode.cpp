@@ -6,8 +6,10 @@
 #include "Sound/SoundWave.h"
 
 #include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
 #include "DlgSystem/Logging/DlgLogger.h"
 #include "DlgSystem/DlgLocalizationHelper.h"
+#include "DlgSystem/DlgVisitedNodes.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Begin UObject interface
@@ -108,6 +110,12 @@ void UDlgNode::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEven
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 
+	// Keep the compiled representation in sync with the edited conditions/edges
+	if (UDlgDialogue* Dialogue = Cast<UDlgDialogue>(GetOuter()))
+	{
+		Dialogue->RebuildRuntimeGraph();
+	}
+
 	// Signal to the listeners
 	OnDialogueNodePropertyChanged.Broadcast(PropertyChangedEvent, BroadcastPropertyEdgeIndexChanged);
 	BroadcastPropertyEdgeIndexChanged = INDEX_NONE;
@@ -130,17 +138,26 @@ void UDlgNode::PostEditChangeChainProperty(struct FPropertyChangedChainEvent& Pr
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Begin own function
-bool UDlgNode::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgNode::HandleNodeEnter(UDlgContext& Context, FDlgVisitedNodes& NodesEnteredWithThisStep)
 {
 	// Fire all the node enter events
 	FireNodeEnterEvents(Context);
 
-	for (FDlgEdge& Edge : Children)
+	// The constructed edge texts are kept in the Context, the Children of this node are never modified at runtime
+	TArray<FText>& ConstructedEdgeTexts = Context.FindOrAddNodeState(this).ConstructedEdgeTexts;
+	ConstructedEdgeTexts.Reset();
+	for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); EdgeIndex++)
 	{
-		Edge.RebuildConstructedText(Context, OwnerName);
+		const FDlgEdge& Edge = Children[EdgeIndex];
+		if (Edge.GetTextArguments().Num() > 0)
+		{
+			ConstructedEdgeTexts.SetNum(Children.Num());
+			ConstructedEdgeTexts[EdgeIndex] = Edge.ConstructText(Context, OwnerName);
+		}
 	}
 
-	return ReevaluateChildren(Context, {});
+	FDlgVisitedNodes AlreadyEvaluated(Context.GetDialogue());
+	return ReevaluateChildren(Context, AlreadyEvaluated);
 }
 
 void UDlgNode::FireNodeEnterEvents(UDlgContext& Context)
@@ -155,27 +172,45 @@ void UDlgNode::FireNodeEnterEvents(UDlgContext& Context)
 		}
 
 		Event.Call(Context, TEXT("FireNodeEnterEvents"), Participant);
+
+		// The event can change anything the conditions read
+		Context.GetNodeEvaluationCache().Invalidate();
 	}
 }
 
-bool UDlgNode::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated)
+bool UDlgNode::ReevaluateChildren(UDlgContext& Context, FDlgVisitedNodes& AlreadyEvaluated)
 {
+	// NOTE: Reset keeps the memory, this is called each frame for some dialogues
 	TArray<FDlgEdge>& AvailableOptions = Context.GetMutableOptionsArray();
 	TArray<FDlgEdgeData>& AllOptions = Context.GetAllMutableOptionsArray();
-	AvailableOptions.Empty();
-	AllOptions.Empty();
+	AvailableOptions.Reset();
+	AllOptions.Reset();
 
-	for (const FDlgEdge& Edge : Children)
+	// Each edge starts the evaluation from this node
+	FDlgVisitedNodes VisitedNodes(Context.GetDialogue());
+	const FDlgVisitedNodes::FScope VisitedScope(VisitedNodes, this);
+
+	const FDlgNodeContextState* State = Context.FindNodeState(this);
+	for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); EdgeIndex++)
 	{
-		const bool bSatisfied = Edge.Evaluate(Context, { this });
+		const FDlgEdge& Edge = Children[EdgeIndex];
+		const bool bSatisfied = Edge.Evaluate(Context, VisitedNodes);
+		if (!bSatisfied && !Edge.bIncludeInAllOptionListIfUnsatisfied)
+		{
+			continue;
+		}
 
-		if (bSatisfied || Edge.bIncludeInAllOptionListIfUnsatisfied)
+		// The options are owned by the Context, so they can hold the text constructed for this Context
+		FDlgEdge Option = Edge;
+		if (State)
 		{
-			AllOptions.Add(FDlgEdgeData{ bSatisfied, Edge });
+			Option.SetConstructedText(State->GetConstructedEdgeText(EdgeIndex));
 		}
+
+		AllOptions.Add(FDlgEdgeData{ bSatisfied, Option });
 		if (bSatisfied)
 		{
-			AvailableOptions.Add(Edge);
+			AvailableOptions.Add(MoveTemp(Option));
 		}
 	}
 
@@ -185,9 +220,12 @@ bool UDlgNode::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> Al
 		switch (GetDefault<UDlgSystemSettings>()->NoSatisfiedChildBehavior)
 		{
 			case EDlgNoSatisfiedChildBehavior::PrintErrorAndEndDialogue:
-				FDlgLogger::Get().Errorf(
-					TEXT("ReevaluateChildren (ReevaluateOptions) - no valid child option for a NODE.\nContext:\n\t%s"),
-					*Context.GetContextString());
+				FDlgLogger::Get().ErrorLazy([&]()
+				{
+					return FString::Printf(
+						TEXT("ReevaluateChildren (ReevaluateOptions) - no valid child option for a NODE.\nContext:\n\t%s"),
+						*Context.GetContextString());
+				});
 
 			case EDlgNoSatisfiedChildBehavior::EndDialogue:
 				return false;
@@ -203,14 +241,15 @@ bool UDlgNode::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> Al
 	return true;
 }
 
-bool UDlgNode::CheckNodeEnterConditions(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
+bool UDlgNode::CheckNodeEnterConditions(const UDlgContext& Context, FDlgVisitedNodes& AlreadyVisitedNodes) const
 {
 	if (AlreadyVisitedNodes.Contains(this))
 	{
+		Context.GetNodeEvaluationCache().NotifyLoopCut();
 		return true;
 	}
 
-	AlreadyVisitedNodes.Add(this);
+	const FDlgVisitedNodes::FScope VisitedScope(AlreadyVisitedNodes, this);
 	if (!FDlgCondition::EvaluateArray(Context, EnterConditions, OwnerName))
 	{
 		return false;
@@ -248,18 +287,35 @@ bool UDlgNode::CheckNodeEnterConditions(const UDlgContext& Context, TSet<const U
 	return HasAnySatisfiedChild(Context, AlreadyVisitedNodes);
 }
 
-bool UDlgNode::HasAnySatisfiedChild(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
+bool UDlgNode::HasAnySatisfiedChild(const UDlgContext& Context) const
 {
-	for (const FDlgEdge& Edge : Children)
+	const FDlgNodeEvaluationCache::FScope EvaluationScope(Context.GetNodeEvaluationCache());
+	FDlgVisitedNodes AlreadyVisitedNodes(Context.GetDialogue());
+	return HasAnySatisfiedChild(Context, AlreadyVisitedNodes);
+}
+
+bool UDlgNode::HasAnySatisfiedChild(const UDlgContext& Context, FDlgVisitedNodes& AlreadyVisitedNodes) const
+{
+	// Only cache it if the index really belongs to this node
+	int32 NodeIndex = Context.GetNodeIndexForGUID(NodeGUID);
+	if (Context.GetNodeFromIndex(NodeIndex) != this)
 	{
-		// Found at least one valid child
-		if (Edge.Evaluate(Context, AlreadyVisitedNodes))
+		NodeIndex = INDEX_NONE;
+	}
+
+	return Context.GetNodeEvaluationCache().FindOrEvaluateSatisfiedChild(NodeIndex, [this, &Context, &AlreadyVisitedNodes]()
+	{
+		for (const FDlgEdge& Edge : Children)
 		{
-			return true;
+			// Found at least one valid child
+			if (Edge.Evaluate(Context, AlreadyVisitedNodes))
+			{
+				return true;
+			}
 		}
-	}
 
-	return false;
+		return false;
+	});
 }
 
 bool UDlgNode::OptionSelected(int32 OptionIndex, bool bFromAll, UDlgContext& Context)
@@ -270,13 +326,16 @@ bool UDlgNode::OptionSelected(int32 OptionIndex, bool bFromAll, UDlgContext& Con
 		if (AllOptions.IsValidIndex(OptionIndex))
 		{
 			check(AllOptions[OptionIndex].IsValid());
-			return Context.EnterNode(AllOptions[OptionIndex].GetEdge().TargetIndex, {});
+			return Context.EnterNode(AllOptions[OptionIndex].GetEdge().TargetIndex);
 		}
 
-		FDlgLogger::Get().Errorf(
-			TEXT("OptionSelected - Failed to choose OptionIndex = %d from AllOptions - it only has %d valid options.\nContext:\n\t%s"),
-			OptionIndex, AllOptions.Num(), *Context.GetContextString()
-		);
+		FDlgLogger::Get().ErrorLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("OptionSelected - Failed to choose OptionIndex = %d from AllOptions - it only has %d valid options.\nContext:\n\t%s"),
+				OptionIndex, AllOptions.Num(), *Context.GetContextString()
+			);
+		});
 	}
 	else
 	{
@@ -284,13 +343,16 @@ bool UDlgNode::OptionSelected(int32 OptionIndex, bool bFromAll, UDlgContext& Con
 		if (AvailableOptions.IsValidIndex(OptionIndex))
 		{
 			check(AvailableOptions[OptionIndex].IsValid());
-			return Context.EnterNode(AvailableOptions[OptionIndex].TargetIndex, {});
+			return Context.EnterNode(AvailableOptions[OptionIndex].TargetIndex);
 		}
 
-		FDlgLogger::Get().Errorf(
-			TEXT("OptionSelected - Failed to choose OptionIndex = %d from AvailableOptions - it only has %d valid options.\nContext:\n\t%s"),
-			OptionIndex, AvailableOptions.Num(), *Context.GetContextString()
-		);
+		FDlgLogger::Get().ErrorLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("OptionSelected - Failed to choose OptionIndex = %d from AvailableOptions - it only has %d valid options.\nContext:\n\t%s"),
+				OptionIndex, AvailableOptions.Num(), *Context.GetContextString()
+			);
+		});
 	}
 	return false;
 }
@@ -393,6 +455,14 @@ void UDlgNode::RebuildTextArguments(bool bEdges, bool bUpdateGraphNode)
 	}
 }
 
+void UDlgNode::RebuildTextFormats()
+{
+	for (FDlgEdge& Edge : Children)
+	{
+		Edge.RebuildTextFormat();
+	}
+}
+
 void UDlgNode::UpdateGraphNode()
 {
 #if WITH_EDITOR
@@ -418,5 +488,40 @@ USoundWave* UDlgNode::GetNodeVoiceSoundWave() const
 	return Cast<USoundWave>(GetNodeVoiceSoundBase());
 }
 
+FText UDlgNode::GetNodeTextForContext(const UDlgContext* Context) const
+{
+	return IsValid(Context) ? GetNodeTextInContext(*Context) : GetNodeText();
+}
+
+FName UDlgNode::GetNodeParticipantNameForContext(const UDlgContext* Context) const
+{
+	return IsValid(Context) ? GetNodeParticipantNameInContext(*Context) : GetNodeParticipantName();
+}
+
+FName UDlgNode::GetSpeakerStateForContext(const UDlgContext* Context) const
+{
+	return IsValid(Context) ? GetSpeakerStateInContext(*Context) : GetSpeakerState();
+}
+
+USoundBase* UDlgNode::GetNodeVoiceSoundBaseForContext(const UDlgContext* Context) const
+{
+	return IsValid(Context) ? GetNodeVoiceSoundBaseInContext(*Context) : GetNodeVoiceSoundBase();
+}
+
+UDialogueWave* UDlgNode::GetNodeVoiceDialogueWaveForContext(const UDlgContext* Context) const
+{
+	return IsValid(Context) ? GetNodeVoiceDialogueWaveInContext(*Context) : GetNodeVoiceDialogueWave();
+}
+
+UObject* UDlgNode::GetNodeGenericDataForContext(const UDlgContext* Context) const
+{
+	return IsValid(Context) ? GetNodeGenericDataInContext(*Context) : GetNodeGenericData();
+}
+
+UDlgNodeData* UDlgNode::GetNodeDataForContext(const UDlgContext* Context) const
+{
+	return IsValid(Context) ? GetNodeDataInContext(*Context) : GetNodeData();
+}
+
 // End own functions
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
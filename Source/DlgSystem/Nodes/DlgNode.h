@@ -24,6 +24,7 @@ class USoundWave;
 class UDialogueWave;
 struct FDlgTextArgument;
 class UDlgDialogue;
+class FDlgVisitedNodes;
 
 
 UENUM(BlueprintType)
@@ -99,11 +100,14 @@ public:
 	DECLARE_EVENT_TwoParams(UDlgNode, FDialogueNodePropertyChanged, const FPropertyChangedEvent& /* PropertyChangedEvent */, int32 /* EdgeIndexChanged */);
 	FDialogueNodePropertyChanged OnDialogueNodePropertyChanged;
 
-	virtual bool HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep);
-	virtual bool ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated);
+	// NOTE: the visited nodes sets are passed by reference, every node must leave them as they were before the call
+	// (use FDlgVisitedNodes::FScope), see FDlgVisitedNodes
+	virtual bool HandleNodeEnter(UDlgContext& Context, FDlgVisitedNodes& NodesEnteredWithThisStep);
+	virtual bool ReevaluateChildren(UDlgContext& Context, FDlgVisitedNodes& AlreadyEvaluated);
 
-	virtual bool CheckNodeEnterConditions(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
-	bool HasAnySatisfiedChild(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
+	virtual bool CheckNodeEnterConditions(const UDlgContext& Context, FDlgVisitedNodes& AlreadyVisitedNodes) const;
+	bool HasAnySatisfiedChild(const UDlgContext& Context) const;
+	bool HasAnySatisfiedChild(const UDlgContext& Context, FDlgVisitedNodes& AlreadyVisitedNodes) const;
 
 	// if bFromAll = true it uses all the options (even unsatisfied)
 	// if bFromAll = false it only uses the satisfied options.
@@ -146,6 +150,9 @@ public:
 
 	virtual void SetNodeEnterConditions(const TArray<FDlgCondition>& InEnterConditions) { EnterConditions = InEnterConditions; }
 
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
+	EDlgEntryRestriction GetEnterRestriction() const { return EnterRestriction; }
+
 	// Gets the mutable enter condition at location EnterConditionIndex.
 	virtual FDlgCondition* GetMutableEnterConditionAt(int32 EnterConditionIndex)
 	{
@@ -228,8 +235,11 @@ public:
 	virtual void RebuildTextArguments(bool bEdges, bool bUpdateGraphNode = true);
 	virtual void RebuildTextArgumentsFromPreview(const FText& Preview) {}
 
-	// Constructs the ConstructedText.
-	virtual void RebuildConstructedText(const UDlgContext& Context) {}
+	// Compiles the format patterns of the texts with arguments of this node (and of the edges), see FDlgTextArgument::CompileTextFormat
+	virtual void RebuildTextFormats();
+
+	// Constructs the text of this node for the Context (stored inside the Context, not on this node)
+	virtual void RebuildConstructedText(UDlgContext& Context) {}
 
 	// Gets the text arguments for this Node (if any). Used for FText::Format
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
@@ -240,6 +250,7 @@ public:
 	};
 
 	// Gets the Text of this Node. This can be the final formatted string.
+	// NOTE: the runtime state (formatted text, active speech sequence entry) is per context, see GetNodeTextForContext
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual const FText& GetNodeText() const { return FText::GetEmpty(); }
 
@@ -277,6 +288,45 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual UDlgNodeData* GetNodeData() const { return nullptr; }
 
+	//
+	// Getters for the runtime state of this node inside a Context.
+	// Nodes that have per context state (formatted text, speech sequence index) override these,
+	// otherwise they are the same as the context free getters above.
+	//
+
+	virtual const FText& GetNodeTextInContext(const UDlgContext& Context) const { return GetNodeText(); }
+	virtual FName GetNodeParticipantNameInContext(const UDlgContext& Context) const { return GetNodeParticipantName(); }
+	virtual FName GetSpeakerStateInContext(const UDlgContext& Context) const { return GetSpeakerState(); }
+	virtual USoundBase* GetNodeVoiceSoundBaseInContext(const UDlgContext& Context) const { return GetNodeVoiceSoundBase(); }
+	virtual UDialogueWave* GetNodeVoiceDialogueWaveInContext(const UDlgContext& Context) const { return GetNodeVoiceDialogueWave(); }
+	virtual UObject* GetNodeGenericDataInContext(const UDlgContext& Context) const { return GetNodeGenericData(); }
+	virtual UDlgNodeData* GetNodeDataInContext(const UDlgContext& Context) const { return GetNodeData(); }
+
+	//
+	// Blueprint versions of the context getters above, if Context is not valid they return the context free values
+	//
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
+	FText GetNodeTextForContext(const UDlgContext* Context) const;
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
+	FName GetNodeParticipantNameForContext(const UDlgContext* Context) const;
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
+	FName GetSpeakerStateForContext(const UDlgContext* Context) const;
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
+	USoundBase* GetNodeVoiceSoundBaseForContext(const UDlgContext* Context) const;
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
+	UDialogueWave* GetNodeVoiceDialogueWaveForContext(const UDlgContext* Context) const;
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
+	UObject* GetNodeGenericDataForContext(const UDlgContext* Context) const;
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
+	UDlgNodeData* GetNodeDataForContext(const UDlgContext* Context) const;
+
 	// Helper method to get directly the Dialogue (which is our parent)
 	UDlgDialogue* GetDialogue() const;
 
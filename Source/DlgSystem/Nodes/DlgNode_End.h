@@ -25,7 +25,7 @@ public:
 	FString GetDesc() override;
 
 	// Begin UDlgNode Interface.
-	bool ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated) override { return false; }
+	bool ReevaluateChildren(UDlgContext& Context, FDlgVisitedNodes& AlreadyEvaluated) override { return false; }
 	bool OptionSelected(int32 OptionIndex, bool bFromAll, UDlgContext& Context) override { return false; }
 
 #if WITH_EDITOR
@@ -3,28 +3,32 @@
 
 #include "DlgSystem/DlgContext.h"
 #include "DlgSystem/Logging/DlgLogger.h"
+#include "DlgSystem/DlgVisitedNodes.h"
 
-bool UDlgNode_Proxy::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgNode_Proxy::HandleNodeEnter(UDlgContext& Context, FDlgVisitedNodes& NodesEnteredWithThisStep)
 {
 	FireNodeEnterEvents(Context);
 
 	if (NodesEnteredWithThisStep.Contains(this))
 	{
-		FDlgLogger::Get().Errorf(
-			TEXT("ProxyNode::HandleNodeEnter - Failed to enter proxy node, it was entered multiple times in a single step."
-					"Theoretically with some condition magic it could make sense, but chances are that it is an endless loop,"
-					"thus entering the same proxy twice with a single step is not supported. Dialogue is terminated.\nContext:\n\t%s"),
-			*Context.GetContextString()
-		);
+		FDlgLogger::Get().ErrorLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("ProxyNode::HandleNodeEnter - Failed to enter proxy node, it was entered multiple times in a single step."
+						"Theoretically with some condition magic it could make sense, but chances are that it is an endless loop,"
+						"thus entering the same proxy twice with a single step is not supported. Dialogue is terminated.\nContext:\n\t%s"),
+				*Context.GetContextString()
+			);
+		});
 
 		return false;
 	}
-	NodesEnteredWithThisStep.Add(this);
+	const FDlgVisitedNodes::FScope EnteredScope(NodesEnteredWithThisStep, this);
 
 	return Context.EnterNode(NodeIndex, NodesEnteredWithThisStep);
 }
 
-bool UDlgNode_Proxy::CheckNodeEnterConditions(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
+bool UDlgNode_Proxy::CheckNodeEnterConditions(const UDlgContext& Context, FDlgVisitedNodes& AlreadyVisitedNodes) const
 {
 	if (!Super::CheckNodeEnterConditions(Context, AlreadyVisitedNodes))
 	{
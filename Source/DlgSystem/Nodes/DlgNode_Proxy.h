@@ -29,8 +29,8 @@ public:
 	// Begin UDlgNode Interface.
 	//
 
-	bool HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep) override;
-	virtual bool CheckNodeEnterConditions(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const override;
+	bool HandleNodeEnter(UDlgContext& Context, FDlgVisitedNodes& NodesEnteredWithThisStep) override;
+	virtual bool CheckNodeEnterConditions(const UDlgContext& Context, FDlgVisitedNodes& AlreadyVisitedNodes) const override;
 
 #if WITH_EDITOR
 	FString GetNodeTypeString() const override { return TEXT("Proxy"); }
@@ -46,6 +46,9 @@ public:
 	// return with the index of the target in the UDlgDialogue::Nodes array
 	int32 GetTargetNodeIndex() const { return NodeIndex; }
 
+	// Sets the index of the target in the UDlgDialogue::Nodes array. Use with care.
+	void SetTargetNodeIndex(int32 InNodeIndex) { NodeIndex = InNodeIndex; }
+
 
 	// Helper functions to get the names of some properties. Used by the DlgSystemEditor module.
 	static FName GetMemberNameNodeIndex() { return GET_MEMBER_NAME_CHECKED(UDlgNode_Proxy, NodeIndex); }
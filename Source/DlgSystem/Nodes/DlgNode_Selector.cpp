@@ -3,6 +3,7 @@
 
 #include "DlgSystem/DlgContext.h"
 #include "DlgSystem/Logging/DlgLogger.h"
+#include "DlgSystem/DlgVisitedNodes.h"
 
 const FText& UDlgNode_Selector::GetNodeText() const
 {
@@ -16,19 +17,17 @@ const FText& UDlgNode_Selector::GetNodeText() const
 
 		case EDlgNodeSelectorType::Random:
 		{
-			FString SelectRandomString = TEXT("Random Satisfied");
-
+			// NOTE: the node is shared by all the contexts, it must not be modified here
+			static const FText SelectRandomText = FText::FromString("Random Satisfied");
+			static const FText SelectRandomCycleText = FText::FromString("Random Satisfied\nCycle options");
+			static const FText SelectRandomAvoidText = FText::FromString("Random Satisfied\nAvoid repetition");
+			static const FText SelectRandomCycleAvoidText = FText::FromString("Random Satisfied\nCycle options\nAvoid repetition");
 			if (bCycleThroughSatisfiedOptionsWithoutRepetition)
 			{
-				SelectRandomString += TEXT("\nCycle options");
+				return bAvoidPickingSameOptionTwiceInARow ? SelectRandomCycleAvoidText : SelectRandomCycleText;
 			}
 
-			if (bAvoidPickingSameOptionTwiceInARow)
-			{
-				SelectRandomString += TEXT("\nAvoid repetition");
-			}
-			DynamicDisplayText = FText::FromString(SelectRandomString);
-			return DynamicDisplayText;
+			return bAvoidPickingSameOptionTwiceInARow ? SelectRandomAvoidText : SelectRandomText;
 		}
 
 		default:
@@ -38,31 +37,36 @@ const FText& UDlgNode_Selector::GetNodeText() const
 	}
 }
 
-bool UDlgNode_Selector::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgNode_Selector::HandleNodeEnter(UDlgContext& Context, FDlgVisitedNodes& NodesEnteredWithThisStep)
 {
 	FireNodeEnterEvents(Context);
 
 	if (NodesEnteredWithThisStep.Contains(this))
 	{
-		FDlgLogger::Get().Errorf(
-			TEXT("SelectorNode::HandleNodeEnter - Failed to enter selector node, it was entered multiple times in a single step."
-					"Theoretically with some condition magic it could make sense, but chances are that it is an endless loop,"
-					"thus entering the same selector twice with a single step is not supported. Dialogue is terminated.\nContext:\n\t%s"),
-			*Context.GetContextString()
-		);
+		FDlgLogger::Get().ErrorLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("SelectorNode::HandleNodeEnter - Failed to enter selector node, it was entered multiple times in a single step."
+						"Theoretically with some condition magic it could make sense, but chances are that it is an endless loop,"
+						"thus entering the same selector twice with a single step is not supported. Dialogue is terminated.\nContext:\n\t%s"),
+				*Context.GetContextString()
+			);
+		});
 
 		return false;
 	}
-	NodesEnteredWithThisStep.Add(this);
+	const FDlgVisitedNodes::FScope EnteredScope(NodesEnteredWithThisStep, this);
 
 	switch (SelectorType)
 	{
 		case EDlgNodeSelectorType::First:
 		{
 			// Find first child with satisfies conditions
+			FDlgVisitedNodes VisitedNodes(Context.GetDialogue());
+			const FDlgVisitedNodes::FScope VisitedScope(VisitedNodes, this);
 			for (const FDlgEdge& Edge : Children)
 			{
-				if (Edge.Evaluate(Context, { this }))
+				if (Edge.Evaluate(Context, VisitedNodes))
 				{
 					return Context.EnterNode(Edge.TargetIndex, NodesEnteredWithThisStep);
 				}
@@ -84,10 +88,13 @@ bool UDlgNode_Selector::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNod
 			checkNoEntry();
 	}
 
-	FDlgLogger::Get().Errorf(
-		TEXT("HandleNodeEnter - selector node entered, no satisfied child.\nContext:\n\t%s"),
-		*Context.GetContextString()
-	);
+	FDlgLogger::Get().ErrorLazy([&]()
+	{
+		return FString::Printf(
+			TEXT("HandleNodeEnter - selector node entered, no satisfied child.\nContext:\n\t%s"),
+			*Context.GetContextString()
+		);
+	});
 	return false;
 }
 
@@ -101,9 +108,11 @@ int32 UDlgNode_Selector::GetRandomChildNodeIndex(UDlgContext& Context)
 	// List of possible candidates if we want to avoid repetition based on the booleans
 	TArray<int32> CandidatesLimited;
 
+	FDlgVisitedNodes VisitedNodes(Context.GetDialogue());
+	const FDlgVisitedNodes::FScope VisitedScope(VisitedNodes, this);
 	for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); ++EdgeIndex)
 	{
-		if (Children[EdgeIndex].Evaluate(Context, { this }))
+		if (Children[EdgeIndex].Evaluate(Context, VisitedNodes))
 		{
 			Candidates.Add(EdgeIndex);
 
@@ -49,7 +49,7 @@ public:
 	// Begin UDlgNode Interface.
 	//
 
-	bool HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep) override;
+	bool HandleNodeEnter(UDlgContext& Context, FDlgVisitedNodes& NodesEnteredWithThisStep) override;
 
 #if WITH_EDITOR
 	FString GetNodeTypeString() const override { return TEXT("Selector"); }
@@ -91,8 +91,4 @@ protected:
 	// e.g. for options {A, B, C} A-B-C-C-A-B-B... is a valid series of choices
 	UPROPERTY(EditAnywhere, meta = (EditCondition = "SelectorType == EDlgNodeSelectorType::Random", EditConditionHides), Category = "Dialogue|Node")
 	bool bCycleThroughSatisfiedOptionsWithoutRepetition = false;
-
-
-	UPROPERTY(Transient)
-	mutable FText DynamicDisplayText;
 };
@@ -5,6 +5,7 @@
 #include "DlgSystem/DlgConstants.h"
 #include "DlgSystem/Logging/DlgLogger.h"
 #include "DlgSystem/DlgLocalizationHelper.h"
+#include "DlgSystem/DlgVisitedNodes.h"
 
 
 void UDlgNode_Speech::OnCreatedInEditor()
@@ -47,27 +48,38 @@ void UDlgNode_Speech::UpdateTextsNamespacesAndKeys(const UDlgSystemSettings& Set
 	Super::UpdateTextsNamespacesAndKeys(Settings, bEdges, bUpdateGraphNode);
 }
 
-void UDlgNode_Speech::RebuildConstructedText(const UDlgContext& Context)
+void UDlgNode_Speech::RebuildConstructedText(UDlgContext& Context)
 {
 	if (TextArguments.Num() <= 0)
 	{
 		return;
 	}
 
-	FFormatNamedArguments OrderedArguments;
-	for (const FDlgTextArgument& DlgArgument : TextArguments)
+	Context.FindOrAddNodeState(this).ConstructedText = FDlgTextArgument::ConstructFormattedText(Text, TextFormat, TextArguments, Context, OwnerName);
+}
+
+const FText& UDlgNode_Speech::GetNodeTextInContext(const UDlgContext& Context) const
+{
+	if (TextArguments.Num() > 0)
 	{
-		OrderedArguments.Add(DlgArgument.DisplayString, DlgArgument.ConstructFormatArgumentValue(Context, OwnerName));
+		const FDlgNodeContextState* State = Context.FindNodeState(this);
+		if (State && !State->ConstructedText.IsEmpty())
+		{
+			return State->ConstructedText;
+		}
 	}
-	ConstructedText = FText::AsCultureInvariant(FText::Format(Text, OrderedArguments));
+
+	return Text;
 }
 
-bool UDlgNode_Speech::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgNode_Speech::HandleNodeEnter(UDlgContext& Context, FDlgVisitedNodes& NodesEnteredWithThisStep)
 {
 	RebuildConstructedText(Context);
 	const bool bResult = Super::HandleNodeEnter(Context, NodesEnteredWithThisStep);
 
 	// Handle virtual parent enter events for direct children
+	const FDlgNodeContextState* State = Context.FindNodeState(this);
+	const int32 VirtualParentFirstSatisfiedDirectChildIndex = State ? State->VirtualParentFirstSatisfiedDirectChildIndex : INDEX_NONE;
 	if (bResult && bIsVirtualParent && Context.IsValidNodeIndex(VirtualParentFirstSatisfiedDirectChildIndex))
 	{
 		// Add to history
@@ -89,31 +101,38 @@ bool UDlgNode_Speech::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*
 	return bResult;
 }
 
-bool UDlgNode_Speech::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated)
+bool UDlgNode_Speech::ReevaluateChildren(UDlgContext& Context, FDlgVisitedNodes& AlreadyEvaluated)
 {
 	if (bIsVirtualParent)
 	{
-		VirtualParentFirstSatisfiedDirectChildIndex = INDEX_NONE;
-		Context.GetMutableOptionsArray().Empty();
-		Context.GetAllMutableOptionsArray().Empty();
+		Context.FindOrAddNodeState(this).VirtualParentFirstSatisfiedDirectChildIndex = INDEX_NONE;
+		Context.GetMutableOptionsArray().Reset();
+		Context.GetAllMutableOptionsArray().Reset();
 
 		// stop endless loop
 		if (AlreadyEvaluated.Contains(this))
 		{
-			FDlgLogger::Get().Errorf(
-				TEXT("ReevaluateChildren - Endless loop detected, a virtual parent became his own parent! "
-					"This is not supposed to happen, the dialogue is terminated.\nContext:\n\t%s"),
-				*Context.GetContextString()
-			);
+			FDlgLogger::Get().ErrorLazy([&]()
+			{
+				return FString::Printf(
+					TEXT("ReevaluateChildren - Endless loop detected, a virtual parent became his own parent! "
+						"This is not supposed to happen, the dialogue is terminated.\nContext:\n\t%s"),
+					*Context.GetContextString()
+				);
+			});
 			return false;
 		}
 
-		AlreadyEvaluated.Add(this);
+		const FDlgVisitedNodes::FScope EvaluatedScope(AlreadyEvaluated, this);
+
+		// Each edge starts the evaluation from this node
+		FDlgVisitedNodes VisitedNodes(Context.GetDialogue());
+		const FDlgVisitedNodes::FScope VisitedScope(VisitedNodes, this);
 
 		for (const FDlgEdge& Edge : Children)
 		{
 			// Find first satisfied child
-			if (Edge.Evaluate(Context, { this }))
+			if (Edge.Evaluate(Context, VisitedNodes))
 			{
 				if (UDlgNode* Node = Context.GetMutableNodeFromIndex(Edge.TargetIndex))
 				{
@@ -121,7 +140,7 @@ bool UDlgNode_Speech::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNo
 					const bool bResult = Node->ReevaluateChildren(Context, AlreadyEvaluated);
 					if (bResult)
 					{
-						VirtualParentFirstSatisfiedDirectChildIndex = Edge.TargetIndex;
+						Context.FindOrAddNodeState(this).VirtualParentFirstSatisfiedDirectChildIndex = Edge.TargetIndex;
 					}
 					return bResult;
 				}
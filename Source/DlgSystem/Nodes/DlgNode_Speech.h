@@ -46,30 +46,30 @@ public:
 	// Begin UDlgNode Interface.
 	//
 
-	bool HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep) override;
-	bool ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated) override;
+	bool HandleNodeEnter(UDlgContext& Context, FDlgVisitedNodes& NodesEnteredWithThisStep) override;
+	bool ReevaluateChildren(UDlgContext& Context, FDlgVisitedNodes& AlreadyEvaluated) override;
 	void GetAssociatedParticipants(TArray<FName>& OutArray) const override;
 
 	void UpdateTextsValuesFromDefaultsAndRemappings(const UDlgSystemSettings& Settings, bool bEdges, bool bUpdateGraphNode = true) override;
 	void UpdateTextsNamespacesAndKeys(const UDlgSystemSettings& Settings, bool bEdges, bool bUpdateGraphNode = true) override;
-	void RebuildConstructedText(const UDlgContext& Context) override;
+	void RebuildConstructedText(UDlgContext& Context) override;
 	void RebuildTextArguments(bool bEdges, bool bUpdateGraphNode = true) override
 	{
 		Super::RebuildTextArguments(bEdges, bUpdateGraphNode);
 		FDlgTextArgument::UpdateTextArgumentArray(Text, TextArguments);
+		TextFormat = FDlgTextArgument::CompileTextFormat(Text, TextArguments);
 	}
 	void RebuildTextArgumentsFromPreview(const FText& Preview) override { FDlgTextArgument::UpdateTextArgumentArray(Preview, TextArguments); }
+	void RebuildTextFormats() override
+	{
+		Super::RebuildTextFormats();
+		TextFormat = FDlgTextArgument::CompileTextFormat(Text, TextArguments);
+	}
 	const TArray<FDlgTextArgument>& GetTextArguments() const override { return TextArguments; };
 
 	// Getters:
-	const FText& GetNodeText() const override
-	{
-		if (TextArguments.Num() > 0 && !ConstructedText.IsEmpty())
-		{
-			return ConstructedText;
-		}
-		return Text;
-	}
+	const FText& GetNodeText() const override { return Text; }
+	const FText& GetNodeTextInContext(const UDlgContext& Context) const override;
 	const FText& GetNodeUnformattedText() const override { return Text; }
 	UDlgNodeData* GetNodeData() const override { return NodeData; }
 
@@ -143,6 +143,9 @@ protected:
 	UPROPERTY(EditAnywhere, EditFixedSize, Category = "Dialogue|Node")
 	TArray<FDlgTextArgument> TextArguments;
 
+	// Compiled format pattern of the Text, only set if there are text arguments
+	FTextFormat TextFormat;
+
 	// State of the speaker attached to this node. Passed to the GetParticipantIcon function.
 	UPROPERTY(EditAnywhere, Category = "Dialogue|Node")
 	FName SpeakerState;
@@ -167,9 +170,4 @@ protected:
 	// NOTE: You should probably use the NodeData
 	UPROPERTY(EditAnywhere, Category = "Dialogue|Node", Meta = (DlgSaveOnlyReference))
 	UObject* GenericData = nullptr;
-
-	// Constructed at runtime from the original text and the arguments if there is any.
-	FText ConstructedText;
-
-	int32 VirtualParentFirstSatisfiedDirectChildIndex = INDEX_NONE;
 };
@@ -3,6 +3,7 @@
 
 #include "DlgSystem/DlgContext.h"
 #include "DlgSystem/DlgLocalizationHelper.h"
+#include "DlgSystem/DlgVisitedNodes.h"
 
 
 #if WITH_EDITOR
@@ -78,20 +79,21 @@ void UDlgNode_SpeechSequence::UpdateTextsNamespacesAndKeys(const UDlgSystemSetti
 	Super::UpdateTextsNamespacesAndKeys(Settings, bEdges, bUpdateGraphNode);
 }
 
-bool UDlgNode_SpeechSequence::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
+bool UDlgNode_SpeechSequence::HandleNodeEnter(UDlgContext& Context, FDlgVisitedNodes& NodesEnteredWithThisStep)
 {
-	ActualIndex = 0;
+	Context.FindOrAddNodeState(this).SpeechSequenceIndex = 0;
 	return Super::HandleNodeEnter(Context, NodesEnteredWithThisStep);
 }
 
-bool UDlgNode_SpeechSequence::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated)
+bool UDlgNode_SpeechSequence::ReevaluateChildren(UDlgContext& Context, FDlgVisitedNodes& AlreadyEvaluated)
 {
 	TArray<FDlgEdge>& Options = Context.GetMutableOptionsArray();
 	TArray<FDlgEdgeData>& AllOptions = Context.GetAllMutableOptionsArray();
-	Options.Empty();
-	AllOptions.Empty();
+	Options.Reset();
+	AllOptions.Reset();
 
 	// If the last entry is active the real edges are used
+	const int32 ActualIndex = GetSpeechSequenceIndex(Context);
 	if (ActualIndex == SpeechSequence.Num() - 1)
 		return Super::ReevaluateChildren(Context, AlreadyEvaluated);
 
@@ -108,89 +110,116 @@ bool UDlgNode_SpeechSequence::ReevaluateChildren(UDlgContext& Context, TSet<cons
 
 bool UDlgNode_SpeechSequence::OptionSelected(int32 OptionIndex, bool bFromAll, UDlgContext& Context)
 {
+	// NOTE: the reference is only valid until the next node state is added to the Context
+	int32& ActualIndex = Context.FindOrAddNodeState(this).SpeechSequenceIndex;
+	FDlgVisitedNodes AlreadyEvaluated(Context.GetDialogue());
+	const FDlgVisitedNodes::FScope EvaluatedScope(AlreadyEvaluated, this);
+
 	// Actual index is valid, and not the last node in the speech sequence, increment
 	if (ActualIndex >= 0 && ActualIndex < SpeechSequence.Num() - 1)
 	{
 		ActualIndex += 1;
-		return ReevaluateChildren(Context, {this});
+		return ReevaluateChildren(Context, AlreadyEvaluated);
 	}
 
 	// node finished -> generate true children
 	ActualIndex = 0;
-	Super::ReevaluateChildren(Context, { this });
+	Super::ReevaluateChildren(Context, AlreadyEvaluated);
 	return Super::OptionSelected(OptionIndex, bFromAll, Context);
 }
 
 bool UDlgNode_SpeechSequence::OptionSelectedFromReplicated(int32 OptionIndex, bool bFromAll, UDlgContext& Context)
 {
+	// NOTE: the reference is only valid until the next node state is added to the Context
+	int32& ActualIndex = Context.FindOrAddNodeState(this).SpeechSequenceIndex;
+	FDlgVisitedNodes AlreadyEvaluated(Context.GetDialogue());
+	const FDlgVisitedNodes::FScope EvaluatedScope(AlreadyEvaluated, this);
+
 	// Is the new option index valid? set that for the actual index
 	if (SpeechSequence.IsValidIndex(OptionIndex))
 	{
 		ActualIndex = OptionIndex;
-		return ReevaluateChildren(Context, { this });
+		return ReevaluateChildren(Context, AlreadyEvaluated);
 	}
 
 	// node finished -> generate true children
 	ActualIndex = 0;
-	Super::ReevaluateChildren(Context, { this });
+	Super::ReevaluateChildren(Context, AlreadyEvaluated);
 	return Super::OptionSelected(OptionIndex, bFromAll, Context);
 }
 
-const FText& UDlgNode_SpeechSequence::GetNodeText() const
+int32 UDlgNode_SpeechSequence::GetSpeechSequenceIndex(const UDlgContext& Context) const
+{
+	const FDlgNodeContextState* State = Context.FindNodeState(this);
+	return State ? State->SpeechSequenceIndex : INDEX_NONE;
+}
+
+int32 UDlgNode_SpeechSequence::GetSpeechSequenceIndexForContext(const UDlgContext* Context) const
+{
+	return IsValid(Context) ? GetSpeechSequenceIndex(*Context) : INDEX_NONE;
+}
+
+const FDlgSpeechSequenceEntry* UDlgNode_SpeechSequence::GetActiveSpeechSequenceEntry(const UDlgContext& Context) const
+{
+	const int32 ActualIndex = GetSpeechSequenceIndex(Context);
+	return SpeechSequence.IsValidIndex(ActualIndex) ? &SpeechSequence[ActualIndex] : nullptr;
+}
+
+const FText& UDlgNode_SpeechSequence::GetNodeTextInContext(const UDlgContext& Context) const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry(Context))
 	{
-		return SpeechSequence[ActualIndex].Text;
+		return Entry->Text;
 	}
 
 	return FText::GetEmpty();
 }
 
-UDlgNodeData* UDlgNode_SpeechSequence::GetNodeData() const
+UDlgNodeData* UDlgNode_SpeechSequence::GetNodeDataInContext(const UDlgContext& Context) const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry(Context))
 	{
-		return SpeechSequence[ActualIndex].NodeData;
+		return Entry->NodeData;
 	}
 
 	return nullptr;
 }
 
-USoundBase* UDlgNode_SpeechSequence::GetNodeVoiceSoundBase() const
+USoundBase* UDlgNode_SpeechSequence::GetNodeVoiceSoundBaseInContext(const UDlgContext& Context) const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry(Context))
 	{
-		return SpeechSequence[ActualIndex].VoiceSoundWave;
+		return Entry->VoiceSoundWave;
 	}
 
 	return nullptr;
 }
 
-UDialogueWave* UDlgNode_SpeechSequence::GetNodeVoiceDialogueWave() const
+UDialogueWave* UDlgNode_SpeechSequence::GetNodeVoiceDialogueWaveInContext(const UDlgContext& Context) const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry(Context))
 	{
-		return SpeechSequence[ActualIndex].VoiceDialogueWave;
+		return Entry->VoiceDialogueWave;
 	}
 
 	return nullptr;
 }
 
-UObject* UDlgNode_SpeechSequence::GetNodeGenericData() const
+UObject* UDlgNode_SpeechSequence::GetNodeGenericDataInContext(const UDlgContext& Context) const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry(Context))
 	{
-		return SpeechSequence[ActualIndex].GenericData;
+		return Entry->GenericData;
 	}
 
 	return nullptr;
 }
 
-FName UDlgNode_SpeechSequence::GetSpeakerState() const
+FName UDlgNode_SpeechSequence::GetSpeakerStateInContext(const UDlgContext& Context) const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry(Context))
 	{
-		return SpeechSequence[ActualIndex].SpeakerState;
+		return Entry->SpeakerState;
 	}
 
 	return NAME_None;
@@ -204,11 +233,11 @@ void UDlgNode_SpeechSequence::AddAllSpeakerStatesIntoSet(TSet<FName>& OutStates)
 	}
 }
 
-FName UDlgNode_SpeechSequence::GetNodeParticipantName() const
+FName UDlgNode_SpeechSequence::GetNodeParticipantNameInContext(const UDlgContext& Context) const
 {
-	if (SpeechSequence.IsValidIndex(ActualIndex))
+	if (const FDlgSpeechSequenceEntry* Entry = GetActiveSpeechSequenceEntry(Context))
 	{
-		return SpeechSequence[ActualIndex].Speaker;
+		return Entry->Speaker;
 	}
 
 	return OwnerName;
@@ -76,21 +76,25 @@ public:
 	// Begin UDlgNode interface
 	void UpdateTextsValuesFromDefaultsAndRemappings(const UDlgSystemSettings& Settings, bool bEdges, bool bUpdateGraphNode = true) override;
 	void UpdateTextsNamespacesAndKeys(const UDlgSystemSettings& Settings, bool bEdges, bool bUpdateGraphNode = true) override;
-	bool HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep) override;
-	bool ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated) override;
+	bool HandleNodeEnter(UDlgContext& Context, FDlgVisitedNodes& NodesEnteredWithThisStep) override;
+	bool ReevaluateChildren(UDlgContext& Context, FDlgVisitedNodes& AlreadyEvaluated) override;
 	bool OptionSelected(int32 OptionIndex, bool bFromAll, UDlgContext& Context) override;
 
 	// Getters
-	const FText& GetNodeText() const override;
-	UDlgNodeData* GetNodeData() const override;
-	USoundBase* GetNodeVoiceSoundBase() const override;
-	UDialogueWave* GetNodeVoiceDialogueWave() const override;
-	FName GetSpeakerState() const override;
 	void AddAllSpeakerStatesIntoSet(TSet<FName>& OutStates) const override;
-	UObject* GetNodeGenericData() const override;
-	FName GetNodeParticipantName() const override;
 	void GetAssociatedParticipants(TArray<FName>& OutArray) const override;
 
+	// The active entry depends on the Context. The context free getters (GetNodeText, ...) are not overridden,
+	// they return the values of the node itself (e.g. OwnerName), use the context getters (GetNodeTextForContext, ...)
+	// or UDlgContext::GetActiveNode* for the active entry
+	const FText& GetNodeTextInContext(const UDlgContext& Context) const override;
+	UDlgNodeData* GetNodeDataInContext(const UDlgContext& Context) const override;
+	USoundBase* GetNodeVoiceSoundBaseInContext(const UDlgContext& Context) const override;
+	UDialogueWave* GetNodeVoiceDialogueWaveInContext(const UDlgContext& Context) const override;
+	FName GetSpeakerStateInContext(const UDlgContext& Context) const override;
+	UObject* GetNodeGenericDataInContext(const UDlgContext& Context) const override;
+	FName GetNodeParticipantNameInContext(const UDlgContext& Context) const override;
+
 #if WITH_EDITOR
 	FString GetNodeTypeString() const override { return TEXT("Speech Sequence"); }
 
@@ -102,11 +106,20 @@ public:
 	//
 
 	// Useful for multiplayer when you replicate the GetSpeechSequenceIndex
-	// This is different from OptionSelected  because this just sets the ActualIndex = OptionIndex instead of incremeting
-	// the Actual Index
-	// TODO: Proper replicate ActualIndex instead of this hack and all the subnodes
+	// This is different from OptionSelected  because this just sets the active index = OptionIndex instead of incremeting
+	// the active index
+	// TODO: Proper replicate the active index instead of this hack and all the subnodes
 	bool OptionSelectedFromReplicated(int32 OptionIndex, bool bFromAll, UDlgContext& Context);
-	int32 GetSpeechSequenceIndex() const { return ActualIndex; }
+
+	// Gets the current active index in the SpeechSequence array for the Context, INDEX_NONE if this node was not entered
+	int32 GetSpeechSequenceIndex(const UDlgContext& Context) const;
+
+	// Blueprint version of GetSpeechSequenceIndex, INDEX_NONE if the Context is not valid
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
+	int32 GetSpeechSequenceIndexForContext(const UDlgContext* Context) const;
+
+	// Gets the active entry of the SpeechSequence array for the Context, nullptr if there is none
+	const FDlgSpeechSequenceEntry* GetActiveSpeechSequenceEntry(const UDlgContext& Context) const;
 
 	// Fills the inner edges from the corresponding  input data (SpeechSequence)
 	void AutoGenerateInnerEdges();
@@ -133,7 +146,4 @@ protected:
 	// Inner edge, filled automatically based on SpeechSequence
 	UPROPERTY()
 	TArray<FDlgEdge> InnerEdges;
-
-	// The current active index in the SpeechSequence array
-	int32 ActualIndex = INDEX_NONE;
 };
@@ -4,6 +4,7 @@
 #include "DlgIOTesterTypes.h"
 #include "Containers/UnrealString.h"
 #include "Misc/AutomationTest.h"
+#include "Serialization/MemoryWriter.h"
 
 #include "DlgSystem/IO/DlgConfigWriter.h"
 #include "DlgSystem/IO/DlgConfigParser.h"
@@ -15,6 +16,20 @@ DEFINE_LOG_CATEGORY(LogDlgIOTester);
 
 #if WITH_DEV_AUTOMATION_TESTS
 
+// Same as FDlgJsonParser but reads the FJsonObject of the whole string first, the results must be the same
+class FDlgJsonDOMParser : public FDlgJsonParser
+{
+public:
+	FDlgJsonDOMParser() { SetUseStreamingReader(false); }
+};
+
+// Same as FDlgJsonWriter but builds the FJsonObject of the whole struct first, the output must be the same
+class FDlgJsonDOMWriter : public FDlgJsonWriter
+{
+public:
+	FDlgJsonDOMWriter() { SetUseStreamingWriter(false); }
+};
+
 class FDlgIOTester
 {
 public:
@@ -30,6 +45,10 @@ public:
 	// Test all parsers/writers
 	static bool TestAllParsers(FAutomationTestBase& Test);
 
+	// Tests that the streaming FDlgJsonWriter (string and archive) outputs the same as the DOM one
+	template <typename StructType>
+	static bool TestJsonWriterOutput(FAutomationTestBase& Test, const FString& StructDescription, const FDlgIOTesterOptions& Options);
+
 	template <typename ConfigWriterType, typename ConfigParserType, typename StructType>
 	static bool TestStruct(
 		FAutomationTestBase& Test,
@@ -122,6 +141,39 @@ bool FDlgIOTester::TestStruct(
 	return false;
 }
 
+template <typename StructType>
+bool FDlgIOTester::TestJsonWriterOutput(FAutomationTestBase& Test, const FString& StructDescription, const FDlgIOTesterOptions& Options)
+{
+	StructType ExportedStruct;
+	ExportedStruct.GenerateRandomData(Options);
+
+	FDlgJsonDOMWriter DOMWriter;
+	DOMWriter.Write(StructType::StaticStruct(), &ExportedStruct);
+
+	FDlgJsonWriter StreamingWriter;
+	StreamingWriter.Write(StructType::StaticStruct(), &ExportedStruct);
+
+	TArray<uint8> ArchiveBytes;
+	FMemoryWriter MemoryWriter(ArchiveBytes);
+	FDlgJsonWriter ArchiveWriter;
+	ArchiveWriter.WriteToArchive(StructType::StaticStruct(), &ExportedStruct, MemoryWriter);
+
+	// Same bytes as ExportToFile writes
+	const FTCHARToUTF8 ExpectedBytes(*DOMWriter.GetAsString(), DOMWriter.GetAsString().Len());
+	const bool bSameString = DOMWriter.GetAsString().Equals(StreamingWriter.GetAsString(), ESearchCase::CaseSensitive);
+	const bool bSameBytes = ArchiveBytes.Num() == ExpectedBytes.Length() &&
+							FMemory::Memcmp(ArchiveBytes.GetData(), ExpectedBytes.Get(), ArchiveBytes.Num()) == 0;
+	if (bSameString && bSameBytes)
+	{
+		return true;
+	}
+
+	UE_LOG(LogDlgIOTester, Warning, TEXT("TestJsonWriterOutput: Test Failed = %s, bSameString = %d, bSameBytes = %d"), *StructDescription, bSameString, bSameBytes);
+	UE_LOG(LogDlgIOTester, Warning, TEXT("DOM = |%s|\n"), *DOMWriter.GetAsString());
+	UE_LOG(LogDlgIOTester, Warning, TEXT("Streaming = |%s|\n"), *StreamingWriter.GetAsString());
+	return false;
+}
+
 bool FDlgIOTester::TestAllParsers(FAutomationTestBase& Test)
 {
 	bool bAllSucceeded = true;
@@ -130,6 +182,12 @@ bool FDlgIOTester::TestAllParsers(FAutomationTestBase& Test)
 	Options.bSupportsDatePrimitive = false;
 	Options.bSupportsUObjectValueInMap = false;
 	bAllSucceeded &= TestParser<FDlgJsonWriter, FDlgJsonParser>(Test, Options, TEXT("FDlgJsonWriter"), TEXT("FDlgJsonParser"));
+	bAllSucceeded &= TestParser<FDlgJsonWriter, FDlgJsonDOMParser>(Test, Options, TEXT("FDlgJsonWriter"), TEXT("FDlgJsonDOMParser"));
+	bAllSucceeded &= TestParser<FDlgJsonDOMWriter, FDlgJsonParser>(Test, Options, TEXT("FDlgJsonDOMWriter"), TEXT("FDlgJsonParser"));
+	bAllSucceeded &= TestJsonWriterOutput<FDlgTestStructComplex>(Test, "Struct of Complex types", Options);
+	bAllSucceeded &= TestJsonWriterOutput<FDlgTestArrayComplex>(Test, "Array of Complex types", Options);
+	bAllSucceeded &= TestJsonWriterOutput<FDlgTestSetComplex>(Test, "Set of Complex types", Options);
+	bAllSucceeded &= TestJsonWriterOutput<FDlgTestMapComplex>(Test, "Map with Complex types", Options);
 
 	Options = {};
 	Options.bSupportsPureEnumContainer = false;
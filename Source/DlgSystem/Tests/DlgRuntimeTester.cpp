@@ -0,0 +1,1042 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "DlgRuntimeTesterTypes.h"
+#include "AssetRegistry/AssetData.h"
+#include "HAL/PlatformProcess.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgContextPool.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgDialogueAssetData.h"
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgMemory.h"
+#include "DlgSystem/DlgNameIndex.h"
+#include "DlgSystem/DlgParticipantRegistry.h"
+#include "DlgSystem/DlgHelper.h"
+#include "DlgSystem/DlgVisitedNodes.h"
+#include "DlgSystem/NYReflectionHelper.h"
+#include "DlgSystem/Logging/DlgAsyncLogSink.h"
+#include "DlgSystem/Nodes/DlgNode_Start.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+#include "DlgSystem/Nodes/DlgNode_SpeechSequence.h"
+#include "DlgSystem/Nodes/DlgNode_Selector.h"
+#include "DlgSystem/Nodes/DlgNode_Proxy.h"
+#include "DlgSystem/Nodes/DlgNode_End.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+class FDlgRuntimeTester
+{
+public:
+	// Creates a Dialogue: Start -> Speech -> Selector -> ... -> Selector -> Proxy -> End
+	static UDlgDialogue* CreateSelectorChainDialogue(FName ParticipantName, int32 SelectorsNum);
+};
+
+UDlgDialogue* FDlgRuntimeTester::CreateSelectorChainDialogue(FName ParticipantName, int32 SelectorsNum)
+{
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage());
+	TArray<UDlgNode*> Nodes;
+
+	UDlgNode_Speech* Speech = NewObject<UDlgNode_Speech>(Dialogue);
+	Nodes.Add(Speech);
+	for (int32 Index = 0; Index < SelectorsNum; Index++)
+	{
+		Nodes.Add(NewObject<UDlgNode_Selector>(Dialogue));
+	}
+	UDlgNode_Proxy* Proxy = NewObject<UDlgNode_Proxy>(Dialogue);
+	Nodes.Add(Proxy);
+	Nodes.Add(NewObject<UDlgNode_End>(Dialogue));
+
+	// Link every node with the next one, the proxy points to the end node
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		UDlgNode* Node = Nodes[NodeIndex];
+		Node->RegenerateGUID();
+		Node->SetNodeParticipantName(ParticipantName);
+		if (Node != Proxy && NodeIndex + 1 < Nodes.Num())
+		{
+			Node->AddNodeChild(FDlgEdge(NodeIndex + 1));
+		}
+	}
+	Proxy->SetTargetNodeIndex(Nodes.Num() - 1);
+
+	UDlgNode_Start* Start = NewObject<UDlgNode_Start>(Dialogue);
+	Start->SetNodeParticipantName(ParticipantName);
+	Start->AddNodeChild(FDlgEdge(0));
+
+	Dialogue->SetNodes(Nodes);
+	Dialogue->SetStartNodes({ Start });
+	Dialogue->UpdateAndRefreshData();
+	return Dialogue;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeEvaluationAutomationTest,
+	"DlgSystem.Runtime.Evaluation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeEvaluationAutomationTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 SelectorsNum = 128;
+	static constexpr int32 ReevaluationsNum = 1000;
+
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage());
+	Participant->ParticipantName = TEXT("Tester");
+
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateSelectorChainDialogue(Participant->ParticipantName, SelectorsNum);
+	TMap<FName, UObject*> Participants;
+	Participants.Add(Participant->ParticipantName, Participant);
+
+	UDlgContext* Context = NewObject<UDlgContext>(GetTransientPackage());
+	if (!TestTrue(TEXT("Context started"), Context->Start(Dialogue, Participants)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Options through the selector chain"), Context->GetOptionsNum(), 1);
+
+	// The runtime graph must give the same results as the node objects
+	const FDlgRuntimeGraph& RuntimeGraph = Dialogue->GetRuntimeGraph();
+	TestTrue(TEXT("Runtime graph is valid"), RuntimeGraph.IsValid());
+	TestEqual(TEXT("Runtime graph nodes"), RuntimeGraph.GetNodesNum(), Dialogue->GetNodes().Num());
+	for (int32 NodeIndex = 0; NodeIndex < Dialogue->GetNodes().Num(); NodeIndex++)
+	{
+		FDlgVisitedNodes VisitedNodes(Dialogue);
+		TestEqual(
+			FString::Printf(TEXT("Node %d enterable"), NodeIndex),
+			Context->IsNodeEnterable(NodeIndex),
+			Dialogue->GetNodes()[NodeIndex]->CheckNodeEnterConditions(*Context, VisitedNodes)
+		);
+	}
+
+	// Warm up the options arrays, after this they must keep their capacity
+	Context->ReevaluateOptions();
+	const int32 OptionsMax = Context->GetOptionsArray().Max();
+	const int32 AllOptionsMax = Context->GetAllOptionsArray().Max();
+	for (int32 Index = 0; Index < ReevaluationsNum; Index++)
+	{
+		Context->ReevaluateOptions();
+	}
+	TestEqual(TEXT("Options capacity after the reevaluations"), Context->GetOptionsArray().Max(), OptionsMax);
+	TestEqual(TEXT("All options capacity after the reevaluations"), Context->GetAllOptionsArray().Max(), AllOptionsMax);
+	TestEqual(TEXT("Options after the reevaluations"), Context->GetOptionsNum(), 1);
+
+	// Every node of the chain fits into the inline storage of the visited nodes and is removed when its scope ends
+	{
+		FDlgVisitedNodes VisitedNodes(Dialogue);
+		TestTrue(TEXT("Selector chain fits into the inline visited nodes"), Dialogue->GetNodes().Num() <= FDlgVisitedNodes::InlineNodesNum);
+		{
+			const FDlgVisitedNodes::FScope FirstScope(VisitedNodes, 0);
+			const FDlgVisitedNodes::FScope LastScope(VisitedNodes, Dialogue->GetNodes().Last());
+			TestTrue(TEXT("Visited node by index"), VisitedNodes.ContainsIndex(0));
+			TestTrue(TEXT("Visited node by pointer"), VisitedNodes.Contains(Dialogue->GetNodes().Last()));
+			TestFalse(TEXT("Not visited node"), VisitedNodes.ContainsIndex(1));
+			TestFalse(TEXT("Node added twice"), VisitedNodes.AddIndex(0));
+			TestEqual(TEXT("Visited nodes num"), VisitedNodes.Num(), 2);
+		}
+		TestTrue(TEXT("Visited nodes are removed with their scope"), VisitedNodes.IsEmpty());
+	}
+	AddInfo(FString::Printf(TEXT("Node evaluation cache: %s"), *Context->GetNodeEvaluationCache().GetStats().ToString()));
+
+	// The same node evaluated twice in one step must come from the cache
+	{
+		Context->GetNodeEvaluationCache().ResetStats();
+		const FDlgNodeEvaluationCache::FScope EvaluationScope(Context->GetNodeEvaluationCache());
+		FDlgVisitedNodes VisitedNodes(Dialogue);
+		const bool bFirst = Context->IsNodeEnterable(1, VisitedNodes);
+		TestEqual(TEXT("Cached enterable result"), Context->IsNodeEnterable(1, VisitedNodes), bFirst);
+		TestTrue(TEXT("Node evaluation cache hit"), Context->GetNodeEvaluationCache().GetStats().EnterableHits > 0);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeContextStateAutomationTest,
+	"DlgSystem.Runtime.ContextState",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeContextStateAutomationTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 EntriesNum = 3;
+	const FName ParticipantName = TEXT("ContextStateTester");
+
+	// Start -> SpeechSequence -> Selector -> Speech -> End, the last edge has a formatted text
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage());
+	UDlgNode_SpeechSequence* SpeechSequence = NewObject<UDlgNode_SpeechSequence>(Dialogue);
+	for (int32 Index = 0; Index < EntriesNum; Index++)
+	{
+		FDlgSpeechSequenceEntry Entry;
+		Entry.Speaker = ParticipantName;
+		Entry.Text = FText::FromString(FString::Printf(TEXT("Text %d"), Index));
+		Entry.EdgeText = FText::FromString(FString::Printf(TEXT("Edge %d"), Index));
+		SpeechSequence->GetMutableNodeSpeechSequence()->Add(Entry);
+	}
+	SpeechSequence->AutoGenerateInnerEdges();
+
+	UDlgNode_Speech* Speech = NewObject<UDlgNode_Speech>(Dialogue);
+	FDlgEdge FormattedEdge(3);
+	FormattedEdge.SetText(FText::FromString(TEXT("{Name} goes on")));
+	Speech->AddNodeChild(FormattedEdge);
+
+	const TArray<UDlgNode*> Nodes = { SpeechSequence, NewObject<UDlgNode_Selector>(Dialogue), Speech, NewObject<UDlgNode_End>(Dialogue) };
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		Nodes[NodeIndex]->RegenerateGUID();
+		Nodes[NodeIndex]->SetNodeParticipantName(ParticipantName);
+		if (NodeIndex < 2)
+		{
+			Nodes[NodeIndex]->AddNodeChild(FDlgEdge(NodeIndex + 1));
+		}
+	}
+	UDlgNode_Start* Start = NewObject<UDlgNode_Start>(Dialogue);
+	Start->SetNodeParticipantName(ParticipantName);
+	Start->AddNodeChild(FDlgEdge(0));
+	Dialogue->SetNodes(Nodes);
+	Dialogue->SetStartNodes({ Start });
+	Dialogue->UpdateAndRefreshData();
+
+	// Two contexts through the same Dialogue, with different participants
+	UDlgContext* Contexts[2];
+	const TCHAR* DisplayNames[2] = { TEXT("Alice"), TEXT("Bob") };
+	for (int32 Index = 0; Index < 2; Index++)
+	{
+		UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage());
+		Participant->ParticipantName = ParticipantName;
+		Participant->DisplayName = FText::FromString(DisplayNames[Index]);
+		TMap<FName, UObject*> Participants;
+		Participants.Add(ParticipantName, Participant);
+
+		Contexts[Index] = NewObject<UDlgContext>(GetTransientPackage());
+		if (!TestTrue(TEXT("Context started"), Contexts[Index]->Start(Dialogue, Participants)))
+		{
+			return false;
+		}
+	}
+	UDlgContext& First = *Contexts[0];
+	UDlgContext& Second = *Contexts[1];
+
+	// Only the first one advances, each keeps its own cursor
+	TestTrue(TEXT("First advanced"), First.ChooseOption(0));
+	TestEqual(TEXT("First cursor"), SpeechSequence->GetSpeechSequenceIndex(First), 1);
+	TestEqual(TEXT("Second cursor"), SpeechSequence->GetSpeechSequenceIndex(Second), 0);
+	TestEqual(TEXT("First text"), First.GetActiveNodeText().ToString(), FString(TEXT("Text 1")));
+	TestEqual(TEXT("Second text"), Second.GetActiveNodeText().ToString(), FString(TEXT("Text 0")));
+	TestEqual(TEXT("First edge text"), First.GetOptionText(0).ToString(), FString(TEXT("Edge 1")));
+	TestEqual(TEXT("Second edge text"), Second.GetOptionText(0).ToString(), FString(TEXT("Edge 0")));
+
+	// Both go through the whole sequence and the selector
+	for (UDlgContext* Context : Contexts)
+	{
+		while (Context->GetActiveNode() == SpeechSequence)
+		{
+			if (!TestTrue(TEXT("Advanced through the sequence"), Context->ChooseOption(0)))
+			{
+				return false;
+			}
+		}
+		TestTrue(TEXT("Speech after the selector"), Context->GetActiveNode() == Speech);
+	}
+	TestEqual(TEXT("First formatted edge"), First.GetOptionText(0).ToString(), FString(TEXT("Alice goes on")));
+	TestEqual(TEXT("Second formatted edge"), Second.GetOptionText(0).ToString(), FString(TEXT("Bob goes on")));
+	TestTrue(TEXT("The Dialogue edge is not modified"), Speech->GetNodeChildren()[0].GetText().ToString() == TEXT("{Name} goes on"));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeConditionsAutomationTest,
+	"DlgSystem.Runtime.Conditions",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeConditionsAutomationTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 ConditionsNodeIndex = 2;
+
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage());
+	Participant->ParticipantName = TEXT("Tester");
+	const FName LevelName = GET_MEMBER_NAME_CHECKED(UDlgTestParticipant, Level);
+
+	// Expensive conditions first, the compiled version should reorder them
+	TArray<FDlgCondition> Conditions;
+	{
+		FDlgCondition& Condition = Conditions.AddDefaulted_GetRef();
+		Condition.ConditionType = EDlgConditionType::EventCall;
+		Condition.CallbackName = TEXT("AlwaysTrue");
+	}
+	{
+		FDlgCondition& Condition = Conditions.AddDefaulted_GetRef();
+		Condition.Strength = EDlgConditionStrength::Weak;
+		Condition.ConditionType = EDlgConditionType::IntCall;
+		Condition.CallbackName = LevelName;
+		Condition.IntValue = 3;
+	}
+	{
+		FDlgCondition& Condition = Conditions.AddDefaulted_GetRef();
+		Condition.ConditionType = EDlgConditionType::ClassIntVariable;
+		Condition.CallbackName = LevelName;
+		Condition.Operation = EDlgOperation::GreaterOrEqual;
+		Condition.IntValue = 2;
+	}
+	{
+		FDlgCondition& Condition = Conditions.AddDefaulted_GetRef();
+		Condition.Strength = EDlgConditionStrength::Weak;
+		Condition.ConditionType = EDlgConditionType::ClassIntVariable;
+		Condition.CallbackName = LevelName;
+		Condition.IntValue = 100;
+	}
+	{
+		FDlgCondition& Condition = Conditions.AddDefaulted_GetRef();
+		Condition.ConditionType = EDlgConditionType::WasNodeVisited;
+		Condition.IntValue = 0;
+	}
+
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateSelectorChainDialogue(Participant->ParticipantName, 2);
+	UDlgNode* ConditionsNode = Dialogue->GetMutableNodeFromIndex(ConditionsNodeIndex);
+	ConditionsNode->SetNodeEnterConditions(Conditions);
+	Dialogue->UpdateAndRefreshData();
+
+	TMap<FName, UObject*> Participants;
+	Participants.Add(Participant->ParticipantName, Participant);
+	UDlgContext* Context = NewObject<UDlgContext>(GetTransientPackage());
+	Participant->Level = 3;
+	if (!TestTrue(TEXT("Context started"), Context->Start(Dialogue, Participants)))
+	{
+		return false;
+	}
+
+	const FDlgRuntimeGraph& RuntimeGraph = Dialogue->GetRuntimeGraph();
+	if (!TestTrue(TEXT("Runtime graph is valid"), RuntimeGraph.IsValid()))
+	{
+		return false;
+	}
+	const FDlgRuntimeConditions& RuntimeConditions = RuntimeGraph.GetNode(ConditionsNodeIndex).EnterConditions;
+	TestEqual(TEXT("Compiled strong conditions"), RuntimeConditions.StrongNum, 3);
+	TestEqual(TEXT("Compiled weak conditions"), RuntimeConditions.WeakNum, 2);
+
+	// Same results as the conditions array
+	for (const int32 Level : { 1, 2, 3, 100 })
+	{
+		Participant->Level = Level;
+		TestEqual(
+			FString::Printf(TEXT("Conditions with Level = %d"), Level),
+			RuntimeGraph.EvaluateConditions(*Context, RuntimeConditions),
+			FDlgCondition::EvaluateArray(*Context, Conditions, Participant->ParticipantName)
+		);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeHistoryAutomationTest,
+	"DlgSystem.Runtime.History",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeHistoryAutomationTest::RunTest(const FString& Parameters)
+{
+	const FGuid DialogueGUID = FGuid::NewGuid();
+	TArray<FGuid> NodeGUIDs;
+	for (int32 NodeIndex = 0; NodeIndex < 100; NodeIndex++)
+	{
+		NodeGUIDs.Add(FGuid::NewGuid());
+	}
+
+	FDlgHistoryStore Store;
+	FDlgHistory& History = Store.FindOrAddEntry(DialogueGUID);
+	for (int32 NodeIndex = 0; NodeIndex < NodeGUIDs.Num(); NodeIndex += 3)
+	{
+		History.Add(NodeIndex, NodeGUIDs[NodeIndex]);
+	}
+	History.GetNodeData(NodeGUIDs[0]).GUIDList.Add(NodeGUIDs[1]);
+
+	for (int32 NodeIndex = 0; NodeIndex < NodeGUIDs.Num(); NodeIndex++)
+	{
+		const bool bVisited = NodeIndex % 3 == 0;
+		TestEqual(TEXT("Contains"), History.Contains(NodeIndex, NodeGUIDs[NodeIndex]), bVisited);
+		TestEqual(TEXT("ContainsNodeIndex"), History.ContainsNodeIndex(NodeIndex), bVisited);
+		TestEqual(TEXT("ContainsNodeGUID"), History.ContainsNodeGUID(NodeGUIDs[NodeIndex]), bVisited);
+	}
+
+	// Only indices (Scenario B), the GUIDs are not used even if they are valid
+	FDlgHistory IndicesHistory;
+	IndicesHistory.SetVisitedNodeIndices({ 1, 64 });
+	TestFalse(TEXT("CanUseGUIDForSearch"), IndicesHistory.CanUseGUIDForSearch());
+	TestTrue(TEXT("Contains index 64"), IndicesHistory.Contains(64, NodeGUIDs[64]));
+	TestFalse(TEXT("Contains index 2"), IndicesHistory.Contains(2, NodeGUIDs[2]));
+	TestEqual(TEXT("GetVisitedNodeIndices"), IndicesHistory.GetVisitedNodeIndices().Num(), 2);
+
+	// Compact format round trip
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Store.SerializeCompact(Writer);
+
+	FDlgHistoryStore LoadedStore;
+	FMemoryReader Reader(Bytes);
+	LoadedStore.SerializeCompact(Reader);
+	TestFalse(TEXT("Reader error"), Reader.IsError());
+
+	const FDlgHistory* LoadedHistory = LoadedStore.GetEntry(DialogueGUID);
+	if (!TestNotNull(TEXT("Loaded history"), LoadedHistory))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Loaded history is equal"), *LoadedHistory == History);
+	TestEqual(TEXT("Loaded node data"), LoadedHistory->NodeData.FindRef(NodeGUIDs[0]).GUIDList.Num(), 1);
+
+	// Invalid data does not modify the store
+	TArray<uint8> InvalidBytes = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	FMemoryReader InvalidReader(InvalidBytes);
+	LoadedStore.SerializeCompact(InvalidReader);
+	TestTrue(TEXT("Invalid reader error"), InvalidReader.IsError());
+	TestNotNull(TEXT("Store untouched"), LoadedStore.GetEntry(DialogueGUID));
+
+	// Corrupted node data num
+	TArray<uint8> CorruptedBytes;
+	FMemoryWriter CorruptedWriter(CorruptedBytes);
+	TArray<uint32> EmptyBits;
+	TArray<FGuid> EmptyGUIDs;
+	int32 CorruptedNumNodeData = MAX_int32;
+	CorruptedWriter << EmptyBits << EmptyGUIDs << CorruptedNumNodeData;
+
+	FDlgHistory CorruptedHistory;
+	FMemoryReader CorruptedReader(CorruptedBytes);
+	CorruptedHistory.SerializeCompact(CorruptedReader);
+	TestTrue(TEXT("Corrupted reader error"), CorruptedReader.IsError());
+	TestEqual(TEXT("Corrupted node data"), CorruptedHistory.NodeData.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeHistoryOwnersAutomationTest,
+	"DlgSystem.Runtime.HistoryOwners",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeHistoryOwnersAutomationTest::RunTest(const FString& Parameters)
+{
+	FDlgMemory& Memory = FDlgMemory::Get();
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage());
+	Participant->ParticipantName = TEXT("HistoryOwnersTester");
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateSelectorChainDialogue(Participant->ParticipantName, 1);
+	TMap<FName, UObject*> Participants;
+	Participants.Add(Participant->ParticipantName, Participant);
+	const FGuid DialogueGUID = Dialogue->GetGUID();
+	const FGuid SelectorGUID = Dialogue->GetNodes()[1]->GetGUID();
+
+	// Two owners, only the first one advances to the selector
+	UObject* FirstOwner = NewObject<UDlgTestParticipant>(GetTransientPackage());
+	UObject* SecondOwner = NewObject<UDlgTestParticipant>(GetTransientPackage());
+	UDlgContext* FirstContext = NewObject<UDlgContext>(GetTransientPackage());
+	UDlgContext* SecondContext = NewObject<UDlgContext>(GetTransientPackage());
+	FirstContext->SetHistoryOwner(FirstOwner);
+	SecondContext->SetHistoryOwner(SecondOwner);
+	if (!TestTrue(TEXT("Contexts started"), FirstContext->Start(Dialogue, Participants) && SecondContext->Start(Dialogue, Participants)))
+	{
+		return false;
+	}
+	FirstContext->ChooseOption(0);
+
+	const TSharedPtr<FDlgHistoryStore> FirstStore = Memory.FindStore(FirstOwner);
+	const TSharedPtr<FDlgHistoryStore> SecondStore = Memory.FindStore(SecondOwner);
+	if (!TestTrue(TEXT("Stores exist"), FirstStore.IsValid() && SecondStore.IsValid()))
+	{
+		return false;
+	}
+	TestTrue(TEXT("First history has the selector"), FirstStore->IsNodeIndexVisited(DialogueGUID, 1));
+	TestFalse(TEXT("Second history does not have the selector"), SecondStore->IsNodeIndexVisited(DialogueGUID, 1));
+	TestTrue(TEXT("Both histories have the speech"), FirstStore->IsNodeIndexVisited(DialogueGUID, 0) && SecondStore->IsNodeIndexVisited(DialogueGUID, 0));
+
+	// Adding more stores does not prune or move the existing ones
+	UObject* ThirdOwner = NewObject<UDlgTestParticipant>(GetTransientPackage());
+	Memory.FindOrAddStore(ThirdOwner);
+	TestTrue(TEXT("First store is kept"), Memory.FindStore(FirstOwner) == FirstStore);
+	TestTrue(TEXT("Second store is kept"), Memory.FindStore(SecondOwner) == SecondStore);
+
+	// A context bound before pruning still reads its own store
+	Memory.RemoveStore(FirstOwner);
+	Memory.RemoveStoresWithInvalidOwners();
+	TestFalse(TEXT("First store is pruned"), Memory.FindStore(FirstOwner).IsValid());
+	TestTrue(TEXT("Bound context reads its own store"), FirstContext->IsNodeVisited(1, SelectorGUID, false));
+	TestFalse(TEXT("Other context does not read it"), SecondContext->IsNodeVisited(1, SelectorGUID, false));
+
+	Memory.RemoveStore(SecondOwner);
+	Memory.RemoveStore(ThirdOwner);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeNameIndexAutomationTest,
+	"DlgSystem.Runtime.NameIndex",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeNameIndexAutomationTest::RunTest(const FString& Parameters)
+{
+	const FName ParticipantName = TEXT("NameIndexTester");
+	FDlgNameIndex& NameIndex = FDlgNameIndex::Get();
+
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateSelectorChainDialogue(ParticipantName, 1);
+	TestTrue(TEXT("Dialogue is indexed"), NameIndex.ContainsDialogue(Dialogue));
+	TestTrue(TEXT("Participant is indexed"), NameIndex.GetParticipantNames().Contains(ParticipantName));
+
+	const TArray<FName>& Names = NameIndex.GetParticipantNames();
+	for (int32 Index = 1; Index < Names.Num(); Index++)
+	{
+		TestFalse(TEXT("Names are sorted"), FDlgHelper::PredicateSortFNameAlphabeticallyAscending(Names[Index], Names[Index - 1]));
+	}
+
+	// Another Dialogue with the same participant keeps the name alive
+	UDlgDialogue* OtherDialogue = FDlgRuntimeTester::CreateSelectorChainDialogue(ParticipantName, 1);
+	TArray<UDlgDialogue*> ParticipantDialogues;
+	NameIndex.GetDialoguesForParticipantName(ParticipantName, ParticipantDialogues);
+	TestEqual(TEXT("Participant Dialogues"), ParticipantDialogues.Num(), 2);
+	TestTrue(TEXT("Participant Dialogues contain the Dialogue"), ParticipantDialogues.Contains(Dialogue));
+
+	NameIndex.RemoveDialogue(Dialogue);
+	TestTrue(TEXT("Participant is still indexed"), NameIndex.GetParticipantNames().Contains(ParticipantName));
+	TestEqual(TEXT("Removed Dialogue is not returned"), NameIndex.GetNumDialoguesForParticipantName(ParticipantName), 1);
+
+	NameIndex.RemoveDialogue(OtherDialogue);
+	TestFalse(TEXT("Participant is removed"), NameIndex.GetParticipantNames().Contains(ParticipantName));
+	TestEqual(TEXT("No Dialogues for the removed participant"), NameIndex.GetNumDialoguesForParticipantName(ParticipantName), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeParticipantRegistryAutomationTest,
+	"DlgSystem.Runtime.ParticipantRegistry",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeParticipantRegistryAutomationTest::RunTest(const FString& Parameters)
+{
+	const FName ParticipantName = TEXT("RegistryTester");
+	const FName InnerParticipantName = TEXT("RegistryInnerTester");
+	const FName RenamedParticipantName = TEXT("RegistryRenamedTester");
+	const FName OtherParticipantName = TEXT("RegistryOtherTester");
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	UDlgParticipantRegistry* Registry = World->GetSubsystem<UDlgParticipantRegistry>();
+	if (!TestNotNull(TEXT("Registry"), Registry))
+	{
+		World->DestroyWorld(false);
+		return false;
+	}
+
+	// Scan the empty World
+	TArray<UObject*> Participants;
+	Registry->GetParticipants(ParticipantName, Participants);
+	TestEqual(TEXT("Empty World"), Participants.Num(), 0);
+
+	// Register, the name and the inner participant are set after spawning, like ExposeOnSpawn or BeginPlay would
+	ADlgTestParticipantActor* Actor = World->SpawnActor<ADlgTestParticipantActor>();
+	if (!TestNotNull(TEXT("Actor"), Actor))
+	{
+		World->DestroyWorld(false);
+		return false;
+	}
+	Actor->ParticipantName = ParticipantName;
+	Actor->InnerParticipant = NewObject<UDlgTestParticipant>(Actor);
+	Actor->InnerParticipant->ParticipantName = InnerParticipantName;
+
+	Registry->GetParticipants(ParticipantName, Participants);
+	TestTrue(TEXT("Spawned actor is registered with its final name"), Participants.Num() == 1 && Participants[0] == Actor);
+	Participants.Empty();
+	Registry->GetParticipants(InnerParticipantName, Participants);
+	TestTrue(TEXT("Participant added after spawning is registered"), Participants.Num() == 1 && Participants[0] == Actor->InnerParticipant);
+
+	// Rename
+	Actor->ParticipantName = RenamedParticipantName;
+	Participants.Empty();
+	Registry->GetParticipants(ParticipantName, Participants);
+	TestEqual(TEXT("Renamed actor is not found by the old name"), Participants.Num(), 0);
+	Registry->GetParticipants(RenamedParticipantName, Participants);
+	TestTrue(TEXT("Renamed actor is found by the new name"), Participants.Num() == 1 && Participants[0] == Actor);
+
+	// Destroy
+	Actor->Destroy();
+	Participants.Empty();
+	Registry->GetParticipants(RenamedParticipantName, Participants);
+	Registry->GetParticipants(InnerParticipantName, Participants);
+	TestEqual(TEXT("Destroyed actor is removed"), Participants.Num(), 0);
+
+	// Level removal, also drops the actors that were not registered yet
+	ADlgTestParticipantActor* OtherActor = World->SpawnActor<ADlgTestParticipantActor>();
+	ADlgTestParticipantActor* PendingActor = World->SpawnActor<ADlgTestParticipantActor>();
+	if (OtherActor && PendingActor)
+	{
+		OtherActor->ParticipantName = OtherParticipantName;
+		PendingActor->ParticipantName = OtherParticipantName;
+		Registry->RegisterActor(OtherActor);
+		TestEqual(TEXT("Other actor is registered"), Registry->GetNumParticipants(), 1);
+
+		FWorldDelegates::LevelRemovedFromWorld.Broadcast(World->PersistentLevel, World);
+		TestEqual(TEXT("Level participants are removed"), Registry->GetNumParticipants(), 0);
+		Registry->GetParticipants(OtherParticipantName, Participants);
+		TestEqual(TEXT("Level actors are not registered later"), Participants.Num(), 0);
+	}
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeContextPoolAutomationTest,
+	"DlgSystem.Runtime.ContextPool",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeContextPoolAutomationTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	UDlgContextPool* Pool = World->GetSubsystem<UDlgContextPool>();
+	if (!TestNotNull(TEXT("Pool"), Pool))
+	{
+		World->DestroyWorld(false);
+		return false;
+	}
+
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(World);
+	Participant->ParticipantName = TEXT("PoolTester");
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateSelectorChainDialogue(Participant->ParticipantName, 2);
+	TMap<FName, UObject*> Participants;
+	Participants.Add(Participant->ParticipantName, Participant);
+
+	// Acquire
+	UDlgContext* Context = Pool->Acquire();
+	TestTrue(TEXT("Pool owns the acquired context"), Pool->Owns(Context));
+	TestTrue(TEXT("Context started"), Context->Start(Dialogue, Participants));
+	TestTrue(TEXT("Context is active"), Context->IsDialogueActive());
+
+	// Release of an active context is refused
+	AddExpectedError(TEXT("still in the middle of a Dialogue"), EAutomationExpectedErrorFlags::Contains, 0);
+	Pool->Release(Context);
+	TestEqual(TEXT("Active context is not pooled"), Pool->GetNumFreeContexts(), 0);
+	TestTrue(TEXT("Active context is not reset"), Context->GetDialogue() == Dialogue);
+
+	// Reset + Release
+	Context->ResetContext();
+	TestFalse(TEXT("Reset context is not active"), Context->IsDialogueActive());
+	TestNull(TEXT("Reset context has no Dialogue"), Context->GetDialogue());
+	TestEqual(TEXT("Reset context has no participants"), Context->GetParticipantsMap().Num(), 0);
+	Pool->Release(Context);
+	TestEqual(TEXT("Released context is pooled"), Pool->GetNumFreeContexts(), 1);
+	TestTrue(TEXT("Pooled context is reused"), Pool->Acquire() == Context);
+	TestEqual(TEXT("Pool is empty again"), Pool->GetNumFreeContexts(), 0);
+
+	// The scratch context has only one user at a time
+	{
+		const UDlgContextPool::FScratchScope ScratchScope(Pool);
+		TestNotNull(TEXT("Scratch context"), ScratchScope.Context);
+		const UDlgContextPool::FScratchScope NestedScratchScope(Pool);
+		TestNull(TEXT("Scratch context in use"), NestedScratchScope.Context);
+	}
+
+	// CanBeStarted uses the scratch context of the World and does not create contexts
+	const UDlgContext* ScratchContext = Pool->GetScratchContext();
+	for (int32 Index = 0; Index < 10; Index++)
+	{
+		TestTrue(TEXT("CanBeStarted"), UDlgContext::CanBeStarted(Dialogue, Participants));
+	}
+	TestTrue(TEXT("Same scratch context"), ScratchContext != nullptr && Pool->GetScratchContext() == ScratchContext);
+	TArray<UObject*> ParticipantObjects;
+	GetObjectsWithOuter(Participant, ParticipantObjects, false);
+	TestFalse(
+		TEXT("No context created by CanBeStarted"),
+		ParticipantObjects.ContainsByPredicate([](const UObject* Object) { return Object->IsA<UDlgContext>(); })
+	);
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeCanStartDialoguesAutomationTest,
+	"DlgSystem.Runtime.CanStartDialogues",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeCanStartDialoguesAutomationTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 CandidatesNum = 16;
+	const FName ParticipantName = TEXT("CanStartTester");
+
+	// The first node can only be entered with Level >= 2
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateSelectorChainDialogue(ParticipantName, 2);
+	{
+		FDlgCondition Condition;
+		Condition.ParticipantName = ParticipantName;
+		Condition.ConditionType = EDlgConditionType::ClassIntVariable;
+		Condition.CallbackName = GET_MEMBER_NAME_CHECKED(UDlgTestParticipant, Level);
+		Condition.Operation = EDlgOperation::GreaterOrEqual;
+		Condition.IntValue = 2;
+		Dialogue->GetMutableNodeFromIndex(0)->SetNodeEnterConditions({ Condition });
+		Dialogue->UpdateAndRefreshData();
+	}
+
+	TArray<FDlgStartCandidate> Candidates;
+	TArray<bool> Expected;
+	for (int32 Index = 0; Index < CandidatesNum; Index++)
+	{
+		UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage());
+		Participant->ParticipantName = ParticipantName;
+		Participant->Level = Index % 4;
+
+		FDlgStartCandidate& Candidate = Candidates.AddDefaulted_GetRef();
+		Candidate.Dialogue = Dialogue;
+		Candidate.Participants.Add(Participant);
+		Expected.Add(UDlgManager::CanStartDialogue(Candidate.Dialogue, Candidate.Participants));
+	}
+	TestTrue(TEXT("Some candidates can start"), Expected.Contains(true));
+	TestTrue(TEXT("Some candidates can not start"), Expected.Contains(false));
+
+	auto TestResults = [this, &Expected](const FString& What, const TBitArray<>& CanStart)
+	{
+		if (!TestEqual(What + TEXT(" num"), CanStart.Num(), Expected.Num()))
+		{
+			return;
+		}
+		for (int32 Index = 0; Index < Expected.Num(); Index++)
+		{
+			TestEqual(FString::Printf(TEXT("%s candidate %d"), *What, Index), static_cast<bool>(CanStart[Index]), Expected[Index]);
+		}
+	};
+
+	// All at once
+	TBitArray<> CanStart;
+	TestEqual(TEXT("All evaluated"), UDlgManager::CanStartDialogues(Candidates, CanStart), CandidatesNum);
+	TestResults(TEXT("All at once"), CanStart);
+
+	// Resumed from StartIndex, the results before it are kept
+	TBitArray<> ResumedCanStart(false, CandidatesNum);
+	for (int32 Index = 0; Index < CandidatesNum / 2; Index++)
+	{
+		ResumedCanStart[Index] = Expected[Index];
+	}
+	TestEqual(TEXT("Resumed evaluated"), UDlgManager::CanStartDialogues(Candidates, ResumedCanStart, CandidatesNum / 2), CandidatesNum);
+	TestResults(TEXT("Resumed"), ResumedCanStart);
+
+	// Time budget that runs out immediately, at least one candidate is evaluated per call
+	TBitArray<> BudgetCanStart;
+	int32 NextIndex = 0;
+	int32 CallsNum = 0;
+	while (NextIndex < CandidatesNum && CallsNum <= CandidatesNum)
+	{
+		const int32 NewNextIndex = UDlgManager::CanStartDialogues(Candidates, BudgetCanStart, NextIndex, 1e-9);
+		TestTrue(TEXT("Budget call makes progress"), NewNextIndex > NextIndex);
+		NextIndex = NewNextIndex;
+		CallsNum++;
+	}
+	TestEqual(TEXT("Budget evaluated all"), NextIndex, CandidatesNum);
+	TestResults(TEXT("Budget"), BudgetCanStart);
+
+	// Blueprint version
+	TArray<bool> CanStartArray;
+	TestEqual(TEXT("Blueprint evaluated"), UDlgManager::CanStartDialoguesArray(Candidates, CanStartArray), CandidatesNum);
+	TestTrue(TEXT("Blueprint results"), CanStartArray == Expected);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeCallFunctionAutomationTest,
+	"DlgSystem.Runtime.CallFunction",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeCallFunctionAutomationTest::RunTest(const FString& Parameters)
+{
+	UDlgTestParticipant* Participant = NewObject<UDlgTestParticipant>(GetTransientPackage());
+
+	// Return values are the only parameters, the buffer must fit them
+	for (const FName FunctionName : { GET_FUNCTION_NAME_CHECKED(UDlgTestParticipant, IncrementCallsNum), GET_FUNCTION_NAME_CHECKED(UDlgTestParticipant, GetCallsNumString) })
+	{
+		const FNYFunctionBinding Binding = FNYReflectionHelper::FindFunctionCached(UDlgTestParticipant::StaticClass(), FunctionName);
+		if (!TestTrue(FString::Printf(TEXT("%s found"), *FunctionName.ToString()), Binding.IsValid()))
+		{
+			return false;
+		}
+		TestTrue(FString::Printf(TEXT("%s has a return value"), *FunctionName.ToString()), Binding.ParmsSize > 0);
+		TestEqual(FString::Printf(TEXT("%s input params"), *FunctionName.ToString()), Binding.InputParamsNum, 0);
+
+		const int32 OldCallsNum = Participant->CallsNum;
+		FNYReflectionHelper::CallFunction(Participant, Binding);
+		FNYReflectionHelper::CallFunction(Participant, Binding);
+		TestEqual(FString::Printf(TEXT("%s calls"), *FunctionName.ToString()), Participant->CallsNum, OldCallsNum + 2);
+	}
+
+	TestFalse(TEXT("Missing function"), FNYReflectionHelper::FindFunctionCached(UDlgTestParticipant::StaticClass(), TEXT("DoesNotExist")).IsValid());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeChildClassesAutomationTest,
+	"DlgSystem.Runtime.ChildClasses",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeChildClassesAutomationTest::RunTest(const FString& Parameters)
+{
+	TestTrue(
+		TEXT("Child class"),
+		FNYReflectionHelper::FindChildClassCached(UObject::StaticClass(), TEXT("DlgTestParticipant")) == UDlgTestParticipant::StaticClass()
+	);
+
+	// Existing class that is not a child, the second lookup uses the cached miss
+	for (int32 Index = 0; Index < 2; Index++)
+	{
+		TestNull(TEXT("Not a child class"), FNYReflectionHelper::FindChildClassCached(UDlgTestParticipant::StaticClass(), TEXT("DlgContext")));
+	}
+	TestTrue(
+		TEXT("Child class after a miss"),
+		FNYReflectionHelper::FindChildClassCached(UDlgTestParticipant::StaticClass(), TEXT("DlgTestParticipant")) == UDlgTestParticipant::StaticClass()
+	);
+	TestNull(TEXT("Unknown class name"), FNYReflectionHelper::FindChildClassCached(UObject::StaticClass(), TEXT("DlgClassThatDoesNotExist_1234")));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeAsyncLogSinkAutomationTest,
+	"DlgSystem.Runtime.AsyncLogSink",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeAsyncLogSinkAutomationTest::RunTest(const FString& Parameters)
+{
+	TArray<FString> Dispatched;
+	auto Dispatch = [&Dispatched](ENYLoggerLogLevel Level, const FString& Message)
+	{
+		Dispatched.Add(Message);
+	};
+
+	// Duplicates of one Flush are collapsed
+	{
+		FDlgAsyncLogSink Sink;
+		for (int32 Index = 0; Index < 3; Index++)
+		{
+			Sink.Enqueue(ENYLoggerLogLevel::Warning, TEXT("Collapsed"));
+		}
+		Sink.Flush(Dispatch);
+		TestEqual(TEXT("Collapsed dispatched"), Dispatched.Num(), 1);
+		TestTrue(TEXT("Collapsed repeats"), Dispatched.Num() == 1 && Dispatched[0].Contains(TEXT("[Repeated 3 times]")));
+		TestEqual(TEXT("Collapsed stats"), Sink.GetStats().Collapsed, 2ll);
+		TestTrue(TEXT("Collapsed sink is empty"), Sink.IsEmpty());
+	}
+
+	// Full queue
+	{
+		FDlgAsyncLogSinkOptions Options;
+		Options.MaxQueuedMessages = 2;
+		FDlgAsyncLogSink Sink;
+		Sink.SetOptions(Options);
+		TestTrue(TEXT("First message queued"), Sink.Enqueue(ENYLoggerLogLevel::Warning, TEXT("First")));
+		TestTrue(TEXT("Second message queued"), Sink.Enqueue(ENYLoggerLogLevel::Warning, TEXT("Second")));
+		TestFalse(TEXT("Third message dropped"), Sink.Enqueue(ENYLoggerLogLevel::Warning, TEXT("Third")));
+		TestEqual(TEXT("Dropped stats"), Sink.GetStats().Dropped, 1ll);
+	}
+
+	// The suppressed messages are reported when their window ends even if the same message is not logged again
+	{
+		FDlgAsyncLogSinkOptions Options;
+		Options.MaxSameMessagesPerSecond = 2;
+		Options.bCollapseDuplicates = false;
+		FDlgAsyncLogSink Sink;
+		Sink.SetOptions(Options);
+
+		Dispatched.Empty();
+		for (int32 Index = 0; Index < 5; Index++)
+		{
+			Sink.Enqueue(ENYLoggerLogLevel::Warning, TEXT("RateLimited"));
+		}
+		Sink.Flush(Dispatch);
+		TestEqual(TEXT("Rate limited dispatched"), Dispatched.Num(), 2);
+		TestEqual(TEXT("Rate limited stats"), Sink.GetStats().RateLimited, 3ll);
+
+		// Nothing new is queued, only the end of the window
+		FPlatformProcess::Sleep(1.1f);
+		Sink.Flush(Dispatch);
+		TestEqual(TEXT("Suppressed summary dispatched"), Dispatched.Num(), 3);
+		TestTrue(TEXT("Suppressed summary"), Dispatched.Num() == 3 && Dispatched[2].Contains(TEXT("[3 identical messages suppressed]")));
+
+		// Reported only once
+		Sink.Flush(Dispatch);
+		TestEqual(TEXT("Suppressed summary dispatched once"), Dispatched.Num(), 3);
+
+		// The flush of everything (shutdown) reports them without waiting for the window
+		for (int32 Index = 0; Index < 3; Index++)
+		{
+			Sink.Enqueue(ENYLoggerLogLevel::Warning, TEXT("RateLimited"));
+		}
+		Sink.Flush(Dispatch, true);
+		TestEqual(TEXT("Flush all dispatched"), Dispatched.Num(), 6);
+		TestTrue(TEXT("Flush all summary"), Dispatched.Num() == 6 && Dispatched[5].Contains(TEXT("[1 identical messages suppressed]")));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeAssetDataAutomationTest,
+	"DlgSystem.Runtime.AssetData",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeAssetDataAutomationTest::RunTest(const FString& Parameters)
+{
+	const FName ParticipantName = TEXT("Asset, Data \"Tester\"");
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateSelectorChainDialogue(ParticipantName, 2);
+	const FDlgDialogueAssetData DialogueData = FDlgDialogueAssetData::FromDialogue(*Dialogue);
+
+	// Round trip through the AssetRegistry tags
+	TArray<TPair<FName, FString>> TagValues;
+	DialogueData.GetTagValues(TagValues);
+	FAssetDataTagMap Tags;
+	for (const TPair<FName, FString>& Pair : TagValues)
+	{
+		Tags.Add(Pair.Key, Pair.Value);
+	}
+#if NY_ENGINE_VERSION >= 501
+	const FAssetData AssetData(TEXT("/Game/DlgTest"), TEXT("/Game"), TEXT("DlgTest"), UDlgDialogue::StaticClass()->GetClassPathName(), Tags);
+#else
+	const FAssetData AssetData(TEXT("/Game/DlgTest"), TEXT("/Game"), TEXT("DlgTest"), UDlgDialogue::StaticClass()->GetFName(), Tags);
+#endif
+
+	FDlgDialogueAssetData LoadedData;
+	if (!TestTrue(TEXT("Has metadata"), FDlgDialogueAssetData::FromAssetData(AssetData, LoadedData)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("GUID"), LoadedData.GUID, DialogueData.GUID);
+	TestEqual(TEXT("Nodes num"), LoadedData.NodesNum, Dialogue->GetNodes().Num());
+	TestEqual(TEXT("Participant names"), LoadedData.ParticipantNames, DialogueData.ParticipantNames);
+	TestTrue(TEXT("Has participant with special characters"), LoadedData.HasParticipant(ParticipantName));
+	TestEqual(TEXT("Participants data"), LoadedData.ParticipantsNames.Num(), DialogueData.ParticipantsNames.Num());
+
+	FGuid GUID;
+	TestTrue(TEXT("GUID tag"), FDlgDialogueAssetData::GetGUID(AssetData, GUID) && GUID == DialogueData.GUID);
+
+	// Dialogues without a GUID do not have the GUID tag
+	FDlgDialogueAssetData NoGUIDData = DialogueData;
+	NoGUIDData.GUID.Invalidate();
+	TArray<TPair<FName, FString>> NoGUIDTagValues;
+	NoGUIDData.GetTagValues(NoGUIDTagValues);
+	TestFalse(
+		TEXT("No GUID tag"),
+		NoGUIDTagValues.ContainsByPredicate([](const TPair<FName, FString>& Pair) { return Pair.Key == FDlgDialogueAssetData::TagGUID; })
+	);
+
+	// Assets saved before the tags existed
+	const FAssetData OldAssetData;
+	TestFalse(TEXT("Old asset has no metadata"), FDlgDialogueAssetData::HasMetadata(OldAssetData));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeAssetIndexAutomationTest,
+	"DlgSystem.Runtime.AssetIndex",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgRuntimeAssetIndexAutomationTest::RunTest(const FString& Parameters)
+{
+	const FName ParticipantName = TEXT("AssetIndexTester");
+	UDlgDialogue* Dialogue = FDlgRuntimeTester::CreateSelectorChainDialogue(ParticipantName, 1);
+	const FDlgDialogueAssetData DialogueData = FDlgDialogueAssetData::FromDialogue(*Dialogue);
+
+	TArray<TPair<FName, FString>> TagValues;
+	DialogueData.GetTagValues(TagValues);
+	FAssetDataTagMap Tags;
+	for (const TPair<FName, FString>& Pair : TagValues)
+	{
+		Tags.Add(Pair.Key, Pair.Value);
+	}
+	auto MakeAssetData = [](FName PackageName, FName AssetName, const FAssetDataTagMap& AssetTags)
+	{
+#if NY_ENGINE_VERSION >= 501
+		return FAssetData(PackageName, TEXT("/Game"), AssetName, UDlgDialogue::StaticClass()->GetClassPathName(), AssetTags);
+#else
+		return FAssetData(PackageName, TEXT("/Game"), AssetName, UDlgDialogue::StaticClass()->GetFName(), AssetTags);
+#endif
+	};
+	const FAssetData AssetData = MakeAssetData(TEXT("/Game/DlgIndexTest"), TEXT("DlgIndexTest"), Tags);
+	const FAssetData OldAssetData = MakeAssetData(TEXT("/Game/DlgIndexTestOld"), TEXT("DlgIndexTestOld"), FAssetDataTagMap());
+
+	// Do not touch the global index
+	FDlgNameIndex AssetIndex;
+	AssetIndex.RebuildAssets({ AssetData, OldAssetData });
+	TestTrue(TEXT("Assets built"), AssetIndex.AreAssetsBuilt());
+	TestEqual(TEXT("Assets with metadata"), AssetIndex.GetNumAssets(), 1);
+	TestEqual(TEXT("Assets without metadata"), AssetIndex.GetNumAssetsWithoutMetadata(), 1);
+
+	TArray<TSoftObjectPtr<UDlgDialogue>> Dialogues;
+	AssetIndex.GetDialogueAssetsForParticipantName(ParticipantName, Dialogues);
+	TestTrue(TEXT("Found by participant"), Dialogues.Num() == 1 && Dialogues[0].ToSoftObjectPath() == AssetData.ToSoftObjectPath());
+
+	FSoftObjectPath ObjectPath;
+	TestTrue(TEXT("Found by GUID"), AssetIndex.FindDialogueAssetByGUID(DialogueData.GUID, ObjectPath) && ObjectPath == AssetData.ToSoftObjectPath());
+
+	// Updated tags replace the old ones
+	FDlgDialogueAssetData RenamedParticipantData = DialogueData;
+	RenamedParticipantData.ParticipantNames = { TEXT("AssetIndexOtherTester") };
+	TArray<TPair<FName, FString>> UpdatedTagValues;
+	RenamedParticipantData.GetTagValues(UpdatedTagValues);
+	FAssetDataTagMap UpdatedTags;
+	for (const TPair<FName, FString>& Pair : UpdatedTagValues)
+	{
+		UpdatedTags.Add(Pair.Key, Pair.Value);
+	}
+	AssetIndex.UpdateAsset(MakeAssetData(TEXT("/Game/DlgIndexTest"), TEXT("DlgIndexTest"), UpdatedTags));
+	Dialogues.Empty();
+	AssetIndex.GetDialogueAssetsForParticipantName(ParticipantName, Dialogues);
+	TestEqual(TEXT("Old participant is removed"), Dialogues.Num(), 0);
+	AssetIndex.GetDialogueAssetsForParticipantName(TEXT("AssetIndexOtherTester"), Dialogues);
+	TestEqual(TEXT("New participant is added"), Dialogues.Num(), 1);
+
+	// Rename, see FDlgSystemModule::HandleOnAssetRenamed
+	const FAssetData RenamedAssetData = MakeAssetData(TEXT("/Game/DlgIndexTestRenamed"), TEXT("DlgIndexTestRenamed"), Tags);
+	AssetIndex.RemoveAsset(AssetData.ToSoftObjectPath());
+	AssetIndex.UpdateAsset(RenamedAssetData);
+	TestFalse(TEXT("Old path is removed"), AssetIndex.ContainsAsset(AssetData.ToSoftObjectPath()));
+	TestTrue(TEXT("Found by GUID after rename"), AssetIndex.FindDialogueAssetByGUID(DialogueData.GUID, ObjectPath) && ObjectPath == RenamedAssetData.ToSoftObjectPath());
+
+	// Remove
+	AssetIndex.RemoveAsset(RenamedAssetData.ToSoftObjectPath());
+	AssetIndex.RemoveAsset(OldAssetData.ToSoftObjectPath());
+	TestEqual(TEXT("All assets removed"), AssetIndex.GetNumAssets() + AssetIndex.GetNumAssetsWithoutMetadata(), 0);
+	TestFalse(TEXT("Not found by GUID after remove"), AssetIndex.FindDialogueAssetByGUID(DialogueData.GUID, ObjectPath));
+	Dialogues.Empty();
+	AssetIndex.GetDialogueAssetsForParticipantName(ParticipantName, Dialogues);
+	TestEqual(TEXT("Not found by participant after remove"), Dialogues.Num(), 0);
+
+	// Loaded Dialogues without the tags are merged in
+	AssetIndex.UpdateDialogue(*Dialogue);
+	AssetIndex.GetDialogueAssetsForParticipantName(ParticipantName, Dialogues);
+	TestTrue(TEXT("Loaded Dialogue without tags is found"), Dialogues.Num() == 1 && Dialogues[0].Get() == Dialogue);
+
+	// Once it has the tags it is not added twice
+	AssetIndex.UpdateAsset(MakeAssetData(Dialogue->GetOutermost()->GetFName(), Dialogue->GetFName(), Tags));
+	TestTrue(TEXT("Loaded Dialogue is tagged"), AssetIndex.ContainsAsset(FSoftObjectPath(Dialogue)));
+	Dialogues.Empty();
+	AssetIndex.GetDialogueAssetsForParticipantName(ParticipantName, Dialogues);
+	TestTrue(TEXT("Loaded Dialogue with tags is found once"), Dialogues.Num() == 1 && Dialogues[0].Get() == Dialogue);
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,62 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "GameFramework/Actor.h"
+
+#include "DlgSystem/DlgDialogueParticipant.h"
+
+#include "DlgRuntimeTesterTypes.generated.h"
+
+
+// Minimal participant used by the runtime tests
+UCLASS()
+class UDlgTestParticipant : public UObject, public IDlgDialogueParticipant
+{
+	GENERATED_BODY()
+
+public:
+	FName GetParticipantName_Implementation() const override { return ParticipantName; }
+	FText GetParticipantDisplayName_Implementation(FName ActiveSpeaker) const override { return DisplayName; }
+	bool CheckCondition_Implementation(const UDlgContext* Context, FName ConditionName) const override { return true; }
+	int32 GetIntValue_Implementation(FName ValueName) const override { return ValueName == GET_MEMBER_NAME_CHECKED(UDlgTestParticipant, Level) ? Level : 0; }
+
+	// Called by name through FNYReflectionHelper::CallFunction
+	UFUNCTION()
+	int32 IncrementCallsNum() { return ++CallsNum; }
+
+	UFUNCTION()
+	FString GetCallsNumString() { CallsNum++; return FString::Printf(TEXT("CallsNum = %d"), CallsNum); }
+
+public:
+	UPROPERTY()
+	FName ParticipantName;
+
+	UPROPERTY()
+	FText DisplayName;
+
+	UPROPERTY()
+	int32 Level = 0;
+
+	UPROPERTY()
+	int32 CallsNum = 0;
+};
+
+// Minimal actor participant used by the participant registry tests
+UCLASS()
+class ADlgTestParticipantActor : public AActor, public IDlgDialogueParticipant
+{
+	GENERATED_BODY()
+
+public:
+	FName GetParticipantName_Implementation() const override { return ParticipantName; }
+
+public:
+	UPROPERTY()
+	FName ParticipantName;
+
+	// Participant inside the actor, like a component
+	UPROPERTY()
+	UDlgTestParticipant* InnerParticipant = nullptr;
+};
@@ -153,10 +153,8 @@ int32 UDlgHumanReadableTextCommandlet::Export()
 		{
 			continue;
 		}
-		JsonWriter.Write(FDlgDialogue_FormatHumanReadable::StaticStruct(), &ExportFormat);
-
 		const FString FileSystemFilePath = FileSystemDirectoryPath / FileName + FileExtension;
-		if (JsonWriter.ExportToFile(FileSystemFilePath))
+		if (JsonWriter.WriteToFile(FDlgDialogue_FormatHumanReadable::StaticStruct(), &ExportFormat, FileSystemFilePath))
 		{
 			UE_LOG(LogDlgHumanReadableTextCommandlet, Display, TEXT("Writing file = `%s` for Dialogue = `%s` "), *FileSystemFilePath, *OriginalDialoguePath);
 		}